@@ -0,0 +1,34 @@
+#version 450 core
+
+in vec4 vColor;
+in vec2 vLocal;
+flat in vec2 vHalf;
+flat in float vThickness;
+flat in uint vKind;
+
+layout (location = 0) out vec4 fFragColor;
+
+void main(void)
+{
+if(vKind == 0u) {
+	fFragColor = vColor;
+	return;
+}
+
+// distance to the edge, negative inside
+float d;
+if(vKind == 1u) {
+	vec2 q = abs(vLocal) - vHalf;
+	d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0);
+}
+else {
+	d = length(vLocal) - vHalf.x;
+}
+
+// outlines keep a band around the edge, filled shapes everything inside it
+float outside = vThickness > 0.0 ? abs(d) - vThickness * 0.5 : d;
+float alpha = clamp(0.5 - outside / max(fwidth(d), 0.0001), 0.0, 1.0);
+if(alpha <= 0.0)
+	discard;
+fFragColor = vec4(vColor.rgb, vColor.a * alpha);
+}
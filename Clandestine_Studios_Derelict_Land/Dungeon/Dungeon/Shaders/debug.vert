@@ -0,0 +1,54 @@
+#version 450 core
+
+// One instance per debug shape, expanded to a quad around it
+layout (location=0) in vec2 aA;				// line start, or center
+layout (location=1) in vec2 aB;				// line end, or half size
+layout (location=2) in float aThickness;	// outline width, 0 fills rectangles and circles
+layout (location=3) in float aAngle;		// rectangle rotation in radians
+layout (location=4) in vec4 aColor;
+layout (location=5) in uint aKind;			// 0 line, 1 rectangle, 2 circle
+
+out vec4 vColor;
+out vec2 vLocal;			// position from the center, along the shape's axes
+flat out vec2 vHalf;
+flat out float vThickness;
+flat out uint vKind;
+
+layout (std140, binding = 0) uniform Camera
+{
+mat4 uViewProj;
+mat4 uTransform;
+};
+void main(void)
+{
+// triangle strip corners (-1,-1) (1,-1) (-1,1) (1,1)
+vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+
+vec2 center = aA;
+vec2 halfSize = aB;
+vec2 axis = vec2(cos(aAngle), sin(aAngle));
+vec2 extent;
+if(aKind == 0u) {
+	// lines are a quad along the segment, the width on either side of it
+	vec2 d = aB - aA;
+	float len = length(d);
+	axis = len > 0.0 ? d / len : vec2(1.0, 0.0);
+	center = (aA + aB) * 0.5;
+	halfSize = vec2(len * 0.5, 0.0);
+	extent = halfSize + max(aThickness, 1.0) * 0.5;
+}
+else {
+	// the outline is centered on the edge, one more pixel is left to smooth it
+	extent = halfSize + aThickness * 0.5 + 1.0;
+}
+
+vec2 local = corner * extent;
+vec2 world = center + axis * local.x + vec2(-axis.y, axis.x) * local.y;
+
+vColor = aColor;
+vLocal = local;
+vHalf = halfSize;
+vThickness = aThickness;
+vKind = aKind;
+gl_Position = uViewProj * uTransform * vec4(world, 0.0, 1.0);
+}
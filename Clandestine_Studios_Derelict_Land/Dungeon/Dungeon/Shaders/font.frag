@@ -1,15 +0,0 @@
-#version 450 core
-
-in vec2 TexCoords;
-out vec4 color;
-
-uniform sampler2D text;
-//uniform vec3 textColor;
-uniform vec4 textRGBA;
-
-void main()
-{
-vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-//color = vec4(textColor,1.0) * sampled;
-color = vec4(textRGBA) * sampled;
-}
\ No newline at end of file
@@ -5,8 +5,11 @@ layout (location=1) in vec4 aVertexColor;
 
 out vec4 vColor;
 
-uniform mat4 uTransform;
-uniform mat4 uViewProj;
+layout (std140, binding = 0) uniform Camera
+{
+mat4 uViewProj;
+mat4 uTransform;
+};
 void main(void)
 {
 vColor = aVertexColor;
@@ -3,33 +3,65 @@
 in vec4 vColor;
 in vec2 vTextureCoord;
 in float vTextureIndex;
-in mat4 vTransform;
-in mat4 vViewProj;
+in vec2 vWorldPos;
 in float vDepth;
 
 uniform sampler2D uTex2d[32];
-uniform vec3 light_pos[32];
-uniform vec3 light_color[32];
-uniform float light_intensity[32];
-uniform int light_size;
+layout (std140, binding = 2) uniform Lights
+{
+vec2 light_origin;		// world position of tile (0,0)
+float light_tile_size;
+int light_tiles_x;
+int light_tiles_y;
+int light_size;
+};
+// two vec4 per light: xyz position w radius, rgb color a intensity
+layout (std430, binding = 3) readonly buffer LightData
+{
+vec4 light_data[];
+};
+// first/count pair per tile, then the light indices the pairs point into
+layout (std430, binding = 4) readonly buffer LightGrid
+{
+uint light_grid[];
+};
 
 layout (location = 0) out vec4 fFragColor;
 
 void main(void)        
 {   
-
+// slots past 31 are text, sampling a distance field with the edge in the fraction
+if(vTextureIndex >= 32.0) {
+	int slot = int(vTextureIndex) - 32;
+	float edge = fract(vTextureIndex);
+	float dist = texture(uTex2d[slot],vTextureCoord).a;
+	float smoothing = fwidth(dist);
+	float alpha = smoothstep(edge - smoothing, edge + smoothing, dist) * vColor.a;
+	if(alpha < 0.01)
+		discard;
+	fFragColor = vec4(vColor.rgb, alpha);
+	return;
+}
 
 vec3 ambient = vec3(0.7); // Ambient light color
 vec3 diffuse = vec3(0.0);// Diffuse light color
-vec3 position = vec3(vTextureCoord, 0.0); // Pixel position
-
 
-for(int i = 0; i < light_size; i++) {
-	if(vDepth > light_pos[i].z)
-		break;
-	vec3 lightDir = normalize(vec3(vViewProj * (vTransform/2.0) * vec4(light_pos[i].xy, light_pos[i].z, 1.0)) - position);
-	float diff = max(dot(lightDir, normalize(vec3(0.0, 0.0, -1.0))), 0.0);
-	diffuse += diff * (light_intensity[i]*0.1) * light_color[i];
+// only the lights the CPU found touching this fragment's screen tile
+ivec2 tile = ivec2(floor((vWorldPos - light_origin) / light_tile_size));
+if(light_size > 0 && tile.x >= 0 && tile.y >= 0 && tile.x < light_tiles_x && tile.y < light_tiles_y) {
+	uint t = uint(tile.y * light_tiles_x + tile.x) * 2u;
+	uint first = light_grid[t];
+	uint count = light_grid[t + 1u];
+	for(uint i = first; i < first + count; i++) {
+		uint l = light_grid[i] * 2u;
+		vec4 light_pos = light_data[l];
+		vec4 light_color = light_data[l + 1u];
+		if(vDepth > light_pos.z)
+			continue;
+		float d = length(vWorldPos - light_pos.xy) / light_pos.w;
+		float falloff = clamp(1.0 - d * d, 0.0, 1.0);
+		diffuse += falloff * falloff * (light_color.a*0.1) * light_color.rgb;
+	}
 }
                                           
 int index = int(vTextureIndex);
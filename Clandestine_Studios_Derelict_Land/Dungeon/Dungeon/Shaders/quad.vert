@@ -8,19 +8,20 @@ layout (location=3) in float aTextureIndex;
 out vec4 vColor;
 out vec2 vTextureCoord;	
 out float vTextureIndex;
-out mat4 vTransform;
-out mat4 vViewProj;
+out vec2 vWorldPos;
 out float vDepth;
 
-uniform mat4 uTransform;
-uniform mat4 uViewProj;	
+layout (std140, binding = 0) uniform Camera
+{
+mat4 uViewProj;
+mat4 uTransform;
+};
 void main(void) 
 {   
 vTextureCoord = aVertexTextureCoords;
 vColor = aVertexColor;	
 vTextureIndex = aTextureIndex;
-vTransform = uTransform;
-vViewProj = uViewProj;
+vWorldPos = aVertexPosition.xy;
 vDepth = aVertexPosition.z;
 gl_Position = uViewProj * uTransform * vec4(aVertexPosition, 1.0);
 }
\ No newline at end of file
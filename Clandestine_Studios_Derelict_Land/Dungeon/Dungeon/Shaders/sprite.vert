@@ -0,0 +1,54 @@
+#version 450 core
+
+// One instance per sprite, expanded to a quad here instead of on the CPU
+layout (location=0) in vec3 aPosition;
+layout (location=1) in float aRotation;
+layout (location=2) in vec2 aSize;
+layout (location=3) in vec4 aUVRect;
+layout (location=4) in vec4 aColor;
+layout (location=5) in float aTextureIndex;
+// flipbook start time, frame duration, frames, frames per row. Fewer than 2 frames is a still sprite,
+// a negative frame count plays once and holds the last frame
+layout (location=6) in vec4 aAnim;
+
+out vec4 vColor;
+out vec2 vTextureCoord;
+out float vTextureIndex;
+out vec2 vWorldPos;
+out float vDepth;
+
+layout (std140, binding = 0) uniform Camera
+{
+mat4 uViewProj;
+mat4 uTransform;
+};
+layout (std140, binding = 1) uniform Frame
+{
+float uTime;
+float uDeltaTime;
+};
+void main(void)
+{
+// triangle strip corners (0,0) (1,0) (0,1) (1,1)
+vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+vec2 local = (corner - 0.5) * aSize;
+float c = cos(aRotation);
+float s = sin(aRotation);
+vec2 world = aPosition.xy + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+// frames are laid out row by row, each one frame size from the last
+vec2 frameOffset = vec2(0.0);
+float frames = abs(aAnim.z);
+if(frames > 1.0) {
+	float frame = floor((uTime - aAnim.x) / aAnim.y);
+	frame = aAnim.z < 0.0 ? clamp(frame, 0.0, frames - 1.0) : mod(frame, frames);
+	frameOffset = vec2(mod(frame, aAnim.w), floor(frame / aAnim.w)) * (aUVRect.zw - aUVRect.xy);
+}
+
+vTextureCoord = mix(aUVRect.xy, aUVRect.zw, corner) + frameOffset;
+vColor = aColor;
+vTextureIndex = aTextureIndex;
+vWorldPos = world;
+vDepth = aPosition.z;
+gl_Position = uViewProj * uTransform * vec4(world, aPosition.z, 1.0);
+}
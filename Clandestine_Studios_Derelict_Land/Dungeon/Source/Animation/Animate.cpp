@@ -13,11 +13,23 @@
  /******************************************************************************/
 #include "Animation/Animate.h"
 
-Animate::Animate() : isVisible{ true }, isPlaying{ true }, milliseconds_per_sprite{ 0 }, TexHandle{ "" }, RGB_0to1{ 1.f,1.f,1.f }, Alpha_0to1{ 1.f }, last_frame{ false }, total_frame{ 0 }, curr_frame{ 0 } {
+namespace {
+	std::vector<Animate::Playback> playbacks;	// packed, one slot per Animate
+	std::vector<Animate*> owners;				// Animate of each slot
+}
+
+Animate::Animate() : isVisible{ true }, isPlaying{ true }, milliseconds_per_sprite{ 0 }, TexHandle{ "" }, RGB_0to1{ 1.f,1.f,1.f }, Alpha_0to1{ 1.f }, slot{ playbacks.size() } {
 	SetType(ComponentType::Animate);
+	playbacks.emplace_back();
+	owners.push_back(this);
 }
 Animate::~Animate() {
-
+	// The last slot fills the hole so the array stays packed
+	playbacks[slot] = playbacks.back();
+	owners[slot] = owners.back();
+	owners[slot]->slot = slot;
+	playbacks.pop_back();
+	owners.pop_back();
 }
 
 void Animate::SetAnimate(bool isVisibile_param, bool Playing, int millisecs_per_sprite,
@@ -28,19 +40,24 @@ void Animate::SetAnimate(bool isVisibile_param, bool Playing, int millisecs_per_
 	this->TexHandle = tex_hdl;
 	this->RGB_0to1 = RGB_to_set;
 	this->Alpha_0to1 = alpha_param;
+	ResetPlayback();
 }
 
 std::string Animate::GetTexHandle() {
 	return this->TexHandle;
 }
 void Animate::SetTexHandle(std::string texhandle_param) {
+	if (texhandle_param == this->TexHandle)
+		return;
 	this->TexHandle = texhandle_param;
+	ResetPlayback();
 }
 bool Animate::GetVisibility() {
 	return this->isVisible;
 }
 void Animate::SetVisibility(bool vis_param) {
 	this->isVisible = vis_param;
+	SyncPlayback();
 }
 
 bool Animate::GetIsPlaying() {
@@ -48,27 +65,41 @@ bool Animate::GetIsPlaying() {
 }
 void Animate::SetIsPlaying(bool ply_param) {
 	this->isPlaying = ply_param;
+	SyncPlayback();
 }
 
 int Animate::GetTotalFrame() {
-	return total_frame;
-}
-void Animate::SetTotalFrame(int frames) {
-	total_frame = frames;
+	return GetPlayback().frames;
 }
 
 int Animate::GetCurrentFrame() {
-	return curr_frame;
+	return GetPlayback().frame;
 }
 void Animate::SetCurrentFrame(int frames) {
-	curr_frame = frames;
+	Playback& playback = GetPlayback();
+	if (playback.frames && frames >= playback.frames)
+		frames = playback.frames - 1;
+	playback.frame = frames < 0 ? 0 : frames;
+	playback.elapsed = playback.frame * playback.frame_duration;
+	playback.finished = false;
 }
 
 bool Animate::CheckLastFrame() {
-	return last_frame;
+	Playback& playback = GetPlayback();
+	return playback.frames && playback.frame == playback.frames - 1;
+}
+bool Animate::IsFinished() {
+	return GetPlayback().finished;
+}
+
+void Animate::SetLoop(bool loop_param) {
+	GetPlayback().loop = loop_param;
+}
+bool Animate::GetLoop() {
+	return GetPlayback().loop;
 }
-void Animate::SetCheckLastFrame(bool state) {
-	last_frame = state;
+void Animate::Restart() {
+	SetCurrentFrame(0);
 }
 
 int Animate::GetSpriteSpeed() {
@@ -76,6 +107,39 @@ int Animate::GetSpriteSpeed() {
 }
 void Animate::SetSpriteSpeed(int millisec) {
 	milliseconds_per_sprite = millisec;
+	SyncPlayback();
+}
+float Animate::GetFrameDuration() {
+	float seconds = milliseconds_per_sprite / 1000.f;
+	return seconds > MinFrameDuration ? seconds : MinFrameDuration;
+}
+
+Animate::Playback& Animate::GetPlayback() {
+	return playbacks[slot];
+}
+void Animate::SyncPlayback() {
+	Playback& playback = GetPlayback();
+	playback.playing = isVisible && isPlaying;
+	float duration = GetFrameDuration();
+	if (duration != playback.frame_duration) {
+		playback.elapsed *= duration / playback.frame_duration;
+		playback.frame_duration = duration;
+	}
+}
+void Animate::ResetPlayback() {
+	Playback& playback = GetPlayback();
+	playback.elapsed = 0.f;
+	playback.frame = 0;
+	playback.frames = 0;
+	playback.frames_per_row = 1;
+	playback.finished = false;
+	SyncPlayback();
+}
+std::vector<Animate::Playback>& Animate::GetPlaybacks() {
+	return playbacks;
+}
+Animate* Animate::GetPlaybackOwner(size_t index) {
+	return owners[index];
 }
 
 void Animate::CopyData(Component* Target) {
@@ -86,7 +150,9 @@ void Animate::CopyData(Component* Target) {
 		this->milliseconds_per_sprite = a->milliseconds_per_sprite;
 		this->TexHandle = a->TexHandle;
 		this->RGB_0to1 = a->RGB_0to1;
-		this->Alpha_0to1 = a->Alpha_0to1;		
+		this->Alpha_0to1 = a->Alpha_0to1;
+		ResetPlayback();
+		GetPlayback().loop = a->GetPlayback().loop;
 	}
 }
 void Animate::Serialize(FILE* fp) {
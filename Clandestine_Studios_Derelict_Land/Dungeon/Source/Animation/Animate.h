@@ -24,7 +24,6 @@ public:
 	std::string TexHandle;
 	Vec3 RGB_0to1;
 	float Alpha_0to1;
-	int delay{};
 
 	Animate();
 	~Animate();
@@ -108,21 +107,11 @@ public:
 	/**************************************************************************/
 	/*!
 	  \brief
-		Get total no. of frame of sprite.
+		Get total no. of frame of sprite, 0 until Animation finds its sheet.
 	*/
 	/**************************************************************************/
 	int GetTotalFrame();
 	/**************************************************************************/
-	/*!
-	  \brief
-		Set total no. of frame of sprite.
-
-	  \param frames
-		no. of frames.
-	*/
-	/**************************************************************************/
-	void SetTotalFrame(int frames);
-	/**************************************************************************/
 	/*!
 	  \brief
 		Get current no. of frame of sprite.
@@ -132,7 +121,7 @@ public:
 	/**************************************************************************/
 	/*!
 	  \brief
-		Set current no. of frame of sprite.
+		Set current no. of frame of sprite, playback carries on from it.
 
 	  \param frames
 		no. of frames.
@@ -149,13 +138,36 @@ public:
 	/**************************************************************************/
 	/*!
 	  \brief
-		Set last frame of sprite.
+		Check if an animation played once has shown its last frame for its
+		whole duration. Looping animations never finish.
+	*/
+	/**************************************************************************/
+	bool IsFinished();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Set whether the animation loops or holds its last frame, loops by
+		default.
 
-	  \param state
+	  \param loop_param
 		true or false.
 	*/
 	/**************************************************************************/
-	void SetCheckLastFrame(bool state);
+	void SetLoop(bool loop_param);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Get whether the animation loops.
+	*/
+	/**************************************************************************/
+	bool GetLoop();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Play the animation again from its first frame.
+	*/
+	/**************************************************************************/
+	void Restart();
 	/**************************************************************************/
 	/*!
 	  \brief
@@ -174,6 +186,14 @@ public:
 	/**************************************************************************/
 	void SetSpriteSpeed(int millisec);
 	/**************************************************************************/
+	/*!
+	  \brief
+		Get seconds each frame is shown, the sprite's speed but no faster
+		than MinFrameDuration.
+	*/
+	/**************************************************************************/
+	float GetFrameDuration();
+	/**************************************************************************/
 	/*!
 		\brief
 			CopyData() virtual override function to copy data to another
@@ -198,8 +218,72 @@ public:
 	/**************************************************************************/
 	virtual void Deserialize(FILE* fp) override;
 
+	static constexpr float MinFrameDuration{ 0.1f };	// seconds, the old animation tick
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Playback of one Animate. Kept apart from the component in one packed
+		array, so Animation advances every animation in a single loop.
+	*/
+	/**************************************************************************/
+	struct Playback {
+		float elapsed{};							// seconds since frame 0 was shown
+		float frame_duration{ MinFrameDuration };
+		int frame{};
+		int frames{};								// in the sheet, 0 until it is looked up
+		int frames_per_row{ 1 };
+		bool loop{ true };
+		bool playing{ true };						// visible and playing
+		bool finished{ false };						// played once and reached the end
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Get the playback of this Animate.
+	*/
+	/**************************************************************************/
+	Playback& GetPlayback();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Copies the flags and speed, which the editor may write directly, into
+		the playback. The frame shown is kept when the speed changes.
+	*/
+	/**************************************************************************/
+	void SyncPlayback();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Get the playback of every Animate, packed. Slots move when an
+		Animate is destroyed, so do not hold on to them.
+	*/
+	/**************************************************************************/
+	static std::vector<Playback>& GetPlaybacks();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Get the Animate a slot of GetPlaybacks belongs to.
+
+	  \param index
+		Index into GetPlaybacks.
+	*/
+	/**************************************************************************/
+	static Animate* GetPlaybackOwner(size_t index);
+
+	Animate(const Animate&) = delete;
+	Animate& operator=(const Animate&) = delete;
+
 private:
-	int total_frame, curr_frame;
-	bool last_frame;
+	/**************************************************************************/
+	/*!
+	  \brief
+		Starts the playback over, for a new sprite sheet.
+	*/
+	/**************************************************************************/
+	void ResetPlayback();
+
+	size_t slot;
 };
 
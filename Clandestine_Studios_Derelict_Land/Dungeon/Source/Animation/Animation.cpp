@@ -12,6 +12,7 @@
  */
  /******************************************************************************/
 #include "Animation.h"
+#include <cmath>
 
 Animation::Animation(){
 
@@ -26,40 +27,47 @@ void Animation::Init() {
 	sprite_counter = 0;
 	time = 0;
 	anim_dt = 0;
-
-	for (size_t i = 1; i < this->GetLevel()->GetGameObjectArray().size(); ++i)
-	{
-		Animate* Anim = dynamic_cast<Animate*>((this->GetLevel()->GetGameObjectArray())[i]->GetComponent(ComponentType::Animate));
-		if (Anim != nullptr) {
-			Anim->SetTotalFrame(this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).frames_per_row - 1);
-			Anim->SetCurrentFrame(this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).idx);
-		}
-	}
 }
 
 void Animation::Update(float dt) {
 	anim_dt = dt;
 	time_elapsed += dt;
 	time = time_elapsed / SPRITE_DURATION;
-	if (static_cast<int>(time) > sprite_counter) {
-		sprite_counter = static_cast<int>(time);
-		for (size_t i = 1; i < this->GetLevel()->GetGameObjectArray().size(); ++i)
-		{
-			Animate* Anim = dynamic_cast<Animate*>((this->GetLevel()->GetGameObjectArray())[i]->GetComponent(ComponentType::Animate));			
-			if (Anim != nullptr) {				
-				//Anim->SetCurrentFrame(this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).idx);
-				//Anim->SetTotalFrame(this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).frames_per_row);
-				if (Anim->GetVisibility() && Anim->GetIsPlaying()) {
-					Anim->delay += (int)(dt*1000);
-					if (Anim->delay > Anim->GetSpriteSpeed()) {
-						Anim->delay = 0;
-						this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).idx
-							= this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).idx == this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).frames_per_row - 1
-							? 0 : this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).idx + 1;
-					}
-				}
+	sprite_counter = static_cast<int>(time);
+
+	Assets* assets = this->GetLevel()->GetAssets();
+	const auto& sheets = assets->GetSpriteMap();
+	std::vector<Animate::Playback>& playbacks = Animate::GetPlaybacks();
+	for (size_t i = 0; i < playbacks.size(); ++i)
+	{
+		Animate::Playback& playback = playbacks[i];
+		// Only after the sheet changed, textures that are not sheets get one frame
+		if (!playback.frames) {
+			std::string handle = Animate::GetPlaybackOwner(i)->GetTexHandle();
+			auto sheet = sheets.find(handle);
+			playback.frames = sheet != sheets.end() && !sheet->second->texcoords.empty() ? static_cast<int>(sheet->second->texcoords.size()) : 1;
+			playback.frames_per_row = sheet != sheets.end() ? sheet->second->frames_per_row : 1;
+			if (FlipbookStream* stream = assets->GetFlipbook(handle)) {
+				playback.frames = stream->GetFrames();
+				playback.frames_per_row = 1;
 			}
 		}
+		if (!playback.playing || playback.finished)
+			continue;
+
+		playback.elapsed += dt;
+		int frame = static_cast<int>(playback.elapsed / playback.frame_duration);
+		if (frame >= playback.frames) {
+			if (playback.loop) {
+				playback.elapsed = std::fmod(playback.elapsed, playback.frames * playback.frame_duration);
+				frame = static_cast<int>(playback.elapsed / playback.frame_duration) % playback.frames;
+			}
+			else {
+				frame = playback.frames - 1;
+				playback.finished = true;
+			}
+		}
+		playback.frame = frame;
 	}
 }
 
@@ -81,3 +89,19 @@ bool Animation::PlayAnimation(Animate* Object) {
 	}
 	return 0;
 }
+
+Batch::Flipbook Animation::GetFlipbook(Animate* Object, const Assets::Sprite& Sheet) {
+	Object->SyncPlayback();
+	Animate::Playback& playback = Object->GetPlayback();
+	playback.frames = Sheet.texcoords.empty() ? 1 : static_cast<int>(Sheet.texcoords.size());
+	playback.frames_per_row = Sheet.frames_per_row;
+
+	// The small bias keeps the GPU from rounding down to the frame before
+	Batch::Flipbook flipbook;
+	flipbook.Start = Batch::GetClock() - playback.elapsed - 0.001f * playback.frame_duration;
+	flipbook.FrameDuration = playback.frame_duration;
+	flipbook.Frames = playback.playing && !playback.finished ? playback.frames : 1;
+	flipbook.FramesPerRow = playback.frames_per_row;
+	flipbook.Loop = playback.loop;
+	return flipbook;
+}
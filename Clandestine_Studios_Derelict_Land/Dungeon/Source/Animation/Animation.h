@@ -38,7 +38,9 @@ public:
 	/**************************************************************************/
 	/*!
 	  \brief
-		Initializes Animation System
+		Advances the playback of every Animate in one pass over the packed
+		array, so game objects are not visited. Drawing picks the frame on
+		the GPU from the same timeline, this keeps the frame for scripts.
 
 	  \param dt
 		delta time.
@@ -63,6 +65,24 @@ public:
 	/**************************************************************************/
 	static bool PlayAnimation(Animate* Object);
 	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the timeline to draw an animated sprite with, from its
+		playback. Paused and finished sprites get a single frame, the
+		current one.
+
+	  \param Object
+		Animate component being drawn.
+
+	  \param Sheet
+		Sprite sheet of the component.
+
+	  \return
+		Flipbook for Batch::DrawAnimatedSprite.
+	*/
+	/**************************************************************************/
+	static Batch::Flipbook GetFlipbook(Animate* Object, const Assets::Sprite& Sheet);
+	/**************************************************************************/
 	/*!
 	  \brief
 		Get Time Elapsed calculated in Animation System
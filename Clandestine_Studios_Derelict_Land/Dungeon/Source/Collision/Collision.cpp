@@ -17,6 +17,14 @@
 		 Sets class velocity.
 		 -SetBoundingBox
 		 Sets bounding box.
+		 - UpdateBoundingBox
+		 Sets bounding box only if the transform changed.
+		 - Wake
+		 Wakes a sleeping body.
+		 - MarkBoundsDirty
+		 Forces the bounding box to be rebuilt.
+		 - IsSettled
+		 Checks if body is static or asleep.
 		 - CollisionIntersection_RectRect
 		 Detects collision by AABB.
 		  - operator=
@@ -78,7 +86,7 @@ float Min(float a, float b) {
 	Default constructor.
 ****************************************************************************
 ***/
-Collision::Collision() :go_is_colliding(false) {
+Collision::Collision() :go_is_colliding(false), Body(BodyType::Dynamic), isAsleep(false), boundsDirty(true), restingContact(false), restSteps(0) {
 	SetType(ComponentType::Collision); showBox = false;
 }
 
@@ -113,6 +121,72 @@ void Collision::SetBoundingBox(Vec2 PositionInst, Vec2 ScaleInst, Vec2 Dimension
 	BoundingBox.max.y = 0.5f * DimensionInst.y * (ScaleInst.y / 100.f) + PositionInst.y;
 }
 
+/*!*************************************************************************
+****
+\brief
+	Sets bounding box parameters only if the transform has changed since
+	the last update, or the bounds were marked dirty. Static bodies are
+	only rebuilt when marked dirty.
+\param[in] PositionInst
+	Position of game object ( from Transform )
+\param[in] ScaleInst
+	Scale of game object ( from Transform )
+\param[in] DimensionInst
+	Dimensions of game object ( from Transform )
+\return
+	True if the bounding box was rebuilt; false if unchanged.
+****************************************************************************
+***/
+bool Collision::UpdateBoundingBox(Vec2 PositionInst, Vec2 ScaleInst, Vec2 DimensionInst) {
+	if (!boundsDirty) {
+		if (Body == BodyType::Static) return false;
+		if (PositionInst.x == CachedPosition.x && PositionInst.y == CachedPosition.y &&
+			ScaleInst.x == CachedScale.x && ScaleInst.y == CachedScale.y &&
+			DimensionInst.x == CachedDimensions.x && DimensionInst.y == CachedDimensions.y) return false;
+	}
+	SetBoundingBox(PositionInst, ScaleInst, DimensionInst);
+	CachedPosition = PositionInst;
+	CachedScale = ScaleInst;
+	CachedDimensions = DimensionInst;
+	boundsDirty = false;
+	return true;
+}
+
+/*!*************************************************************************
+****
+\brief
+	Wakes a sleeping body and resets its rest counter.
+****************************************************************************
+***/
+void Collision::Wake() {
+	isAsleep = false;
+	restingContact = false;
+	restSteps = 0;
+}
+
+/*!*************************************************************************
+****
+\brief
+	Forces the bounding box to be rebuilt on the next physics step.
+****************************************************************************
+***/
+void Collision::MarkBoundsDirty() {
+	boundsDirty = true;
+	Wake();
+}
+
+/*!*************************************************************************
+****
+\brief
+	Checks if body will not move this step.
+\return
+	True if body is static or asleep.
+****************************************************************************
+***/
+bool Collision::IsSettled() const {
+	return Body == BodyType::Static || isAsleep;
+}
+
 /*!*************************************************************************
 ****
 \brief
@@ -126,6 +200,8 @@ void Collision::SetBoundingBox(Vec2 PositionInst, Vec2 ScaleInst, Vec2 Dimension
 Collision& Collision::operator=(Collision& rhs) {
 	this->BoundingBox = rhs.BoundingBox;
 	this->Vel = rhs.Vel;
+	this->Body = rhs.Body;
+	this->boundsDirty = true;
 	return *this;
 }
 
@@ -142,6 +218,8 @@ void Collision::CopyData(Component* Target) {
 	if (t != nullptr) {
 		this->BoundingBox = t->BoundingBox;
 		this->Vel = t->Vel;
+		this->Body = t->Body;
+		this->boundsDirty = true;
 	}
 }
 
@@ -156,6 +234,7 @@ void Collision::CopyData(Component* Target) {
 void Collision::Serialize(FILE* fp)
 {
 	fprintf(fp, "Collision\n");
+	fprintf(fp, "Body Type: %d\n", static_cast<int>(Body));
 }
 
 /*!*************************************************************************
@@ -168,8 +247,15 @@ void Collision::Serialize(FILE* fp)
 ***/
 void Collision::Deserialize(FILE* fp)
 {
-	(void)fp;
-	//Do nothing
+	// Older scenes have no body type, keep the dynamic default for them
+	int type = static_cast<int>(BodyType::Dynamic);
+	if (fscanf(fp, "Body Type: %d\n", &type) == 1 &&
+		type >= static_cast<int>(BodyType::Static) && type <= static_cast<int>(BodyType::Dynamic))
+	{
+		Body = static_cast<BodyType>(type);
+	}
+	boundsDirty = true;
+	Wake();
 }
 
 /*!*************************************************************************
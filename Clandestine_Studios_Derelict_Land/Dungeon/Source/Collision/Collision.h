@@ -17,6 +17,14 @@
 		 Sets class velocity.
 		 -SetBoundingBox
 		 Sets bounding box.
+		 - UpdateBoundingBox
+		 Sets bounding box only if the transform changed.
+		 - Wake
+		 Wakes a sleeping body.
+		 - MarkBoundsDirty
+		 Forces the bounding box to be rebuilt.
+		 - IsSettled
+		 Checks if body is static or asleep.
 		 - CollisionIntersection_RectRect
 		 Detects collision by AABB.
 		  - operator=
@@ -46,6 +54,21 @@ struct AABB {
 	Vec2 min, max;
 };
 
+/*!*************************************************************************
+****
+\brief
+	How a collider is treated by the physics system.
+	- Static: never moves, bounds built once at load or on editor edit.
+	- Kinematic: moved by scripts, bounds rebuilt every step, never sleeps.
+	- Dynamic: bounds rebuilt when moved, sleeps when at rest.
+****************************************************************************
+***/
+enum class BodyType {
+	Static = 0,
+	Kinematic,
+	Dynamic
+};
+
 /*!*************************************************************************
 ****
 \brief
@@ -79,6 +102,12 @@ public:
 	AABB BoundingBox;
 	Vec2 Vel;
 	bool go_is_colliding, showBox;
+	BodyType Body;
+	bool isAsleep, boundsDirty, restingContact;
+	int restSteps;
+	Vec2 CachedPosition, CachedScale, CachedDimensions;
+
+	constexpr static int STEPS_TO_SLEEP = 30; // number of steps at rest before a dynamic body sleeps
 	/*!*************************************************************************
 	****
 	\brief
@@ -108,6 +137,50 @@ public:
 	***/
 	void SetBoundingBox(Vec2 PositionInst, Vec2 ScaleInst, Vec2 DimensionInst);
 
+	/*!*************************************************************************
+	****
+	\brief
+		Sets bounding box parameters only if the transform has changed since
+		the last update, or the bounds were marked dirty. Static bodies are
+		only rebuilt when marked dirty.
+	\param[in] PositionInst
+		Position of game object.
+	\param[in] ScaleInst
+		Scale of game object.
+	\param[in] DimensionInst
+		Dimensions of game object.
+	\return
+		True if the bounding box was rebuilt; false if unchanged.
+	****************************************************************************
+	***/
+	bool UpdateBoundingBox(Vec2 PositionInst, Vec2 ScaleInst, Vec2 DimensionInst);
+
+	/*!*************************************************************************
+	****
+	\brief
+		Wakes a sleeping body and resets its rest counter.
+	****************************************************************************
+	***/
+	void Wake();
+
+	/*!*************************************************************************
+	****
+	\brief
+		Forces the bounding box to be rebuilt on the next physics step.
+	****************************************************************************
+	***/
+	void MarkBoundsDirty();
+
+	/*!*************************************************************************
+	****
+	\brief
+		Checks if body will not move this step.
+	\return
+		True if body is static or asleep.
+	****************************************************************************
+	***/
+	bool IsSettled() const;
+
 	/*!*************************************************************************
 	****
 	\brief
@@ -0,0 +1,45 @@
+/******************************************************************************/
+/*!
+\file    CommandLine.cpp
+\author  Lim Hui Ching, l.huiching, 620004221
+\par     email: l.huiching\@digipen.edu
+\date    March 20, 2023
+\brief   Function definitions shared by the command line tools the game
+		 runs instead of opening a window (--physics-bench, --cook-atlases,
+		 --cook-textures, --cook-flipbooks).
+		 The functions include:
+		 - NextArgument
+		 Reads the value following an argument.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "CommandLine.h"
+#include <iostream>
+
+/*!*************************************************************************
+****
+\brief
+	Reads the value following an argument.
+\param[in] argc
+	Number of arguments.
+\param[in] argv
+	Arguments.
+\param[in,out] i
+	Index of the argument, moved onto its value.
+\param[out] value
+	Value read.
+\return
+	True if there was a value.
+****************************************************************************
+***/
+bool CommandLine::NextArgument(int argc, char** argv, int& i, std::string& value)
+{
+	if (i + 1 >= argc) { std::cout << "Missing value for " << argv[i] << "\n"; return false; }
+
+	value = argv[++i];
+	return true;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************/
+/*!
+\file    CommandLine.h
+\author  Lim Hui Ching, l.huiching, 620004221
+\par     email: l.huiching\@digipen.edu
+\date    March 20, 2023
+\brief   Function declarations shared by the command line tools the game
+		 runs instead of opening a window (--physics-bench, --cook-atlases,
+		 --cook-textures, --cook-flipbooks).
+		 The functions include:
+		 - NextArgument
+		 Reads the value following an argument.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#pragma once
+#include <string>
+
+namespace CommandLine
+{
+	/*!*************************************************************************
+	****
+	\brief
+		Reads the value following an argument, printing which argument it
+		is missing for if the command line ends first.
+	\param[in] argc
+		Number of arguments.
+	\param[in] argv
+		Arguments.
+	\param[in,out] i
+		Index of the argument, moved onto its value.
+	\param[out] value
+		Value read.
+	\return
+		True if there was a value.
+	****************************************************************************
+	***/
+	bool NextArgument(int argc, char** argv, int& i, std::string& value);
+}
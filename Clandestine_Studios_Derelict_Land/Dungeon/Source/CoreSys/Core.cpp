@@ -13,6 +13,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
  /******************************************************************************/
 #include "Core.h"
 #include "Graphics/GLFWsetup.h"
+#include "Graphics/RenderThread.h"
 
 
 
@@ -143,7 +144,11 @@ void Core::Update()
 		}
 		//sClockPoint Aft_systems = std::chrono::high_resolution_clock::now();
 		AppTimeElapsed += dt;
+
+		// Render extraction: this frame's render commands go to the render thread while the next frame simulates
+		RenderThread::EndFrame();
 	}
+	RenderThread::Stop();
 }
 
 /**************************************************************************/
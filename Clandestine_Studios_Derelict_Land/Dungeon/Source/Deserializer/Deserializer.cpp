@@ -136,6 +136,9 @@ void FilePtr::SerializeRigidBody(FILE* ptr, RigidBody* rbInst)
 		std::cout << "Serialize RigidBody Failed!";
 	}
 	rbInst->SetRigidBody(State, F, IM);
+	// Optional, older scenes have no damping or gravity
+	(void)fscanf(ptr, "Damping: %f\n", &rbInst->Damping);
+	(void)fscanf(ptr, "Gravity Scale: %f\n", &rbInst->GravityScale);
 }
 
 /*!*************************************************************************
@@ -700,6 +703,98 @@ void FilePtr::DeserializeSpriteSheet(std::string Filename, Assets& AssetsManager
 	inFile.close();
 }
 /**************************************************************************/
+/*!
+  \brief
+	Deserializes the atlas pages and UV remap table written by the atlas
+	cooker. Without the table every texture loads standalone.
+
+  \param Filename
+	File path of TextureAtlas.txt.
+
+  \param AssetsManager
+	AssetsManager to keep the remap table.
+*/
+/**************************************************************************/
+void FilePtr::DeserializeAtlas(std::string Filename, Assets& AssetsManager) {
+	std::ifstream inFile;
+	inFile.open(Filename);
+	if (inFile.is_open()) {
+		std::string tag, file;
+		while (inFile >> tag >> file) {
+			if (tag == "Page") {
+				AssetsManager.AddAtlasPage(file);
+			}
+			else if (tag == "Image") {
+				Assets::AtlasEntry entry{};
+				inFile >> entry.page >> entry.uvmin.x >> entry.uvmin.y >> entry.uvmax.x >> entry.uvmax.y >> entry.size.x >> entry.size.y;
+				AssetsManager.AddAtlasEntry(file, entry);
+			}
+		}
+	}
+	else {
+		std::cout << "No texture atlas found, textures load standalone.\n";
+	}
+	inFile.close();
+}
+/**************************************************************************/
+/*!
+  \brief
+	Deserializes the video memory budget of textures, in MB, followed by
+	the output height textures are authored for. Without the file the
+	defaults are kept.
+
+  \param Filename
+	File path of TextureBudget.txt.
+
+  \param AssetsManager
+	AssetsManager to set the budget and authored height of.
+*/
+/**************************************************************************/
+void FilePtr::DeserializeTextureBudget(std::string Filename, Assets& AssetsManager) {
+	std::ifstream inFile;
+	inFile.open(Filename);
+	size_t megabytes{};
+	int authored_height{};
+	if (inFile.is_open() && inFile >> megabytes) {
+		AssetsManager.SetTextureBudget(megabytes << 20);
+		if (inFile >> authored_height)
+			AssetsManager.SetAuthoredHeight(authored_height);
+	}
+	else {
+		std::cout << "No texture budget found, keeping " << (AssetsManager.GetTextureBudget() >> 20) << " MB.\n";
+	}
+	inFile.close();
+}
+/**************************************************************************/
+/*!
+  \brief
+	Deserializes the flipbooks streamed from their cooked .flip files. The
+	frame counts following a sprite sheet source are only for the cooker.
+
+  \param Filename
+	File path of Flipbooks.txt.
+
+  \param AssetsManager
+	AssetsManager to keep flipbooks.
+*/
+/**************************************************************************/
+void FilePtr::DeserializeFlipbooks(std::string Filename, Assets& AssetsManager) {
+	std::ifstream inFile;
+	inFile.open(Filename);
+	if (inFile.is_open()) {
+		std::string line, id, source;
+		while (std::getline(inFile, line)) {
+			std::istringstream fields(line);
+			if (fields >> id >> source)
+				AssetsManager.AddFlipbook(id, source.c_str());
+		}
+	}
+	else {
+		std::cout << "No flipbooks found, sprite sheets are drawn instead.\n";
+	}
+	inFile.close();
+}
+/**************************************************************************/
 /*!
   \brief
 	Deserializes fonts read in Fonts.txt.
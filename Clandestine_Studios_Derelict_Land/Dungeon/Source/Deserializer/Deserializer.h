@@ -301,6 +301,51 @@ public:
 
 	static void DeserializeSpriteSheet(std::string Filename, Assets& AssetsManager);
 	/**************************************************************************/
+	/*!
+	  \brief
+		Deserializes the atlas pages and UV remap table written by the atlas
+		cooker. Must run before textures and sprites are added.
+
+	  \param Filename
+		File path of TextureAtlas.txt.
+
+	  \param AssetsManager
+		AssetsManager to keep the remap table.
+	*/
+	/**************************************************************************/
+	static void DeserializeAtlas(std::string Filename, Assets& AssetsManager);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Deserializes the video memory budget of textures, in MB, followed by
+		the output height textures are authored for. Without the file the
+		defaults are kept.
+
+	  \param Filename
+		File path of TextureBudget.txt.
+
+	  \param AssetsManager
+		AssetsManager to set the budget and authored height of.
+	*/
+	/**************************************************************************/
+	static void DeserializeTextureBudget(std::string Filename, Assets& AssetsManager);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Deserializes the flipbooks streamed from their cooked .flip files,
+		a name and the source the flipbook was cooked from on each line.
+		Must run after sprite sheets are added, as a flipbook takes over the
+		sheet of the same name.
+
+	  \param Filename
+		File path of Flipbooks.txt.
+
+	  \param AssetsManager
+		AssetsManager to keep flipbooks.
+	*/
+	/**************************************************************************/
+	static void DeserializeFlipbooks(std::string Filename, Assets& AssetsManager);
+	/**************************************************************************/
 	/*!
 	  \brief
 		Deserializes fonts read in Fonts.txt.
@@ -16,6 +16,8 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Deserializer/Deserializer.h"
 #include "Input/Input.h"
 #include "Audio/Audio.h"
+#include "Graphics/RenderStats.h"
+#include "Graphics/RenderThread.h"
 
 bool editor_open;
 
@@ -31,7 +33,7 @@ namespace
 /*!*************************************************************************/
 Editor::Editor(bool nOpen, EditorState nState) : open(nOpen), state(nState),
 logger(Logger::GetInstance()), console(Console::GetInstance()), menuBar(new MenuBar()), hierarchy(new Hierarchy()),
-propertyEditor(PropertyEditor::GetInstance()), gameWindow(new GameWindow()), fileBrowser(FileBrowser::GetInstance())
+propertyEditor(PropertyEditor::GetInstance()), gameWindow(new GameWindow()), fileBrowser(FileBrowser::GetInstance()), profiler(new Profiler())
 {
 	systems.reserve(sizeof(System*) * static_cast<int>(EditorSystem::EditorSystemMax));
 }
@@ -56,6 +58,7 @@ void Editor::Init()
 	systems.emplace_back(gameWindow);
 	systems.emplace_back(fileBrowser);
 	systems.emplace_back(console);
+	systems.emplace_back(profiler);
 
 	// Initialize systems
 	for (auto& system : systems) { system->SetLevel(this->GetLevel()); system->Init(); } editor_open = true;
@@ -163,6 +166,7 @@ void Editor::InitIMGUI()
 	// Setup Platform/Renderer bindings
 	ImGui_ImplGlfw_InitForOpenGL(GLSetup::ptr_window, true);
 	ImGui_ImplOpenGL3_Init("#version 450"); // same as in Fonts.cpp
+	ImGui_ImplOpenGL3_CreateDeviceObjects(); // NewFrame can not make them once the render thread owns the context
 }
 
 /**************************************************************************/
@@ -173,7 +177,7 @@ void Editor::ShutdownIMGUI() { ImGui_ImplOpenGL3_Shutdown(); ImGui_ImplGlfw_Shut
 /**************************************************************************/
 /*! \brief IMGUI side initialization of the next new frame.
 /**************************************************************************/
-void Editor::NewFrame() { ImGui_ImplOpenGL3_NewFrame(); ImGui_ImplGlfw_NewFrame(); ImGui::NewFrame(); }
+void Editor::NewFrame() { if (!RenderThread::IsRunning()) { ImGui_ImplOpenGL3_NewFrame(); } ImGui_ImplGlfw_NewFrame(); ImGui::NewFrame(); }
 
 /**************************************************************************/
 /*! \brief IMGUI side rendering of the current frame.
@@ -181,7 +185,30 @@ void Editor::NewFrame() { ImGui_ImplOpenGL3_NewFrame(); ImGui_ImplGlfw_NewFrame(
 void Editor::Render()
 {
 	// Rendering
-	ImGui::Render(); ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	ImGui::Render();
+	if (RenderThread::IsRunning())
+	{
+		// ImGui reuses its draw lists next frame, so the render thread draws a copy
+		ImDrawData* source = ImGui::GetDrawData();
+		std::shared_ptr<ImDrawData> copy(new ImDrawData(*source), [](ImDrawData* data)
+			{
+				for (int i = 0; i < data->CmdListsCount; ++i) { IM_DELETE(data->CmdLists[i]); }
+				delete[] data->CmdLists;
+				delete data;
+			});
+		copy->CmdLists = new ImDrawList*[source->CmdListsCount > 0 ? source->CmdListsCount : 1];
+		for (int i = 0; i < source->CmdListsCount; ++i) { copy->CmdLists[i] = source->CmdLists[i]->CloneOutput(); }
+		RenderThread::Submit([copy]
+			{
+				RenderStats::Begin(RenderStats::EditorUI);
+				ImGui_ImplOpenGL3_RenderDrawData(copy.get());
+				RenderStats::End(RenderStats::EditorUI);
+			});
+		return;
+	}
+	RenderStats::Begin(RenderStats::EditorUI);
+	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	RenderStats::End(RenderStats::EditorUI);
 
 	// Update and Render additional Platform Windows
 	// (Platform functions may change the current OpenGL context)
@@ -317,4 +344,9 @@ Hierarchy& Editor::GetHierarchy() { return *hierarchy; }
 /**************************************************************************/
 GameWindow& Editor::GetGameWindow() { return *gameWindow; }
 
+/**************************************************************************/
+/*! \brief Returns a reference to the profiler window.
+/**************************************************************************/
+Profiler& Editor::GetProfiler() { return *profiler; }
+
 #pragma endregion
\ No newline at end of file
@@ -22,6 +22,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Editor/UI/GameWindow/GameWindow.h"
 #include "Editor/UI/FileBrowser/FileBrowser.h"
 #include "Editor/UI/Console/Console.h"
+#include "Editor/UI/Profiler/Profiler.h"
 
 enum class EditorState { EditorPlaying = 0, EditorPaused, EditorStopped, EditorStateMax };
 
@@ -37,6 +38,7 @@ enum class EditorSystem
 	GameWindow,
 	FileBrowser,
 	Console,
+	Profiler,
 	// ASSET_MANAGER,
 	// SCENE_MANAGER,
 	// AUDIO,
@@ -90,6 +92,7 @@ public:
 	FileBrowser& GetFileBrowser();
 	Console& GetConsole();
 	GameWindow& GetGameWindow();
+	Profiler& GetProfiler();
 	
 	bool open; // editor visible state
 	bool playFullScreen = true; // play current scene with all other windows closed or not
@@ -104,6 +107,7 @@ private:
 	PropertyEditor* propertyEditor;
 	FileBrowser* fileBrowser;
 	GameWindow* gameWindow;
+	Profiler* profiler;
 	
 private:
 	// Vector of systems that are exclusively part of the editor
@@ -1,5 +1,6 @@
 #include "Editor/UI/GameWindow/GameWindow.h"
 #include "Editor/UI/Editor.h"
+#include "Graphics/BatchRendering.h"
 
 /************************************************************************ /
 /*!
@@ -159,6 +160,7 @@ void GameWindow::Update(float dt)
 		{
 			if (ImGui::GetIO().KeyCtrl && ImGui::IsKeyReleased(ImGuiKey_Z))
 			{
+				Batch::InvalidateStatic(); // undoing may move, restore or remove a baked object
 				// Typically if there's only one transform history command, it's the initial selection of a GO.
 				if (transformHistory.size() == 1 || !transformHistoryIndex)
 				{
@@ -233,6 +235,7 @@ void GameWindow::Update(float dt)
 			}
 			else if (ImGui::GetIO().KeyCtrl && ImGui::IsKeyReleased(ImGuiKey_Y))
 			{
+				Batch::InvalidateStatic(); // redoing may move or remove a baked object
 				if (!transformHistoryIndex)
 				{
 					if (editor->GetPropertyEditor().GetSelectedGameObject() == transformHistory[transformHistoryIndex].obj && transformHistory.size() > 1)
@@ -842,6 +845,7 @@ void GameWindow::GameObjectTransforming(Vec2 mousePos, Transform*& trf, const Tr
 
 	// (hopefully) temporary fix that should stop the layering system from breaking the mouse picking.
 	trf->GetComponentOwner()->GetComponent<GameUI>()->SetAABB(trf->Position, trf->Scale, trf->Dimensions);
+	Batch::InvalidateStatic();
 }
 
 /**************************************************************************/
@@ -13,6 +13,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Editor/UI/Editor.h"
 #include "Editor/IMGUIHeaders.h"
 #include "Factory/Factory.h"
+#include "Graphics/BatchRendering.h"
 
 namespace {
 	char renameBuffer[256]{ 0 };
@@ -315,6 +316,8 @@ void Hierarchy::DisplayHierarchy()
 								std::swap(hierarchyList[i], hierarchyList[n_next]);
 								// Swap the game objects' positions in the level's game object array
 								std::swap(this->GetLevel()->GetGameObjectArray()[i], this->GetLevel()->GetGameObjectArray()[n_next]);
+								// The static batches flag objects by their place in the array
+								Batch::InvalidateStatic();
 								// swap ids
 								/*
 								std::swap(hierarchyIds[i].first, hierarchyIds[n_next].first);
@@ -13,6 +13,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Factory/Factory.h"
 #include "Editor/UI/Editor.h"
 #include "Editor/IMGUIHeaders.h"
+#include "Graphics/BatchRendering.h"
 
 
 /*
@@ -307,6 +308,7 @@ void MenuBar::DrawMenuBar()
 			if (ImGui::MenuItem("FileBrowser", 0, editor->GetFileBrowser().GetOpen())) { editor->GetFileBrowser().SetOpen(!editor->GetFileBrowser().GetOpen()); }
 			if (ImGui::MenuItem("Hierarchy", 0, editor->GetHierarchy().GetOpen())) { editor->GetHierarchy().SetOpen(!editor->GetHierarchy().GetOpen()); }
 			if (ImGui::MenuItem("Project", 0, editor->GetFileBrowser().GetOpen())) { editor->GetFileBrowser().SetOpen(!editor->GetFileBrowser().GetOpen()); }
+			if (ImGui::MenuItem("Profiler", 0, editor->GetProfiler().GetOpen())) { editor->GetProfiler().SetOpen(!editor->GetProfiler().GetOpen()); }
 			
 			ImGui::EndMenu();
 		}
@@ -551,6 +553,7 @@ void MenuBar::DrawMenuBar()
 				ImGui::PushID(i);
 				if (ImGui::Checkbox(GameObject::GetLayers()[i].c_str(), &layerVisible)) {
 					GameObject::GetLayerMask().set(i, layerVisible);
+					Batch::InvalidateStatic(); // hidden layers are not baked
 				}
 				ImGui::PopID();
 			}
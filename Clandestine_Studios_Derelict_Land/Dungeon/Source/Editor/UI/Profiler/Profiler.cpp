@@ -0,0 +1,173 @@
+/*!*************************************************************************
+\file	Profiler.cpp
+\author Warren Ang Jun Xuan
+\email: a.warrenjunxuan@digipen.edu
+\date	22-03-23
+\brief	Editor window showing the GPU time of each render pass, the work
+		done by the batch renderer, read from RenderStats, and the video
+		memory taken by textures. GPU times lag the frame by a few frames
+		since the queries are read back late. Debug draw categories are
+		switched on and off here.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*****************************************************************************/
+#include "Editor/UI/Editor.h"
+#include "Editor/IMGUIHeaders.h"
+#include "Graphics/DebugDraw.h"
+#include "Graphics/RenderStats.h"
+#include "Graphics/TextureLoader.h"
+
+namespace {
+	const char* exportPath = "RenderStats.csv";		// history written by Export
+	const char* capturePath = "RenderCapture.csv";	// every frame written while capturing
+	const char* flushNames[Batch::FlushReasonCount] = { "Quads full", "Textures full", "Lines full", "End of pass" };
+}
+
+/**************************************************************************/
+/*! \brief Constructor.
+/**************************************************************************/
+Profiler::Profiler(bool nOpen) : open(nOpen), plotPass(RenderStats::World) { }
+
+/**************************************************************************/
+/*! \brief Destructor.
+/**************************************************************************/
+Profiler::~Profiler() { }
+
+/**************************************************************************/
+/*! \brief Initializes the Profiler window.
+/**************************************************************************/
+void Profiler::Init() { }
+
+/**************************************************************************/
+/*!
+* \brief
+*	Updates the Profiler window.
+* \param dt
+*	The delta time.
+*/
+/**************************************************************************/
+void Profiler::Update(float dt) { (void)dt; if (open) { DrawProfiler(); } }
+
+/**************************************************************************/
+/*! \brief Shutdown the Profiler window. Stops any capture in progress.
+/**************************************************************************/
+void Profiler::Shutdown() { RenderStats::StopCapture(); }
+
+/**************************************************************************/
+/*! \brief Returns the open state of the Profiler window.
+/**************************************************************************/
+bool Profiler::GetOpen() const { return open; }
+
+/**************************************************************************/
+/*! \brief Sets the open state of the Profiler window.
+/**************************************************************************/
+void Profiler::SetOpen(const bool nOpen) { open = nOpen; }
+
+/**************************************************************************/
+/*!
+* \brief
+*	Draws the pass timings, batch counters and export controls.
+*/
+/**************************************************************************/
+void Profiler::DrawProfiler()
+{
+	if (!ImGui::Begin("Profiler", &open)) { ImGui::End(); return; }
+
+	std::vector<RenderStats::Frame> history = RenderStats::GetHistory();
+	ImGui::Text("FPS: %.1f", GLSetup::fps);
+	if (history.empty()) { ImGui::TextUnformatted("Waiting for GPU timings..."); ImGui::End(); return; }
+
+	const RenderStats::Frame& last = history.back();
+	ImGui::SameLine(); ImGui::Text("| Frame %llu: %.2f ms", (unsigned long long)last.Number, last.FrameMs);
+
+	// GPU time per pass: last frame, average and worst over the history
+	if (ImGui::BeginTable("Passes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("GPU pass"); ImGui::TableSetupColumn("Last (ms)");
+		ImGui::TableSetupColumn("Avg (ms)"); ImGui::TableSetupColumn("Max (ms)");
+		ImGui::TableHeadersRow();
+		for (uint8_t pass = 0; pass < RenderStats::PassCount; ++pass)
+		{
+			float sum = 0.0f, worst = 0.0f;
+			for (const RenderStats::Frame& frame : history) { sum += frame.GpuMs[pass]; worst = frame.GpuMs[pass] > worst ? frame.GpuMs[pass] : worst; }
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(RenderStats::GetPassName(pass));
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", last.GpuMs[pass]);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", sum / history.size());
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", worst);
+		}
+		ImGui::EndTable();
+	}
+
+	// Frame time against the GPU time of one pass
+	std::vector<float> frameMs, passMs;
+	for (const RenderStats::Frame& frame : history) { frameMs.push_back(frame.FrameMs); passMs.push_back(frame.GpuMs[plotPass]); }
+	ImGui::PlotLines("Frame (ms)", frameMs.data(), (int)frameMs.size(), 0, 0, 0.0f, FLT_MAX, ImVec2(0, 60));
+	ImGui::PlotLines("##PassPlot", passMs.data(), (int)passMs.size(), 0, 0, 0.0f, FLT_MAX, ImVec2(0, 60));
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(100.0f);
+	if (ImGui::BeginCombo("##PlotPass", RenderStats::GetPassName((uint8_t)plotPass)))
+	{
+		for (int pass = 0; pass < RenderStats::PassCount; ++pass)
+		{
+			if (ImGui::Selectable(RenderStats::GetPassName((uint8_t)pass), pass == plotPass)) { plotPass = pass; }
+		}
+		ImGui::EndCombo();
+	}
+
+	// Batch renderer counters of the last frame
+	if (ImGui::CollapsingHeader("Batch", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		const Batch::Stats& stats = last.Counters;
+		ImGui::Text("Draw calls: %u", stats.DrawCalls);
+		ImGui::Text("Quads: %u", stats.Quads);
+		ImGui::Text("Texture binds: %u", stats.TextureBinds);
+		ImGui::Text("Uploaded: %.1f KB", stats.BytesUploaded / 1024.0);
+		for (int reason = 0; reason < Batch::FlushReasonCount; ++reason) { ImGui::Text("Flushes (%s): %u", flushNames[reason], stats.Flushes[reason]); }
+	}
+
+	// Texture residency, referenced textures may take the total over the budget
+	if (ImGui::CollapsingHeader("Textures", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		Assets& assets = MasterObjectList->MasterAssets;
+		ImGui::Text("Resident: %.1f / %.1f MB", assets.GetResidentBytes() / 1048576.0, assets.GetTextureBudget() / 1048576.0);
+		TextureLoader::Progress progress = TextureLoader::GetProgress();
+		ImGui::Text("Loading: %zu", progress.Requested - progress.Uploaded - progress.Failed);
+		const char* tierNames[] = { "full", "half", "quarter" };
+		ImGui::Text("Tier: %s", tierNames[assets.GetTextureTier()]);
+		ImGui::Text("Flipbooks: %.1f MB", FlipbookStream::GetResidentBytes() / 1048576.0);
+	}
+
+	// Debug shapes, a category switched off records nothing
+	if (ImGui::CollapsingHeader("Debug draw"))
+	{
+		ImGui::Text("Shapes: %zu", DebugDraw::GetDrawnCount());
+		const std::pair<const char*, DebugDraw::Category> categories[] = { { "General", DebugDraw::General }, { "Gizmos", DebugDraw::Gizmos }, { "Colliders", DebugDraw::Colliders } };
+		for (const auto& [name, category] : categories)
+		{
+			bool enabled = DebugDraw::IsEnabled(category);
+			if (ImGui::Checkbox(name, &enabled)) { DebugDraw::SetEnabled(category, enabled); }
+		}
+	}
+
+	// Export
+	ImGui::Separator();
+	if (ImGui::Button("Export CSV"))
+	{
+		if (RenderStats::ExportHistory(exportPath)) { editor->Log(std::string("Render stats written to ") + exportPath); }
+		else { editor->Log(std::string("Could not write ") + exportPath, Logger::LogType::Error); }
+	}
+	if (ImGui::IsItemHovered()) { ImGui::SetTooltip("Writes the last %d frames, one row per frame.", (int)history.size()); }
+	ImGui::SameLine();
+	bool capturing = RenderStats::IsCapturing();
+	if (ImGui::Checkbox("Capture every frame", &capturing))
+	{
+		if (!capturing) { RenderStats::StopCapture(); editor->Log(std::string("Render capture written to ") + capturePath); }
+		else if (!RenderStats::StartCapture(capturePath)) { editor->Log(std::string("Could not write ") + capturePath, Logger::LogType::Error); }
+	}
+
+	ImGui::End();
+}
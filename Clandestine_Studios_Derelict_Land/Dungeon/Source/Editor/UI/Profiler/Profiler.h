@@ -0,0 +1,63 @@
+/*!*************************************************************************
+\file	Profiler.h
+\author Warren Ang Jun Xuan
+\email: a.warrenjunxuan@digipen.edu
+\date	22-03-23
+\brief	Editor window showing the GPU time of each render pass and the work
+		done by the batch renderer, read from RenderStats.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*****************************************************************************/
+#pragma once
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "System/System.h"
+
+class Profiler : public System
+{
+public:
+	// Ctor & dtor
+	Profiler(bool nOpen = false);
+	~Profiler();
+
+	Profiler(const Profiler&) = delete;				// Copy Constructor
+	Profiler& operator=(const Profiler&) = delete;	// Copy Assignment Operator
+	Profiler(Profiler&&) = delete;					// Move Constructor
+	Profiler& operator=(Profiler&&) = delete;		// Move Assignment Operator
+
+	// Init, update and shut the Profiler window down.
+	virtual void Init();
+	virtual void Update(float dt);
+	virtual void Shutdown();
+
+	/**************************************************************************/
+	/*! \brief
+	*	Returns the open state of the Profiler window.
+	* \return
+	* 	True if the Profiler window is open, false otherwise.
+	*/
+	/**************************************************************************/
+	bool GetOpen() const;
+
+	/**************************************************************************/
+	/*! \brief Sets the open state of the Profiler window.
+	/**************************************************************************/
+	void SetOpen(const bool nOpen);
+
+	/**************************************************************************/
+	/*!
+	* \brief
+	*	Draws the pass timings, batch counters and export controls.
+	*/
+	/**************************************************************************/
+	void DrawProfiler();
+
+private:
+	bool open; // Profiler window open state
+	int plotPass; // Pass whose GPU time is plotted
+};
+
+#endif // !PROFILER_H
@@ -22,6 +22,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Audio/Audio.h"
 #include "CoreSys/Core.h"
 #include "Graphics/AssetManager.h"
+#include "Graphics/BatchRendering.h"
 
 // Speed at dragging the IMGUI sliders.
 constexpr const float DRAG_SPEED = 4.0f;
@@ -192,6 +193,8 @@ void PropertyEditor::DrawPropertyEditor()
 		else // Display the selected game object's data. (E.g. its name, id, position, scale, rotation, etc.)
 		{
 			DisplayGameObjectProperties(*selectedGameObject); DisplayGameObjectComponents(*selectedGameObject);
+			// An edited widget may have changed something baked into the static batches
+			if (ImGui::GetCurrentContext()->ActiveIdHasBeenEditedThisFrame) { Batch::InvalidateStatic(); }
 		}
 
 		ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal);
@@ -633,6 +636,7 @@ void PropertyEditor::DisplayGameObjectTransform(Transform& transform)
 			transform.Position = Vector2(0, 0);
 			transform.RotationAngle = transform.RotationSpeed = 0;
 			transform.Scale = Vector2(1, 1);
+			Batch::InvalidateStatic();
 		}
 
 		ImGui::EndPopup();
@@ -715,6 +719,12 @@ void PropertyEditor::DisplayGameObjectPhysics(RigidBody& pComp)
 	ImGui::DragFloat("Inverse Mass", (float*)&pComp.InverseMass, DRAG_SPEED, -FLT_MAX, FLT_MAX);
 	if (ImGui::IsItemHovered()) ImGui::SetTooltip("Higher mass affects the velocity of this GameObject.");
 
+	ImGui::DragFloat("Damping", &pComp.Damping, DRAG_SPEED, 0.0f, FLT_MAX);
+	if (ImGui::IsItemHovered()) ImGui::SetTooltip("How quickly the velocity of this GameObject slows down.");
+
+	ImGui::DragFloat("Gravity Scale", &pComp.GravityScale, DRAG_SPEED, -FLT_MAX, FLT_MAX);
+	if (ImGui::IsItemHovered()) ImGui::SetTooltip("Multiplier on gravity for this GameObject. 0 means no gravity.");
+
 	ImGui::Checkbox("Solid", &pComp.Solid);
 }
 
@@ -731,6 +741,26 @@ void PropertyEditor::DisplayGameObjectCollider(Collision& cComp)
 	if (&cComp != nullptr)
 	{
 		ImGui::Checkbox("Show Box", &cComp.showBox);
+
+		// Body type dropdown, static bodies only rebuild their bounds when edited
+		const char* bodyTypes[] = { "Static", "Kinematic", "Dynamic" };
+		if (ImGui::BeginCombo("Body Type", bodyTypes[static_cast<int>(cComp.Body)]))
+		{
+			for (int i = 0; i < IM_ARRAYSIZE(bodyTypes); ++i)
+			{
+				bool is_selected = (static_cast<int>(cComp.Body) == i);
+				if (ImGui::Selectable(bodyTypes[i], is_selected))
+				{
+					cComp.Body = static_cast<BodyType>(i);
+					cComp.MarkBoundsDirty();
+				}
+				if (is_selected)
+					ImGui::SetItemDefaultFocus();
+			}
+			ImGui::EndCombo();
+		}
+		if (ImGui::IsItemHovered()) ImGui::SetTooltip("Static colliders never move, Kinematic colliders are moved by scripts, Dynamic colliders sleep when at rest.");
+		if (cComp.isAsleep) ImGui::Text("Asleep");
 	}
 }
 
@@ -1350,9 +1380,15 @@ void PropertyEditor::DisplayTextureFile(const std::string_view spriteFilePath)
 
 	// (!!!) See Graphics.cpp for a list of files where the textures are sourced.
 
-	texID = this->GetLevel()->GetAssets()->GetTexture(filename.substr(0, filename.find_last_of('.'))).texid;
+	Assets::Sprite texture = this->GetLevel()->GetAssets()->GetTexture(filename.substr(0, filename.find_last_of('.')));
+	texID = texture.texid;
+	// Atlased textures share a page with other images, so the preview loads the file itself
+	if (texture.atlased)
+	{
+		texID = Texture::STBI_Load_Texture(textFileName.c_str(), false);
+	}
 	// If, for some reason, the texture cannot be found inside the texture map, it will be directly loaded from the file.
-	if (!texID)
+	else if (!texID)
 	{
 		texID = Texture::STBI_Load_Texture(textFileName.c_str(), false);
 		editor->Log("Texture not found in asset base, loading directly by STBI instead.", Logger::LogType::Warning);
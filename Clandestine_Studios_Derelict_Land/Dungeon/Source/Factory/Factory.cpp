@@ -216,7 +216,10 @@ GameObject* Factory::BuildAndSerialize(FILE* fp)
 			}
 			case ComponentType::Collision:
 			{
-				GameObj->AddComponent(ComponentType::Collision, new Collision);
+				Collision* c = new Collision;
+				GameObj->AddComponent(ComponentType::Collision, c);
+				c->Deserialize(fp);
+				std::cout << "Body Type: " << static_cast<int>(c->Body) << "\n";
 				break;
 			}
 			case ComponentType::Logic:
@@ -258,6 +261,8 @@ GameObject* Factory::BuildAndSerialize(FILE* fp)
 				Renderer* RDR = new Renderer;
 				GameObj->AddComponent(ComponentType::Renderer, RDR);
 				RDR->Deserialize(fp);
+				// The scene's textures are loaded ahead of use and kept while it references them
+				MasterObjectList->MasterAssets.AddReference(GameObj, RDR->TexHandle);
 				std::cout << "isVisible: " << RDR->isVisible << std::endl;
 				std::cout << "isSpritesheet: " << RDR->isSpritesheet << std::endl;
 				std::cout << "No. of Sprites: " << RDR->no_of_sprites << std::endl;
@@ -282,6 +287,7 @@ GameObject* Factory::BuildAndSerialize(FILE* fp)
 				Animate* Anim = new Animate;
 				GameObj->AddComponent(ComponentType::Animate, Anim);
 				Anim->Deserialize(fp);
+				MasterObjectList->MasterAssets.AddReference(GameObj, Anim->TexHandle);
 				std::cout << "isVisible: " << Anim->isVisible << std::endl;
 				std::cout << "isPlaying: " << Anim->isPlaying << std::endl;
 				std::cout << "Milliseconds Per Sprite: " << Anim->milliseconds_per_sprite << std::endl;
@@ -389,13 +395,14 @@ GameObject* Factory::AddGameObject(FILE* filename)
 /*!*************************************************************************
 ****
 \brief
-	To destroy game object
+	To destroy game object, dropping the texture references it holds
 \param[in] gameObject
 	Game object to destroy
 ****************************************************************************
 ***/
 void Factory::Destroy(GameObject* gameObject)
 {
+	MasterObjectList->MasterAssets.ReleaseReferences(gameObject);
 	gameObject->Destroy(); // Call GameObject class Destroy to destruct components
 	delete gameObject;
 }
@@ -19,6 +19,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "GameUI/GameUI.h"
 #include "Editor/UI/Editor.h"
 #include "CoreSys/Core.h"
+#include "Graphics/BatchRendering.h"
 
 std::vector<GameObject*> GameObject::GameObjectArray;
 std::map<unsigned int, std::string> GameObject::Tags;
@@ -154,12 +155,17 @@ bool& GameObject::GetActive() { return parent ? parent->GetActive() : active; }
 /******************************************************************************/
 /*!
 * \brief
-* Sets the active state of the GameObject.
+* Sets the active state of the GameObject. Inactive objects are not baked
+* into the static batches, so they are flagged for a rebake on a change.
 * \param isactive
 * The new active state to set.
 */
 /******************************************************************************/
-void GameObject::SetActive(const bool isactive) { this->active = isactive; }
+void GameObject::SetActive(const bool isactive)
+{
+	if (active != isactive) { Batch::InvalidateStatic(); }
+	this->active = isactive;
+}
 
 #pragma region Names
 
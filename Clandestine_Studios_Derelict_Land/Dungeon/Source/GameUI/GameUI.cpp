@@ -15,6 +15,7 @@
 
 #include "GameUI/GameUI.h"
 #include "Graphics/GLFWsetup.h"
+#include <cstdint>
 
 //extern MouseInput MyMouse;
 
@@ -37,6 +38,7 @@ GameUI::GameUI() :
 	Visibility{false},
 	depth{0.f},
 	Line_spacing{0},
+	VisibleChars{ SIZE_MAX },
 	func(nullptr)
 {
 	SetType(ComponentType::GameUI);
@@ -87,10 +89,37 @@ void GameUI::SetText(std::string text_param)
 */
 /**************************************************************************/
 
-std::string GameUI::GetText()
+const std::string& GameUI::GetText() const
 {
 	return this->Text;
 }
+
+/**************************************************************************/
+/*!
+	\brief
+		SetVisibleChars() shows only the first count characters of the text.
+		The layout is kept, so revealing text never lays it out again.
+	\param count
+		Number of characters shown
+*/
+/**************************************************************************/
+
+void GameUI::SetVisibleChars(size_t count)
+{
+	this->VisibleChars = count;
+}
+
+/**************************************************************************/
+/*!
+	\brief
+		ShowAllChars() shows all of the text again
+*/
+/**************************************************************************/
+
+void GameUI::ShowAllChars()
+{
+	this->VisibleChars = SIZE_MAX;
+}
 /**************************************************************************/
 	/*!
 	\brief
@@ -32,6 +32,30 @@ public:
 	bool Visibility;
 	float depth;
 	int Line_spacing;
+	size_t VisibleChars;	// characters of Text shown, for reveal effects like a typewriter
+
+	// One glyph of the laid out text
+	struct GlyphQuad
+	{
+		Vec2 center;		// from the text's origin, at the font size
+		Vec2 size;
+		Vec2 uv_start;
+		Vec2 uv_end;
+		size_t char_idx;	// index in Text, compared against VisibleChars
+	};
+	// Text laid out by FontsRender, rebuilt only when the text, font, size or
+	// line spacing it was built with changes
+	struct TextLayout
+	{
+		std::string text;
+		std::string font;
+		const void* font_map = nullptr;
+		float size = 0.f;
+		int line_spacing = 0;
+		unsigned int texid = 0;
+		std::vector<GlyphQuad> glyphs;
+	};
+	TextLayout Layout;
 	//std::string TextureFilepath;
 	//bool is_active;
 	void(*func)();
@@ -132,7 +156,24 @@ public:
 				The text data member in the GameUI Component
 		*/
 	/**************************************************************************/
-	std::string GetText();
+	const std::string& GetText() const;
+	/**************************************************************************/
+		/*!
+			\brief
+				This function shows only the first count characters of the 
+				text, without changing the text or its layout
+			\param count
+				Number of characters shown
+		*/
+	/**************************************************************************/
+	void SetVisibleChars(size_t count);
+	/**************************************************************************/
+		/*!
+			\brief
+				This function shows all of the text again
+		*/
+	/**************************************************************************/
+	void ShowAllChars();
 	/**************************************************************************/
 		/*!
 			\brief
@@ -13,6 +13,11 @@
  */
  /******************************************************************************/
 #include <Graphics/AssetManager.h>
+#include <Graphics/TextureLoader.h>
+#include <Graphics/RenderThread.h>
+#include <Graphics/BatchRendering.h>
+#include <algorithm>
+#include <cstring>
 
 Assets::Assets() {Texture::Init();}
 
@@ -21,7 +26,8 @@ Assets::~Assets() {}
 /**************************************************************************/
 	/*!
 	  \brief
-		Adds a texture with a string ID to be used for graphics.
+		Adds a texture with a string ID to be used for graphics. Only the
+		image header is read here.
 
 	  \param name
 		String ID of std::map.
@@ -34,11 +40,16 @@ Assets::~Assets() {}
 	*/
 	/**************************************************************************/
 void Assets::AddTexture(std::string name, char const* filename, bool isRepeated) {
-	int width{}, height{};
-	GLuint texid = Texture::STBI_Load_Texture_With_Size(filename, width, height, isRepeated);
+	// Repeated textures need their own wrap mode, so they never come from an atlas
+	AtlasEntry entry{};
+	Residency* page = isRepeated ? nullptr : FindAtlasEntry(filename, entry);
+	Residency* res = page ? page : FindResidency(filename, isRepeated);
 
-	Sprite s = Sprite(texid, std::vector<glm::vec2>(0), { width, height }, 1, 1);
+	Sprite s = page ? Sprite(0, std::vector<glm::vec2>(0), { entry.size.x, entry.size.y }, 1, 1, entry.uvmin, entry.uvmax, true)
+		: Sprite(0, std::vector<glm::vec2>(0), { res->width, res->height }, 1, 1);
+	Detach(texture_residency, name, texture.count(name) ? texture[name].get() : nullptr);
 	auto tex = std::make_unique<Sprite>(s);
+	Attach(texture_residency, name, *tex, res);
 	texture[name] = std::move(tex);
 }
 /**************************************************************************/
@@ -64,7 +75,12 @@ void Assets::AddTexture(std::string name, char const* filename, bool isRepeated)
 /**************************************************************************/
 void Assets::AddSpriteAnimation(std::string name, char const* filename, int frames_per_row, int frames_per_column, bool isRepeated) {
 	int width{}, height{};
-	GLuint texid = Texture::STBI_Load_Texture_With_Size(filename, width, height, isRepeated);
+	AtlasEntry entry{};
+	Residency* res = isRepeated ? nullptr : FindAtlasEntry(filename, entry);
+	bool atlased = res != nullptr;
+	if (atlased) { width = entry.size.x; height = entry.size.y; }
+	else { res = FindResidency(filename, isRepeated); width = res->width; height = res->height; }
+	if (!width || !height) { width = frames_per_row; height = frames_per_column; }
 
 	int width_of_frame = width/frames_per_row, height_of_frame = height/frames_per_column;
 
@@ -83,10 +99,47 @@ void Assets::AddSpriteAnimation(std::string name, char const* filename, int fram
 		TexX = 0.f;
 		TexY += height_in_texcoords;
 	}
+
+	// Frames of an atlased sheet are moved into the sheet's region of the page
+	if (atlased) {
+		glm::vec2 region = entry.uvmax - entry.uvmin;
+		for (glm::vec2& coord : TexCoords)
+			coord = entry.uvmin + coord * region;
+		TexSize *= region;
+	}
 	
-	auto spritedata = std::make_shared<Sprite>(Sprite(texid, TexCoords, TexSize, frames_per_row, frames_per_column, 0));
+	auto spritedata = std::make_shared<Sprite>(Sprite(0, TexCoords, TexSize, frames_per_row, frames_per_column,
+		atlased ? entry.uvmin : glm::vec2{ 0.f, 0.f }, atlased ? entry.uvmax : glm::vec2{ 1.f, 1.f }, atlased));
+	Detach(sprite_residency, name, sprite.count(name) ? sprite[name].get() : nullptr);
+	Attach(sprite_residency, name, *spritedata, res);
 	sprite[name] = std::move(spritedata);
 }
+/**************************************************************************/
+/*!
+  \brief
+	Adds a flipbook streamed from its cooked .flip. Only the frame table is
+	read, frames are read while the flipbook is drawn. A sprite sheet of
+	the same name keeps its frame counts for scripts, but its image is no
+	longer loaded.
+
+  \param name
+	String ID of std::map.
+
+  \param source
+	Directory of frame images or sprite sheet the .flip was cooked from.
+*/
+/**************************************************************************/
+void Assets::AddFlipbook(std::string name, char const* source) {
+	auto stream = std::make_unique<FlipbookStream>();
+	if (!stream->Open(FlipbookStream::Cooked_Path(source))) {
+		flipbook.erase(name);
+		return;
+	}
+	flipbook[name] = std::move(stream);
+	auto sheet = sprite.find(name);
+	if (sheet != sprite.end())
+		Detach(sprite_residency, name, sheet->second.get());
+}
 
 /**************************************************************************/
 /*!
@@ -203,51 +256,108 @@ void Assets::AddFont(std::string font_name, std::string ttf_filepath)
 		std::cout << "[Assets::AddFont] Freetype 2.12.1 " << font_name << " successfully loaded from " << ttf_filepath << std::endl;
 #endif
 
-		// set size to load glyphs as
-		FT_Set_Pixel_Sizes(face, 0, 48);
+		// Glyphs are rendered as signed distance fields, so one small atlas
+		// stays sharp at every text size. Outlines reach out to SDF_SPREAD
+		// pixels, and the sdf and bsdf renderers have to agree on it.
+		FT_Set_Pixel_Sizes(face, 0, SDF_GLYPH_SIZE);
+		FT_Int spread = SDF_SPREAD;
+		FT_Property_Set(FT, "sdf", "spread", &spread);
+		FT_Property_Set(FT, "bsdf", "spread", &spread);
+		// metrics are stored at FONT_BASE_SIZE, the size text scale is relative to
+		const float metric_scale = (float)FONT_BASE_SIZE / (float)SDF_GLYPH_SIZE;
 		// disable byte-alignment restriction
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction		
 
+		// Every glyph is packed into one atlas texture, so a whole string can
+		// be drawn from a single texture slot in the batch
+		const int AtlasWidth = 512;
+		const int Padding = 1;
+		std::vector<std::vector<unsigned char>> bitmaps;
+		std::vector<glm::ivec2> offsets;
+		std::vector<glm::ivec2> sizes;
+		int pen_x = Padding, pen_y = Padding, row_height = 0;
+
 		for (unsigned char c = 0; c < 128; c++)
 		{
 			// load character glyph 
-			if (FT_Load_Char(face, c, FT_LOAD_RENDER))
+			if (FT_Load_Char(face, c, FT_LOAD_DEFAULT))
 			{
 				std::cout << "ERROR::FREETYTPE: Failed to load Glyph for " << c << std::endl;
 				continue;
 			}
-			// generate texture
-			GLuint tex;
-			glGenTextures(1, &tex);
-			glBindTexture(GL_TEXTURE_2D, tex);
-			glTexImage2D(
-				GL_TEXTURE_2D,
-				0,
-				GL_RED,
-				face->glyph->bitmap.width,
-				face->glyph->bitmap.rows,
-				0,
-				GL_RED,
-				GL_UNSIGNED_BYTE,
-				face->glyph->bitmap.buffer
-			);
-			// set texture options
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			// now store character for later use
+			// glyphs the sdf renderer cannot handle keep their coverage, which
+			// the text shader still reads correctly at the 0.5 edge
+			if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF) && FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL))
+			{
+				std::cout << "ERROR::FREETYTPE: Failed to render Glyph for " << c << std::endl;
+				continue;
+			}
+			int w = (int)face->glyph->bitmap.width;
+			int h = (int)face->glyph->bitmap.rows;
+
+			// start a new shelf when the glyph does not fit on this one
+			if (pen_x + w + Padding > AtlasWidth) {
+				pen_x = Padding;
+				pen_y += row_height + Padding;
+				row_height = 0;
+			}
+
+			// keep a copy of the glyph, FreeType reuses its bitmap for the next one
+			std::vector<unsigned char> bitmap((size_t)w * h);
+			for (int row = 0; row < h; ++row)
+				memcpy(bitmap.data() + (size_t)row * w, face->glyph->bitmap.buffer + (ptrdiff_t)row * face->glyph->bitmap.pitch, w);
+			bitmaps.push_back(std::move(bitmap));
+			offsets.push_back({ pen_x, pen_y });
+			sizes.push_back({ w, h });
+
+			// now store character for later use, UVs are filled in once the atlas size is known
 			Character character =
 			{
-				tex,
-				glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-				glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-				static_cast<unsigned int>(face->glyph->advance.x)
+				0,
+				glm::vec2(w, h) * metric_scale,
+				glm::vec2(face->glyph->bitmap_left, face->glyph->bitmap_top) * metric_scale,
+				static_cast<unsigned int>(face->glyph->advance.x * metric_scale),
+				glm::vec2(0.f),
+				glm::vec2(0.f)
 			};
 			Characters_MAP.insert(std::pair<char, Character>(c, character));
+
+			pen_x += w + Padding;
+			row_height = h > row_height ? h : row_height;
+		}
+
+		int AtlasHeight = 1;
+		while (AtlasHeight < pen_y + row_height + Padding)
+			AtlasHeight <<= 1;
+
+		// generate the atlas texture
+		GLuint tex;
+		glGenTextures(1, &tex);
+		glBindTexture(GL_TEXTURE_2D, tex);
+		std::vector<unsigned char> clear((size_t)AtlasWidth * AtlasHeight, 0);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, AtlasWidth, AtlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, clear.data());
+
+		size_t i = 0;
+		for (auto& [c, character] : Characters_MAP)
+		{
+			glm::ivec2 offset = offsets[i];
+			if (sizes[i].x && sizes[i].y)
+				glTexSubImage2D(GL_TEXTURE_2D, 0, offset.x, offset.y, sizes[i].x, sizes[i].y, GL_RED, GL_UNSIGNED_BYTE, bitmaps[i].data());
+			character.TextureID = tex;
+			character.UVMin = glm::vec2(offset) / glm::vec2(AtlasWidth, AtlasHeight);
+			character.UVMax = glm::vec2(offset + sizes[i]) / glm::vec2(AtlasWidth, AtlasHeight);
+			++i;
 		}
+
+		// set texture options, distance is read as alpha of a white texel so
+		// the batch shader can sample glyphs like any other texture
+		const GLint swizzle[] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+		glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glBindTexture(GL_TEXTURE_2D, 0);
-		//glBindTexture(0, 0);
 
 
 
@@ -284,9 +394,488 @@ void Assets::AddAudio(FMOD::Sound* sound) {
 	audio.push_back(std::move(aud_ptr));
 }
 
+/**************************************************************************/
+/*!
+  \brief
+	Adds an atlas page written by the atlas cooker. The page is only
+	loaded once a texture or sprite on it is used.
+
+  \param filename
+	.tga file of the page.
+*/
+/**************************************************************************/
+void Assets::AddAtlasPage(std::string filename) {
+	atlas_pages.push_back(filename);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Adds a UV remap entry. Textures and sprites later added from filename
+	are drawn from the atlas page instead of their own texture.
+
+  \param filename
+	Source image the entry was cooked from.
+
+  \param entry
+	Page, UV region and pixel size of the image.
+*/
+/**************************************************************************/
+void Assets::AddAtlasEntry(std::string filename, const AtlasEntry& entry) {
+	if (entry.page >= atlas_pages.size() || entry.size.x <= 0 || entry.size.y <= 0) {
+		std::cout << "[Assets::AddAtlasEntry] Invalid atlas entry for " << filename << std::endl;
+		return;
+	}
+	atlas_entries[filename] = entry;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Looks up the atlas entry of an image and the residency of its page.
+
+  \param filename
+	Source image.
+
+  \param entry
+	Entry found.
+
+  \return
+	Residency of the page, nullptr if the image is not in an atlas.
+*/
+/**************************************************************************/
+Assets::Residency* Assets::FindAtlasEntry(const std::string& filename, AtlasEntry& entry) {
+	auto it = atlas_entries.find(filename);
+	if (it == atlas_entries.end())
+		return nullptr;
+
+	Residency* page = FindResidency(atlas_pages[it->second.page], false);
+	if (!page->width) {
+		// Page is missing, the image falls back to loading standalone
+		atlas_entries.erase(it);
+		return nullptr;
+	}
+
+	entry = it->second;
+	return page;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Gets the residency of an image, reading its header the first time.
+	Repeated and clamped uses of an image are separate textures.
+
+  \param filename
+	Source image.
+
+  \param isRepeated
+	Texture isRepeated flag.
+
+  \return
+	Residency of the image, never nullptr. An image that can not be read
+	has a size of 0 and is never loaded.
+*/
+/**************************************************************************/
+Assets::Residency* Assets::FindResidency(const std::string& filename, bool isRepeated) {
+	std::string key = isRepeated ? filename + "#repeat" : filename;
+	std::unique_ptr<Residency>& res = residency[key];
+	if (!res) {
+		res = std::make_unique<Residency>();
+		res->file = filename;
+		res->repeated = isRepeated;
+		if (!TextureLoader::ReadHeader(filename.c_str(), res->width, res->height, res->bytes))
+			std::cout << "Failed to load texture from " << filename << std::endl;
+	}
+	return res.get();
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Points a texture or sprite at a residency. Scene references made to the
+	name before it was added are counted now.
+
+  \param names
+	Residency of each texture or sprite name.
+
+  \param name
+	String ID of the texture or sprite.
+
+  \param user
+	Texture or sprite, its texid follows the residency.
+
+  \param res
+	Residency of its image.
+*/
+/**************************************************************************/
+void Assets::Attach(std::map<std::string, Residency*>& names, const std::string& name, Sprite& user, Residency* res) {
+	names[name] = res;
+	res->users.push_back(&user);
+	user.texid = res->texid ? res->texid : TextureLoader::GetPlaceholder();
+	user.opaque = res->opaque;
+	auto ref = references.find(name);
+	if (ref != references.end())
+		res->refs += ref->second;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Stops a texture or sprite from using its residency.
+
+  \param names
+	Residency of each texture or sprite name.
+
+  \param name
+	String ID of the texture or sprite.
+
+  \param user
+	Texture or sprite, nullptr if the name was not added.
+*/
+/**************************************************************************/
+void Assets::Detach(std::map<std::string, Residency*>& names, const std::string& name, Sprite* user) {
+	auto it = names.find(name);
+	if (it == names.end())
+		return;
+
+	Residency* res = it->second;
+	res->users.erase(std::remove(res->users.begin(), res->users.end(), user), res->users.end());
+	auto ref = references.find(name);
+	if (ref != references.end())
+		res->refs -= ref->second;
+	names.erase(it);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Counts a scene reference to a texture or sprite.
+
+  \param owner
+	Object holding the reference, usually the game object.
+
+  \param name
+	String ID of the texture or sprite.
+*/
+/**************************************************************************/
+void Assets::AddReference(const void* owner, const std::string& name) {
+	if (name.empty())
+		return;
+
+	++references[name];
+	reference_owners.emplace(owner, name);
+	auto tex = texture_residency.find(name);
+	if (tex != texture_residency.end()) ++tex->second->refs;
+	auto spr = sprite_residency.find(name);
+	if (spr != sprite_residency.end()) ++spr->second->refs;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Drops every reference an object holds. The images stay loaded until the
+	budget needs their memory.
+
+  \param owner
+	Object holding the references.
+*/
+/**************************************************************************/
+void Assets::ReleaseReferences(const void* owner) {
+	auto range = reference_owners.equal_range(owner);
+	for (auto it = range.first; it != range.second; ++it) {
+		const std::string& name = it->second;
+		auto ref = references.find(name);
+		if (ref != references.end() && --ref->second == 0)
+			references.erase(ref);
+		auto tex = texture_residency.find(name);
+		if (tex != texture_residency.end()) --tex->second->refs;
+		auto spr = sprite_residency.find(name);
+		if (spr != sprite_residency.end()) --spr->second->refs;
+	}
+	reference_owners.erase(range.first, range.second);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Marks the image of a texture as drawn by the static batches.
+
+  \param name
+	String ID of the texture.
+*/
+/**************************************************************************/
+void Assets::MarkBaked(const std::string& name) {
+	auto res = texture_residency.find(name);
+	if (res != texture_residency.end())
+		res->second->baked = true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Unmarks every image drawn by the static batches.
+*/
+/**************************************************************************/
+void Assets::ClearBaked() {
+	for (auto& [file, res] : residency)
+		res->baked = false;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Marks an image used this frame. An image not loaded is loaded through
+	TextureLoader on the OpenGL thread; its users show the placeholder
+	until the load command has run, which is right away when the render
+	thread is not running.
+
+  \param res
+	Residency of the image.
+*/
+/**************************************************************************/
+void Assets::Touch(Residency* res) {
+	res->last_used = frame;
+	if (res->texid || !res->width)
+		return;
+
+	if (!res->requested) {
+		res->requested = true;
+		res->tier = TierOf(res);
+		resident_bytes += TierBytes(res);
+		RenderThread::Submit([res, tier = res->tier] {
+			int width{}, height{};
+			res->uploaded = TextureLoader::Load(res->file.c_str(), width, height, res->repeated, tier, &res->uploaded_opaque);
+		});
+	}
+	if (GLuint texid = res->uploaded.load())
+		SetTexid(res, texid);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Deletes a loaded image on the OpenGL thread. Draws recorded before run
+	first, so only images not used this frame may be evicted.
+
+  \param res
+	Residency of the image.
+*/
+/**************************************************************************/
+void Assets::Evict(Residency* res) {
+	RenderThread::Submit([texid = res->texid] { TextureLoader::Unload(texid); });
+	res->uploaded = 0;
+	res->requested = false;
+	resident_bytes -= TierBytes(res);
+	SetTexid(res, 0);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Sets the texture of an image and of every texture and sprite using it.
+	The static batches hold the old texture, so they are rebaked if they
+	draw the image.
+
+  \param res
+	Residency of the image.
+
+  \param texid
+	Texture, 0 if the image is not loaded.
+*/
+/**************************************************************************/
+void Assets::SetTexid(Residency* res, GLuint texid) {
+	if (res->baked && res->texid != texid)
+		Batch::InvalidateStatic();
+	res->texid = texid;
+	for (Sprite* user : res->users)
+		user->texid = texid ? texid : TextureLoader::GetPlaceholder();
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Sets whether an image is opaque for every texture and sprite using it.
+	Opaque static quads are baked and the others are drawn with each pass,
+	so the static batches are rebaked if they draw the image.
+
+  \param res
+	Residency of the image.
+
+  \param opaque
+	True if every texel of the image is either solid or discarded.
+*/
+/**************************************************************************/
+void Assets::SetOpaque(Residency* res, bool opaque) {
+	if (res->opaque == opaque)
+		return;
+	if (res->baked)
+		Batch::InvalidateStatic();
+	res->opaque = opaque;
+	for (Sprite* user : res->users)
+		user->opaque = opaque;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Tier an image is loaded at. Small images save little and would blur, so
+	they are not halved below MinTierSize on their smaller side.
+
+  \param res
+	Residency of the image.
+
+  \return
+	Times the image is halved.
+*/
+/**************************************************************************/
+int Assets::TierOf(const Residency* res) const {
+	int smaller = res->width < res->height ? res->width : res->height;
+	int tier = 0;
+	while (tier < texture_tier && (smaller >> (tier + 1)) >= MinTierSize)
+		++tier;
+	return tier;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Video memory an image takes at the tier it was requested at, each tier
+	a quarter of the one above.
+
+  \param res
+	Residency of the image.
+*/
+/**************************************************************************/
+size_t Assets::TierBytes(const Residency* res) const {
+	return res->bytes >> (2 * res->tier);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Finishes loads, loads images referenced by the scene or baked into the
+	static batches, moves loaded images to the texture tier and evicts
+	unreferenced images not used last frame, least recently used first,
+	while over the budget.
+*/
+/**************************************************************************/
+void Assets::Update() {
+	++frame;
+	std::vector<Residency*> unused;
+	for (auto& [file, res] : residency) {
+		// Decoded again into the same texture, so users and static batches keep their texid
+		int tier = TierOf(res.get());
+		if (res->texid && res->tier != tier) {
+			resident_bytes -= TierBytes(res.get());
+			res->tier = tier;
+			resident_bytes += TierBytes(res.get());
+			RenderThread::Submit([res = res.get(), texid = res->texid, file = res->file, tier] { TextureLoader::Reload(texid, file.c_str(), tier, &res->uploaded_opaque); });
+		}
+		// Only known once the image is uploaded, some time after its texid
+		if (res->texid)
+			SetOpaque(res.get(), res->uploaded_opaque.load());
+
+		if (res->refs || res->baked)
+			Touch(res.get());
+		else if (res->requested && !res->texid)
+			Touch(res.get());	// still loading, keep it from being evicted before it is seen
+		else if (res->texid && res->last_used + 1 < frame)
+			unused.push_back(res.get());
+	}
+
+	if (resident_bytes <= texture_budget)
+		return;
+
+	std::sort(unused.begin(), unused.end(), [](const Residency* a, const Residency* b) { return a->last_used < b->last_used; });
+	for (Residency* res : unused) {
+		if (resident_bytes <= texture_budget)
+			break;
+		Evict(res);
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Sets the video memory textures may take before unreferenced ones are
+	evicted.
+
+  \param bytes
+	Budget in bytes.
+*/
+/**************************************************************************/
+void Assets::SetTextureBudget(size_t bytes) { texture_budget = bytes; }
+
+/**************************************************************************/
+/*!
+  \brief
+	Gets the texture budget in bytes.
+*/
+/**************************************************************************/
+size_t Assets::GetTextureBudget() const { return texture_budget; }
+
+/**************************************************************************/
+/*!
+  \brief
+	Gets the video memory taken by loaded and loading textures, in bytes.
+*/
+/**************************************************************************/
+size_t Assets::GetResidentBytes() const { return resident_bytes; }
+
+/**************************************************************************/
+/*!
+  \brief
+	Sets the output height images are authored for.
+
+  \param height
+	Authored height in pixels.
+*/
+/**************************************************************************/
+void Assets::SetAuthoredHeight(int height) {
+	authored_height = height > 0 ? height : authored_height;
+	if (output_height)
+		SetOutputSize(output_width, output_height);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Picks the texture tier for the size of the framebuffer. The output is
+	taken as the height of the 16:9 area covering it, and each halving of
+	the authored height drops a tier. Loaded images move to the new tier
+	in Update.
+
+  \param width
+	Framebuffer width.
+
+  \param height
+	Framebuffer height.
+*/
+/**************************************************************************/
+void Assets::SetOutputSize(int width, int height) {
+	output_width = width;
+	output_height = height;
+	int covered = width * 9 / 16 > height ? width * 9 / 16 : height;
+	int tier = 0;
+	while (tier < MaxTier && covered > 0 && covered * (2 << tier) <= authored_height)
+		++tier;
+	if (tier != texture_tier)
+		std::cout << "Texture tier " << tier << " for " << width << "x" << height << " output\n";
+	texture_tier = tier;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Gets the texture tier: 0 full, 1 half, 2 quarter.
+*/
+/**************************************************************************/
+int Assets::GetTextureTier() const { return texture_tier; }
+
 void Assets::RemoveTexture(std::string name)
 {
-	if (GetTexture(name).texid != 0) { texture.erase(name); }
+	if (texture.count(name)) { Detach(texture_residency, name, texture[name].get()); texture.erase(name); }
 	else { std::cout << "[Assets::RemoveTexture] Texture of ID " << name << " cannot be found." << std::endl; }
 }
 
@@ -312,6 +901,9 @@ Assets::Sprite Assets::GetTexture(std::string name) {
 		return nothing;
 	}		
 
+	auto res = texture_residency.find(name);
+	if (res != texture_residency.end())
+		Touch(res->second);
 	return *(texture.at(name).get());
 }
 
@@ -362,7 +954,10 @@ const std::map<char, Character>& Assets::GetFont(std::string font_name) const
 
 */
 /**************************************************************************/
-Assets::Sprite& Assets::GetSprite(std::string name) {
+const Assets::Sprite& Assets::GetSprite(std::string name) {
+	auto res = sprite_residency.find(name);
+	if (res != sprite_residency.end())
+		Touch(res->second);
 	return *(sprite.at(name).get());
 }
 /**************************************************************************/
@@ -375,6 +970,27 @@ std::map<std::string, std::shared_ptr<Assets::Sprite>> Assets::GetSpriteContaine
 	return sprite;
 }
 /**************************************************************************/
+/*!
+  \brief
+	returns the sprites used for animation without copying the container
+*/
+/**************************************************************************/
+const std::map<std::string, std::shared_ptr<Assets::Sprite>>& Assets::GetSpriteMap() const { return sprite; }
+/**************************************************************************/
+/*!
+  \brief
+	returns the flipbook streamed for animation, nullptr if there is none
+	with the name.
+
+  \param name
+	the key to find the flipbook in the map
+*/
+/**************************************************************************/
+FlipbookStream* Assets::GetFlipbook(const std::string& name) const {
+	auto it = flipbook.find(name);
+	return it != flipbook.end() ? it->second.get() : nullptr;
+}
+/**************************************************************************/
 /*!
   \brief
 	Retrieve audio previously loaded .
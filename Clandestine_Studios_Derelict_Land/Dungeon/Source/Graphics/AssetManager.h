@@ -6,6 +6,10 @@
 \date    November 2, 2022
 \brief   A class to hold all textures, fonts, shaders to be used in graphics, as
 		 well as audio files to be used in-game.
+		 Textures and sprites are only registered when added. Their images
+		 are loaded when first used or when a scene references them, and
+		 images no scene references are evicted least recently used first
+		 once the texture budget is exceeded.
 
 		Copyright (C) 2022 DigiPen Institute of Technology.
 		Reproduction or disclosure of this file or its contents without the
@@ -14,11 +18,15 @@
  /******************************************************************************/
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include <Graphics/Texture.h>
+#include <Graphics/FlipbookStream.h>
 #include <Graphics/glslshader.h>
 #include <Graphics/Fonts.h>
 #include "fmod.hpp"
@@ -30,7 +38,18 @@ public:
 		GLuint texid;
 		std::vector<glm::vec2> texcoords;
 		glm::vec2 texsize;
-		int frames_per_row, frames_per_column, idx;
+		int frames_per_row, frames_per_column;
+		// Region of texid covered by the image, only differs from 0-1 if the image was cooked into an atlas page
+		glm::vec2 uvmin{ 0.f, 0.f }, uvmax{ 1.f, 1.f };
+		bool atlased{ false };
+		bool opaque{ false };	// image has no blended texels, so static quads using it are baked
+	};
+
+	struct AtlasEntry
+	{
+		size_t page;
+		glm::vec2 uvmin, uvmax;
+		glm::ivec2 size;
 	};
 
 	Assets();
@@ -39,7 +58,9 @@ public:
 	/**************************************************************************/
 	/*!
 	  \brief
-		Adds a texture with a string ID to be used for graphics.
+		Adds a texture with a string ID to be used for graphics. Only the
+		image header is read, the image is loaded once the texture is used or
+		referenced and shows the placeholder until TextureLoader uploads it.
 
 	  \param name
 		String ID of std::map.
@@ -75,6 +96,22 @@ public:
 	/**************************************************************************/
 	void AddSpriteAnimation(std::string name, char const* filename, int frames_per_row, int frames_per_column = 1, bool isRepeated = false);
 	/**************************************************************************/
+	/*!
+	  \brief
+		Adds a flipbook streamed from its cooked .flip. Animate components
+		with the name draw it instead of a sprite sheet of the same name. If
+		the source was not cooked the flipbook is left out, and the sprite
+		sheet, if any, is drawn as before.
+
+	  \param name
+		String ID of std::map.
+
+	  \param source
+		Directory of frame images or sprite sheet the .flip was cooked from.
+	*/
+	/**************************************************************************/
+	void AddFlipbook(std::string name, char const* source);
+	/**************************************************************************/
 	/*!
 	  \brief
 		Adds a shader through a string to be used in graphics.
@@ -129,6 +166,147 @@ public:
 	*/
 	/**************************************************************************/
 	void AddAudio(FMOD::Sound* sound);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Adds an atlas page written by the atlas cooker. The page is only
+		loaded once a texture or sprite on it is used.
+
+	  \param filename
+		.tga file of the page.
+	*/
+	/**************************************************************************/
+	void AddAtlasPage(std::string filename);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Adds a UV remap entry. Textures and sprites later added from filename
+		are drawn from the atlas page instead of their own texture.
+
+	  \param filename
+		Source image the entry was cooked from.
+
+	  \param entry
+		Page, UV region and pixel size of the image.
+	*/
+	/**************************************************************************/
+	void AddAtlasEntry(std::string filename, const AtlasEntry& entry);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Counts a scene reference to a texture or sprite, so its image is
+		loaded ahead of use and never evicted. Handles do not need to be
+		added yet.
+
+	  \param owner
+		Object holding the reference, usually the game object.
+
+	  \param name
+		String ID of the texture or sprite.
+	*/
+	/**************************************************************************/
+	void AddReference(const void* owner, const std::string& name);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Drops every reference an object holds.
+
+	  \param owner
+		Object holding the references.
+	*/
+	/**************************************************************************/
+	void ReleaseReferences(const void* owner);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Marks the image of a texture as drawn by the static batches. It is
+		kept loaded like a referenced one, and the batches are rebaked if its
+		texture changes.
+
+	  \param name
+		String ID of the texture.
+	*/
+	/**************************************************************************/
+	void MarkBaked(const std::string& name);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Unmarks every image marked with MarkBaked, before a rebake.
+	*/
+	/**************************************************************************/
+	void ClearBaked();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Finishes loads, loads images referenced by the scene and evicts
+		unreferenced images not used last frame, least recently used first,
+		while over the budget. Call once per frame from the thread updating
+		the game, before anything is drawn.
+	*/
+	/**************************************************************************/
+	void Update();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Sets the video memory textures may take before unreferenced ones are
+		evicted. Referenced textures stay loaded even over the budget.
+
+	  \param bytes
+		Budget in bytes.
+	*/
+	/**************************************************************************/
+	void SetTextureBudget(size_t bytes);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the texture budget in bytes.
+	*/
+	/**************************************************************************/
+	size_t GetTextureBudget() const;
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the video memory taken by loaded and loading textures, in bytes.
+	*/
+	/**************************************************************************/
+	size_t GetResidentBytes() const;
+	/**************************************************************************/
+	/*!
+	  \brief
+		Sets the output height images are authored for, 2160 by default.
+		Outputs half that height or less get half size textures, and a
+		quarter or less get quarter size ones.
+
+	  \param height
+		Authored height in pixels.
+	*/
+	/**************************************************************************/
+	void SetAuthoredHeight(int height);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Picks the texture tier for the size of the framebuffer drawn into.
+		Loaded textures are decoded again at the new tier over the next
+		frames, keeping their current image until then. Call whenever the
+		framebuffer is made.
+
+	  \param width
+		Framebuffer width, outputs wider than 16:9 are matched by width.
+
+	  \param height
+		Framebuffer height.
+	*/
+	/**************************************************************************/
+	void SetOutputSize(int width, int height);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the texture tier, the times textures are halved from their
+		authored size: 0 full, 1 half, 2 quarter.
+	*/
+	/**************************************************************************/
+	int GetTextureTier() const;
 
 	/**************************************************************************/
 	/*!
@@ -195,14 +373,15 @@ public:
 	/**************************************************************************/
 	/*!
 	  \brief
-		returns the sprites used for animation
+		returns the sprites used for animation. Sheets are shared, the frame
+		an object shows is kept on its Animate.
 
 	  \param name
 		the key to find the specific sprite set in the map
 
 	*/
 	/**************************************************************************/
-	Sprite& GetSprite(std::string name);
+	const Sprite& GetSprite(std::string name);
 	/**************************************************************************/
 	/*!
 	  \brief
@@ -211,6 +390,24 @@ public:
 	/**************************************************************************/
 	std::map<std::string, std::shared_ptr<Sprite>> GetSpriteContainer();
 	/**************************************************************************/
+	/*!
+	  \brief
+		returns the sprites used for animation without copying the container
+	*/
+	/**************************************************************************/
+	const std::map<std::string, std::shared_ptr<Sprite>>& GetSpriteMap() const;
+	/**************************************************************************/
+	/*!
+	  \brief
+		returns the flipbook streamed for animation, nullptr if there is none
+		with the name.
+
+	  \param name
+		the key to find the flipbook in the map
+	*/
+	/**************************************************************************/
+	FlipbookStream* GetFlipbook(const std::string& name) const;
+	/**************************************************************************/
 	/*!
 	  \brief
 		Retrieve audio previously loaded.
@@ -242,9 +439,132 @@ public:
 	bool IsInitialized();
 
 private:
+	/**************************************************************************/
+	/*!
+	  \brief
+		One OpenGL texture, a standalone image or an atlas page, shared by
+		every texture and sprite drawn from it.
+	*/
+	/**************************************************************************/
+	struct Residency
+	{
+		std::string file;
+		bool repeated{ false };
+		int width{}, height{};
+		size_t bytes{};					// video memory once loaded at full size
+		int tier{};						// tier it was requested at
+		GLuint texid{};					// 0 while not loaded
+		std::atomic<GLuint> uploaded{};	// set by the load command, on the OpenGL thread
+		std::atomic<bool> uploaded_opaque{};	// set by TextureLoader once the image is uploaded
+		bool opaque{ false };			// what the users were told
+		bool requested{ false };
+		uint64_t last_used{};			// frame
+		size_t refs{};					// scene references to textures and sprites on it
+		bool baked{ false };			// drawn by the static batches
+		std::vector<Sprite*> users;		// patched when texid changes
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Looks up the atlas entry of an image and the residency of its page.
+
+	  \param filename
+		Source image.
+
+	  \param entry
+		Entry found.
+
+	  \return
+		Residency of the page, nullptr if the image is not in an atlas.
+	*/
+	/**************************************************************************/
+	Residency* FindAtlasEntry(const std::string& filename, AtlasEntry& entry);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the residency of an image, reading its header the first time.
+	*/
+	/**************************************************************************/
+	Residency* FindResidency(const std::string& filename, bool isRepeated);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Points a texture or sprite at a residency, replacing what it used.
+	*/
+	/**************************************************************************/
+	void Attach(std::map<std::string, Residency*>& names, const std::string& name, Sprite& user, Residency* res);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Stops a texture or sprite from using its residency.
+	*/
+	/**************************************************************************/
+	void Detach(std::map<std::string, Residency*>& names, const std::string& name, Sprite* user);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Marks an image used this frame and loads it if needed.
+	*/
+	/**************************************************************************/
+	void Touch(Residency* res);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Deletes a loaded image, its users show the placeholder.
+	*/
+	/**************************************************************************/
+	void Evict(Residency* res);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Sets the texture of an image and of every user.
+	*/
+	/**************************************************************************/
+	void SetTexid(Residency* res, GLuint texid);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Sets whether an image is opaque for every user.
+	*/
+	/**************************************************************************/
+	void SetOpaque(Residency* res, bool opaque);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Tier an image is loaded at, lower than the texture tier for images
+		that would end up smaller than MinTierSize.
+	*/
+	/**************************************************************************/
+	int TierOf(const Residency* res) const;
+	/**************************************************************************/
+	/*!
+	  \brief
+		Video memory an image takes at the tier it was requested at.
+	*/
+	/**************************************************************************/
+	size_t TierBytes(const Residency* res) const;
+
 	std::map<std::string, std::unique_ptr<Sprite>> texture;
 	std::map<std::string, std::unique_ptr<GLSLShader>> shader;
 	std::map <std::string, std::unique_ptr<std::map<char, Character>>> fonts_map;
 	std::map<std::string, std::shared_ptr<Sprite>> sprite;
+	std::map<std::string, std::unique_ptr<FlipbookStream>> flipbook;
 	std::vector<std::unique_ptr<FMOD::Sound*>> audio;
+	std::map<std::string, AtlasEntry> atlas_entries;
+	std::vector<std::string> atlas_pages;
+
+	std::map<std::string, std::unique_ptr<Residency>> residency;	// by file
+	std::map<std::string, Residency*> texture_residency;			// by texture name
+	std::map<std::string, Residency*> sprite_residency;				// by sprite name
+	std::map<std::string, size_t> references;						// scene references by name
+	std::multimap<const void*, std::string> reference_owners;
+	size_t texture_budget{ 512ull << 20 };
+	size_t resident_bytes{};
+	uint64_t frame{};
+	int authored_height{ 2160 };
+	int output_width{}, output_height{};
+	int texture_tier{};
+	static constexpr int MaxTier{ 2 };
+	static constexpr int MinTierSize{ 64 };			// pixels, the smaller side is not halved below this
 };
\ No newline at end of file
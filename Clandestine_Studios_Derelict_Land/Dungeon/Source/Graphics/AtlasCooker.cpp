@@ -0,0 +1,380 @@
+/******************************************************************************/
+/*!
+\file    AtlasCooker.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Offline texture atlas cooker. Small and medium images listed in the
+		 texture manifests are packed into large pages (MaxRects, padding and
+		 edge extrusion) and a UV remap table is written for Assets.
+		 Run the game with --cook-atlases.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/AtlasCooker.h>
+#include <CoreSys/CommandLine.h>
+#include "../3rdParty/stb_image.h"
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+namespace {
+	struct Candidate {
+		std::string path;
+		int w, h;
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Writes an uncompressed 32-bit TGA with top-left origin. stb_image reads
+		it back the same way it reads a .png, so pages flip like any texture.
+	*/
+	/**************************************************************************/
+	bool WriteTGA(const std::string& filename, int w, int h, const std::vector<unsigned char>& rgba) {
+		FILE* fp = fopen(filename.c_str(), "wb");
+		if (!fp) return false;
+
+		unsigned char header[18]{};
+		header[2] = 2;		// uncompressed true color
+		header[12] = static_cast<unsigned char>(w & 0xff);
+		header[13] = static_cast<unsigned char>((w >> 8) & 0xff);
+		header[14] = static_cast<unsigned char>(h & 0xff);
+		header[15] = static_cast<unsigned char>((h >> 8) & 0xff);
+		header[16] = 32;
+		header[17] = 0x28;	// 8 alpha bits, top-left origin
+		fwrite(header, 1, sizeof(header), fp);
+
+		std::vector<unsigned char> row(static_cast<size_t>(w) * 4);
+		for (int y = 0; y < h; ++y) {
+			const unsigned char* src = &rgba[static_cast<size_t>(y) * w * 4];
+			for (int x = 0; x < w; ++x) {
+				row[x * 4 + 0] = src[x * 4 + 2];
+				row[x * 4 + 1] = src[x * 4 + 1];
+				row[x * 4 + 2] = src[x * 4 + 0];
+				row[x * 4 + 3] = src[x * 4 + 3];
+			}
+			fwrite(row.data(), 1, row.size(), fp);
+		}
+		fclose(fp);
+		return true;
+	}
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Copies an image into a page at (x, y) and repeats its edge pixels
+		extrude pixels outwards so linear filtering never samples a neighbour.
+	*/
+	/**************************************************************************/
+	void Blit(std::vector<unsigned char>& page, int page_w, int page_h, const unsigned char* img, int w, int h, int x, int y, int extrude) {
+		for (int py = y - extrude; py < y + h + extrude; ++py) {
+			if (py < 0 || py >= page_h) continue;
+			int sy = py - y;
+			sy = sy < 0 ? 0 : (sy >= h ? h - 1 : sy);
+			for (int px = x - extrude; px < x + w + extrude; ++px) {
+				if (px < 0 || px >= page_w) continue;
+				int sx = px - x;
+				sx = sx < 0 ? 0 : (sx >= w ? w - 1 : sx);
+				const unsigned char* src = &img[(static_cast<size_t>(sy) * w + sx) * 4];
+				unsigned char* dst = &page[(static_cast<size_t>(py) * page_w + px) * 4];
+				dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3];
+			}
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Creates an empty bin.
+
+  \param width
+	Width of bin.
+
+  \param height
+	Height of bin.
+*/
+/**************************************************************************/
+AtlasCooker::MaxRectsBin::MaxRectsBin(int width, int height) : free_rects{ { 0, 0, width, height } }, used_width{}, used_height{} {}
+
+/**************************************************************************/
+/*!
+  \brief
+	Places a rectangle in the free rectangle that leaves the shortest
+	leftover side, ties broken by the longest leftover side.
+
+  \param w
+	Width of rectangle.
+
+  \param h
+	Height of rectangle.
+
+  \param out
+	Where the rectangle was placed.
+
+  \return
+	False if the rectangle does not fit.
+*/
+/**************************************************************************/
+bool AtlasCooker::MaxRectsBin::Insert(int w, int h, Rect& out) {
+	int best_short = INT_MAX, best_long = INT_MAX;
+	bool found = false;
+	for (const Rect& fr : free_rects) {
+		if (w > fr.w || h > fr.h) continue;
+		int left_w = fr.w - w, left_h = fr.h - h;
+		int short_side = left_w < left_h ? left_w : left_h;
+		int long_side = left_w < left_h ? left_h : left_w;
+		if (short_side < best_short || (short_side == best_short && long_side < best_long)) {
+			out = { fr.x, fr.y, w, h };
+			best_short = short_side;
+			best_long = long_side;
+			found = true;
+		}
+	}
+	if (!found) return false;
+
+	SplitFreeRects(out);
+	PruneFreeRects();
+	used_width = out.x + out.w > used_width ? out.x + out.w : used_width;
+	used_height = out.y + out.h > used_height ? out.y + out.h : used_height;
+	return true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Width and height actually covered by placed rectangles.
+*/
+/**************************************************************************/
+int AtlasCooker::MaxRectsBin::UsedWidth() const { return used_width; }
+int AtlasCooker::MaxRectsBin::UsedHeight() const { return used_height; }
+
+/**************************************************************************/
+/*!
+  \brief
+	Replaces every free rectangle overlapping used with the (up to four)
+	maximal free rectangles around it.
+*/
+/**************************************************************************/
+void AtlasCooker::MaxRectsBin::SplitFreeRects(const Rect& used) {
+	std::vector<Rect> result;
+	for (const Rect& fr : free_rects) {
+		if (used.x >= fr.x + fr.w || used.x + used.w <= fr.x || used.y >= fr.y + fr.h || used.y + used.h <= fr.y) {
+			result.push_back(fr);
+			continue;
+		}
+		if (used.x > fr.x) result.push_back({ fr.x, fr.y, used.x - fr.x, fr.h });
+		if (used.x + used.w < fr.x + fr.w) result.push_back({ used.x + used.w, fr.y, fr.x + fr.w - (used.x + used.w), fr.h });
+		if (used.y > fr.y) result.push_back({ fr.x, fr.y, fr.w, used.y - fr.y });
+		if (used.y + used.h < fr.y + fr.h) result.push_back({ fr.x, used.y + used.h, fr.w, fr.y + fr.h - (used.y + used.h) });
+	}
+	free_rects = std::move(result);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Removes free rectangles fully contained in another free rectangle.
+*/
+/**************************************************************************/
+void AtlasCooker::MaxRectsBin::PruneFreeRects() {
+	auto contains = [](const Rect& a, const Rect& b) {
+		return b.x >= a.x && b.y >= a.y && b.x + b.w <= a.x + a.w && b.y + b.h <= a.y + a.h;
+	};
+	for (size_t i = 0; i < free_rects.size(); ++i) {
+		for (size_t j = i + 1; j < free_rects.size(); ++j) {
+			if (contains(free_rects[j], free_rects[i])) {
+				free_rects.erase(free_rects.begin() + i);
+				--i;
+				break;
+			}
+			if (contains(free_rects[i], free_rects[j])) {
+				free_rects.erase(free_rects.begin() + j);
+				--j;
+			}
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Reads cooker settings from the command line.
+
+  \param argc
+	Number of arguments.
+
+  \param argv
+	Arguments.
+
+  \param settings
+	Settings to fill in.
+
+  \return
+	True if all arguments were valid.
+*/
+/**************************************************************************/
+bool AtlasCooker::ParseArguments(int argc, char** argv, Settings& settings) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--cook-atlases") continue;
+		std::string value;
+		if (!CommandLine::NextArgument(argc, argv, i, value)) return false;
+
+		if (arg == "--page-size") settings.PageSize = std::atoi(value.c_str());
+		else if (arg == "--max-image") settings.MaxImageSize = std::atoi(value.c_str());
+		else if (arg == "--max-area") settings.MaxImageArea = std::atoi(value.c_str());
+		else if (arg == "--padding") settings.Padding = std::atoi(value.c_str());
+		else if (arg == "--extrude") settings.Extrude = std::atoi(value.c_str());
+		else if (arg == "--out-dir") settings.OutputDir = value;
+		else if (arg == "--table") settings.Table = value;
+		else { std::cout << "Unknown argument " << arg << "\n"; return false; }
+	}
+
+	if (settings.PageSize <= 0 || settings.PageSize > 16384 || settings.MaxImageSize <= 0 || settings.MaxImageArea <= 0 || settings.Padding < 0 || settings.Extrude < 0
+		|| settings.MaxImageSize + 2 * settings.Extrude + settings.Padding > settings.PageSize) {
+		std::cout << "Invalid atlas settings\n";
+		return false;
+	}
+	return true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Packs every eligible image, writes the pages and the remap table.
+	Every image listed in the manifests is a candidate; images larger than
+	MaxImageSize or full-screen sized (backgrounds, cutscenes, long
+	animation strips) are left out of the table and keep loading standalone.
+
+  \param settings
+	Cooker settings.
+
+  \return
+	True if the pages and table were written.
+*/
+/**************************************************************************/
+bool AtlasCooker::Cook(const Settings& settings) {
+	// Collect every unique image path from the manifests, the path is always the second column
+	std::vector<std::string> paths;
+	std::set<std::string> seen;
+	for (const std::string& manifest : settings.Manifests) {
+		std::ifstream inFile(manifest);
+		if (!inFile.is_open()) { std::cout << "[AtlasCooker] Skipping missing manifest " << manifest << "\n"; continue; }
+		std::string line;
+		while (std::getline(inFile, line)) {
+			std::stringstream ss(line);
+			std::string id, path;
+			if (ss >> id >> path && seen.insert(path).second) paths.push_back(path);
+		}
+	}
+
+	stbi_set_flip_vertically_on_load(0);
+
+	std::vector<Candidate> candidates;
+	for (const std::string& path : paths) {
+		int w{}, h{}, channels{};
+		if (!stbi_info(path.c_str(), &w, &h, &channels)) { std::cout << "[AtlasCooker] Cannot read " << path << "\n"; continue; }
+		if (w > settings.MaxImageSize || h > settings.MaxImageSize || w * h >= settings.MaxImageArea) { std::cout << "[AtlasCooker] Standalone " << path << " (" << w << "x" << h << ")\n"; continue; }
+		candidates.push_back({ path, w, h });
+	}
+
+	// Largest first packs tighter
+	std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+		int a_max = a.w > a.h ? a.w : a.h, b_max = b.w > b.h ? b.w : b.h;
+		return a_max != b_max ? a_max > b_max : a.h > b.h;
+	});
+
+	const int border = settings.Extrude * 2 + settings.Padding;
+	std::vector<MaxRectsBin> bins;
+	std::vector<Placement> placements;
+	for (const Candidate& c : candidates) {
+		Rect r{};
+		int page = -1;
+		for (size_t i = 0; i < bins.size(); ++i) {
+			if (bins[i].Insert(c.w + border, c.h + border, r)) { page = static_cast<int>(i); break; }
+		}
+		if (page < 0) {
+			bins.emplace_back(settings.PageSize, settings.PageSize);
+			bins.back().Insert(c.w + border, c.h + border, r);
+			page = static_cast<int>(bins.size()) - 1;
+		}
+		// Image sits inside its extrusion border, padding is left empty on the right/bottom
+		placements.push_back({ c.path, page, { r.x + settings.Extrude, r.y + settings.Extrude, c.w, c.h } });
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(settings.OutputDir, ec);
+
+	std::ofstream table(settings.Table);
+	if (!table.is_open()) { std::cout << "[AtlasCooker] Could not open " << settings.Table << "\n"; return false; }
+	table.precision(8);
+
+	// Pages are trimmed to what is used so the last page is not mostly empty
+	for (size_t p = 0; p < bins.size(); ++p) {
+		int page_w = bins[p].UsedWidth(), page_h = bins[p].UsedHeight();
+		std::vector<unsigned char> pixels(static_cast<size_t>(page_w) * page_h * 4, 0);
+
+		for (const Placement& pl : placements) {
+			if (pl.page != static_cast<int>(p)) continue;
+			int w{}, h{}, channels{};
+			unsigned char* data = stbi_load(pl.path.c_str(), &w, &h, &channels, 4);
+			if (!data) { std::cout << "[AtlasCooker] Failed to load " << pl.path << "\n"; continue; }
+			Blit(pixels, page_w, page_h, data, w, h, pl.rect.x, pl.rect.y, settings.Extrude);
+			stbi_image_free(data);
+		}
+
+		std::string page_file = settings.OutputDir + "/Atlas" + std::to_string(p) + ".tga";
+		if (!WriteTGA(page_file, page_w, page_h, pixels)) { std::cout << "[AtlasCooker] Could not write " << page_file << "\n"; return false; }
+		table << "Page " << page_file << "\n";
+		std::cout << "[AtlasCooker] " << page_file << " " << page_w << "x" << page_h << "\n";
+
+		// Pages load flipped like every other texture, so v is measured from the bottom
+		for (const Placement& pl : placements) {
+			if (pl.page != static_cast<int>(p)) continue;
+			float u0 = static_cast<float>(pl.rect.x) / page_w;
+			float u1 = static_cast<float>(pl.rect.x + pl.rect.w) / page_w;
+			float v0 = static_cast<float>(page_h - (pl.rect.y + pl.rect.h)) / page_h;
+			float v1 = static_cast<float>(page_h - pl.rect.y) / page_h;
+			table << "Image " << pl.path << " " << p << " " << u0 << " " << v0 << " " << u1 << " " << v1
+				<< " " << pl.rect.w << " " << pl.rect.h << "\n";
+		}
+	}
+
+	stbi_set_flip_vertically_on_load(1);
+	std::cout << "[AtlasCooker] Packed " << placements.size() << " of " << paths.size() << " images into " << bins.size() << " pages\n";
+	return true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Runs the cooker from the command line.
+
+  \param argc
+	Number of arguments.
+
+  \param argv
+	Arguments.
+
+  \return
+	0 on success.
+*/
+/**************************************************************************/
+int AtlasCooker::Run(int argc, char** argv) {
+	Settings settings;
+	if (!ParseArguments(argc, argv, settings)) {
+		std::cout << "Usage: --cook-atlases [--page-size 4096] [--max-image 2048] [--max-area 2073600] [--padding 2] [--extrude 2] "
+			"[--out-dir ./Images/Atlas] [--table ./Data/TextureAtlas.txt]\n";
+		return 1;
+	}
+	return Cook(settings) ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/******************************************************************************/
+/*!
+\file    AtlasCooker.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Offline texture atlas cooker. Small and medium images listed in the
+		 texture manifests are packed into large pages (MaxRects, padding and
+		 edge extrusion) and a UV remap table is written for Assets.
+		 Run the game with --cook-atlases.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace AtlasCooker {
+	/**************************************************************************/
+	/*!
+	  \brief
+		Cooker settings, all can be changed from the command line.
+	*/
+	/**************************************************************************/
+	struct Settings {
+		int PageSize{ 4096 };								// --page-size, max width/height of a page
+		int MaxImageSize{ 2048 };							// --max-image, wider/taller images stay standalone
+		int MaxImageArea{ 1920 * 1080 };					// --max-area, full-screen images and bigger stay standalone
+		int Padding{ 2 };									// --padding, empty pixels between images
+		int Extrude{ 2 };									// --extrude, edge pixels repeated around images
+		std::string OutputDir{ "./Images/Atlas" };			// --out-dir
+		std::string Table{ "./Data/TextureAtlas.txt" };		// --table
+		std::vector<std::string> Manifests{ "./Data/SpriteSheets.txt", "./Data/Textures.txt", "./Data/SpriteAnimations.txt" };
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Pixel rectangle, top-left origin.
+	*/
+	/**************************************************************************/
+	struct Rect {
+		int x, y, w, h;
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Image packed into a page.
+	*/
+	/**************************************************************************/
+	struct Placement {
+		std::string path;
+		int page;
+		Rect rect;
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		MaxRects bin packer (best short side fit, no rotation).
+	*/
+	/**************************************************************************/
+	class MaxRectsBin {
+	public:
+		/**************************************************************************/
+		/*!
+		  \brief
+			Creates an empty bin.
+
+		  \param width
+			Width of bin.
+
+		  \param height
+			Height of bin.
+		*/
+		/**************************************************************************/
+		MaxRectsBin(int width, int height);
+		/**************************************************************************/
+		/*!
+		  \brief
+			Places a rectangle in the bin.
+
+		  \param w
+			Width of rectangle.
+
+		  \param h
+			Height of rectangle.
+
+		  \param out
+			Where the rectangle was placed.
+
+		  \return
+			False if the rectangle does not fit.
+		*/
+		/**************************************************************************/
+		bool Insert(int w, int h, Rect& out);
+		/**************************************************************************/
+		/*!
+		  \brief
+			Width and height actually covered by placed rectangles.
+		*/
+		/**************************************************************************/
+		int UsedWidth() const;
+		int UsedHeight() const;
+
+	private:
+		void SplitFreeRects(const Rect& used);
+		void PruneFreeRects();
+
+		std::vector<Rect> free_rects;
+		int used_width, used_height;
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Reads cooker settings from the command line.
+
+	  \param argc
+		Number of arguments.
+
+	  \param argv
+		Arguments.
+
+	  \param settings
+		Settings to fill in.
+
+	  \return
+		True if all arguments were valid.
+	*/
+	/**************************************************************************/
+	bool ParseArguments(int argc, char** argv, Settings& settings);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Packs every eligible image, writes the pages and the remap table.
+
+	  \param settings
+		Cooker settings.
+
+	  \return
+		True if the pages and table were written.
+	*/
+	/**************************************************************************/
+	bool Cook(const Settings& settings);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Runs the cooker from the command line.
+
+	  \param argc
+		Number of arguments.
+
+	  \param argv
+		Arguments.
+
+	  \return
+		0 on success.
+	*/
+	/**************************************************************************/
+	int Run(int argc, char** argv);
+}
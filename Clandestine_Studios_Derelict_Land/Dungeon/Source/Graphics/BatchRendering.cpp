@@ -12,8 +12,13 @@
  */
  /******************************************************************************/
 #include <Graphics/BatchRendering.h>
+#include <Graphics/RenderStats.h>
+#include <Graphics/RenderThread.h>
 #include <array>
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -21,7 +26,17 @@ static const size_t MaxQuads = 10000;
 static const size_t MaxVert = MaxQuads * 4;
 static const size_t MaxIndex = MaxQuads * 6;
 static const size_t MaxTextures = 32;
-static const size_t MaxLights = 32;
+static const float LightTileSize = 32.f;	// screen tile edge for light culling
+static const float LightRange = 2000.f;		// radius lit per unit of intensity
+static const GLuint StreamRegions = 3;
+
+// Uniform block binding points, must match layout(binding) in the shaders
+static const GLuint CameraBinding = 0;
+static const GLuint FrameBinding = 1;
+static const GLuint LightBinding = 2;
+// Shader storage binding points, must match layout(binding) in quad.frag
+static const GLuint LightDataBinding = 3;
+static const GLuint LightGridBinding = 4;
 
 struct QuadVertex
 {
@@ -31,17 +46,99 @@ struct QuadVertex
 	float TexIndex;
 };
 
+// One record per sprite, sprite.vert expands it to a quad (64 bytes instead of 4 QuadVertex)
+struct SpriteInstance
+{
+	glm::vec3 Position;
+	float Rotation;
+	glm::vec2 Size;
+	glm::vec4 UVRect;
+	GLuint Color;
+	float TexIndex;
+	glm::vec4 Anim;		// flipbook start, frame duration, frames, frames per row
+};
+
 struct LineVertex {
 	glm::vec3 Position;
 	glm::vec4 Color;
 };
 
+// std140 uniform blocks, shared by every program that declares them
+struct CameraBlock
+{
+	glm::mat4 ViewProj;
+	glm::mat4 Transform;	// world to device
+};
+
+struct FrameBlock
+{
+	float Time;
+	float DeltaTime;
+	float Padding[2];
+};
+
+struct LightBlock
+{
+	glm::vec2 Origin;		// world position of tile (0,0)
+	float TileSize;
+	GLint TilesX;
+	GLint TilesY;
+	GLint Count;
+	GLint Padding[2];
+};
+
+// std430 record in the light data buffer
+struct LightData
+{
+	glm::vec4 Position;		// xyz position, w radius
+	glm::vec4 Color;		// rgb color, a intensity
+};
+
+// Vertex buffer split into StreamRegions regions. Each flush writes one region
+// through a persistent mapping and fences it, so the CPU never overwrites data
+// the GPU may still be reading. Mapped is null when glBufferSubData is used.
+struct StreamBuffer
+{
+	GLuint VBO = 0;
+	uint8_t* Mapped = nullptr;
+	GLsizeiptr RegionSize = 0;
+	GLuint Region = 0;
+	GLsync Fences[StreamRegions]{};
+};
+
+// Baked static quads, drawn with one call. Textures[0] is the white texture.
+struct StaticChunk
+{
+	GLuint VAO = 0;
+	GLuint VBO = 0;
+	GLsizei IndexCount = 0;
+	std::array<GLuint, MaxTextures> Textures{};
+	GLuint TextureCount = 1;
+};
+
+// Everything recorded between StartBatch and Flush. The simulation thread fills
+// one while the render thread draws others, then it goes back to the pool.
+struct BatchPass
+{
+	RenderQueue Queue;
+	std::vector<LineVertex> Lines;
+	std::vector<glm::vec3> LightPositions;
+	std::vector<glm::vec3> LightColors;
+	std::vector<GLfloat> LightIntensities;
+	glm::vec3 Camera{};
+	float LineWidth = 2.0f;
+	bool Static = false;		// draw the baked quads before the queue, sorting the static translucent ones into it
+};
+
 struct Data
 {
 	GLuint QuadVAO = 0;
-	GLuint QuadVBO = 0;
+	StreamBuffer QuadStream;
 	GLuint QuadIBO = 0;
 
+	GLuint SpriteVAO = 0;
+	StreamBuffer SpriteStream;
+
 	GLuint LineVAO = 0;
 	GLuint LineVBO = 0;
 
@@ -56,50 +153,265 @@ struct Data
 	QuadVertex* QuadBuffer = nullptr;
 	QuadVertex* QuadBufferPtr = nullptr;
 
+	// Instanced path is used whenever the sprite shader linked
+	bool Instanced = false;
+	GLuint SpriteCount = 0;
+	SpriteInstance* SpriteBuffer = nullptr;
+	SpriteInstance* SpriteBufferPtr = nullptr;
+
 	GLuint LineIndexCount = 0;
 	LineVertex* LineBuffer = nullptr;
 	LineVertex* LineBufferPtr = nullptr;
-	float LineWidth = 2.0f;
 
+	// Pass being drawn, its lights are swapped in below
+	const BatchPass* Drawing = nullptr;
 	std::vector<glm::vec3> lightPositions;
 	std::vector<glm::vec3> lightColors;
 	std::vector<GLfloat> lightIntensities;
+	bool LightsDirty = true;
+
+	GLuint CameraUBO = 0;
+	GLuint FrameUBO = 0;
+	GLuint LightUBO = 0;
+
+	// Lights and per tile light lists, rebuilt when lights or the camera change
+	GLuint LightDataSSBO = 0;
+	GLuint LightGridSSBO = 0;
+	GLsizeiptr LightDataCapacity = 0;
+	GLsizeiptr LightGridCapacity = 0;
+	LightBlock Lights{};
+	std::vector<LightData> LightList;
+	std::vector<GLuint> LightGrid;
+	CameraBlock Camera{};
+	FrameBlock Frame{};
 
 	std::array<GLuint, MaxTextures> TextureSlots{};
 	GLuint TextureSlotIndex = 1;
+
+	std::vector<StaticChunk> StaticChunks;
+	// Static quads that need blending are not baked, they are sorted into
+	// every pass with the rest so they stay in depth order
+	RenderQueue StaticTranslucent;
+
+	// Counted where the batch is drawn, read with TakeStats
+	Batch::Stats Stats;
+
+	// Recording side, only used by the thread calling the Draw functions.
+	// Quads are queued into the pass and sorted when it is drawn.
+	BatchPass* Recording = nullptr;
+	uint8_t Layer = RenderQueue::World;
+	float LineWidth = 2.0f;
+	float Clock = 0.f;		// Frame.Time of the frame being recorded
+
+	// Between BeginStatic and EndStatic quads are queued here instead
+	bool Baking = false;
+	bool StaticDirty = true;	// set by InvalidateStatic, cleared by BeginStatic
+	RenderQueue StaticQueue;
+
+	// Pool of passes, returned by the render thread once drawn
+	std::mutex PassMutex;
+	std::vector<std::unique_ptr<BatchPass>> Passes;
+	std::vector<BatchPass*> FreePasses;
 };
 
 static Data Batch_Data;
 GLSLShader Batch::quad_shader_program;
 GLSLShader Batch::line_shader_program;
+GLSLShader Batch::sprite_shader_program;
 Camera Batch::camera;
 /**************************************************************************/
 /*!
   \brief
-	Create and bind vertex, index and initializes white texture to be used for drawing quads.
+	Create a streaming vertex buffer and leave it bound to GL_ARRAY_BUFFER.
+	With ARB_buffer_storage it holds StreamRegions regions and stays mapped,
+	otherwise it holds one region filled with glBufferSubData.
+
+  \param stream
+	Buffer to create.
+
+  \param region_size
+	Bytes of one region.
 */
 /**************************************************************************/
-void Create_QuadBuffer() {
-	Batch_Data.QuadBuffer = new QuadVertex[MaxVert];
+void Create_StreamBuffer(StreamBuffer& stream, GLsizeiptr region_size) {
+	stream.RegionSize = region_size;
+	glCreateBuffers(1, &stream.VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, stream.VBO);
+
+	if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(GL_ARRAY_BUFFER, region_size * StreamRegions, nullptr, flags);
+		stream.Mapped = (uint8_t*)glMapBufferRange(GL_ARRAY_BUFFER, 0, region_size * StreamRegions, flags);
+		if (stream.Mapped)
+			return;
+
+		// Storage is immutable, start over with a normal buffer
+		glDeleteBuffers(1, &stream.VBO);
+		glCreateBuffers(1, &stream.VBO);
+		glBindBuffer(GL_ARRAY_BUFFER, stream.VBO);
+	}
+	std::cout << "Persistent mapping not available, batches are uploaded with glBufferSubData" << std::endl;
+	glBufferData(GL_ARRAY_BUFFER, region_size, nullptr, GL_DYNAMIC_DRAW);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gets the region to write the next batch into, waiting for the GPU if it
+	has not finished drawing from it yet.
 
-	glCreateBuffers(1, &Batch_Data.QuadVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, Batch_Data.QuadVBO);
-	glBufferData(GL_ARRAY_BUFFER, MaxVert * sizeof(QuadVertex), nullptr, GL_DYNAMIC_DRAW);
+  \param stream
+	Buffer to write to.
 
-	glCreateVertexArrays(1, &Batch_Data.QuadVAO);
-	glBindVertexArray(Batch_Data.QuadVAO);
+  \return
+	Start of the region, nullptr if the buffer is not mapped.
+*/
+/**************************************************************************/
+void* Stream_Begin(StreamBuffer& stream) {
+	if (!stream.Mapped)
+		return nullptr;
+
+	GLsync& fence = stream.Fences[stream.Region];
+	if (fence) {
+		GLenum result;
+		do {
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		} while (result == GL_TIMEOUT_EXPIRED);
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+	return stream.Mapped + stream.Region * stream.RegionSize;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Fences the region just drawn from and moves on to the next one.
+
+  \param stream
+	Buffer that was drawn from.
+*/
+/**************************************************************************/
+void Stream_End(StreamBuffer& stream) {
+	if (!stream.Mapped)
+		return;
+
+	stream.Fences[stream.Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	stream.Region = (stream.Region + 1) % StreamRegions;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Frees a streaming vertex buffer.
+
+  \param stream
+	Buffer to free.
+*/
+/**************************************************************************/
+void Delete_StreamBuffer(StreamBuffer& stream) {
+	for (GLsync& fence : stream.Fences) {
+		if (fence)
+			glDeleteSync(fence);
+		fence = nullptr;
+	}
+	if (stream.Mapped)
+		glUnmapNamedBuffer(stream.VBO);
+	glDeleteBuffers(1, &stream.VBO);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Points the quad and sprite writers at the start of their next region.
+*/
+/**************************************************************************/
+void BeginBatchRegion() {
+	if (void* quads = Stream_Begin(Batch_Data.QuadStream))
+		Batch_Data.QuadBuffer = (QuadVertex*)quads;
+	if (void* sprites = Stream_Begin(Batch_Data.SpriteStream))
+		Batch_Data.SpriteBuffer = (SpriteInstance*)sprites;
+
+	Batch_Data.QuadBufferPtr = Batch_Data.QuadBuffer;
+	Batch_Data.SpriteBufferPtr = Batch_Data.SpriteBuffer;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Takes a pass from the pool, making one if every pass is in use.
+*/
+/**************************************************************************/
+BatchPass* Acquire_Pass() {
+	std::lock_guard<std::mutex> lock(Batch_Data.PassMutex);
+	if (Batch_Data.FreePasses.empty()) {
+		Batch_Data.Passes.push_back(std::make_unique<BatchPass>());
+		return Batch_Data.Passes.back().get();
+	}
+	BatchPass* pass = Batch_Data.FreePasses.back();
+	Batch_Data.FreePasses.pop_back();
+	return pass;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gives a drawn pass back to the pool, emptied but keeping its memory.
+*/
+/**************************************************************************/
+void Release_Pass(BatchPass* pass) {
+	pass->Queue.Clear();
+	pass->Lines.clear();
+	pass->LightPositions.clear();
+	pass->LightColors.clear();
+	pass->LightIntensities.clear();
+	pass->Static = false;
+
+	std::lock_guard<std::mutex> lock(Batch_Data.PassMutex);
+	Batch_Data.FreePasses.push_back(pass);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gets the pass being recorded, starting one if StartBatch was not called.
+*/
+/**************************************************************************/
+BatchPass& Record_Pass() {
+	if (!Batch_Data.Recording)
+		Batch_Data.Recording = Acquire_Pass();
+	return *Batch_Data.Recording;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Describe QuadVertex to a vertex array, reading from the buffer bound to
+	GL_ARRAY_BUFFER.
 
-	glEnableVertexArrayAttrib(Batch_Data.QuadVAO, 0);
+  \param vao
+	Vertex array to set up, must be bound.
+*/
+/**************************************************************************/
+void Set_QuadAttribs(GLuint vao) {
+	glEnableVertexArrayAttrib(vao, 0);
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const void*)offsetof(QuadVertex, Position));
 
-	glEnableVertexArrayAttrib(Batch_Data.QuadVAO, 1);
+	glEnableVertexArrayAttrib(vao, 1);
 	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const void*)offsetof(QuadVertex, Color));
 
-	glEnableVertexArrayAttrib(Batch_Data.QuadVAO, 2);
+	glEnableVertexArrayAttrib(vao, 2);
 	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const void*)offsetof(QuadVertex, TexCoords));
 
-	glEnableVertexArrayAttrib(Batch_Data.QuadVAO, 3);
+	glEnableVertexArrayAttrib(vao, 3);
 	glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const void*)offsetof(QuadVertex, TexIndex));
+}
+/**************************************************************************/
+/*!
+  \brief
+	Create and bind vertex, index and initializes white texture to be used for drawing quads.
+*/
+/**************************************************************************/
+void Create_QuadBuffer() {
+	Create_StreamBuffer(Batch_Data.QuadStream, MaxVert * sizeof(QuadVertex));
+	if (!Batch_Data.QuadStream.Mapped)
+		Batch_Data.QuadBuffer = new QuadVertex[MaxVert];
+
+	glCreateVertexArrays(1, &Batch_Data.QuadVAO);
+	glBindVertexArray(Batch_Data.QuadVAO);
+	Set_QuadAttribs(Batch_Data.QuadVAO);
 
 	GLuint indices[MaxIndex];
 	//GLuint* indices = new GLuint[MaxIndex];
@@ -159,388 +471,897 @@ void Create_LineBuffer() {
 /**************************************************************************/
 /*!
   \brief
-	Initialize all things required to run BatchRendering.
+	Create and bind the per-instance buffer used for drawing sprites. Every
+	attribute advances once per instance, the quad corners come from
+	gl_VertexID in sprite.vert.
 */
 /**************************************************************************/
-void Batch::Init() {
-	Create_QuadBuffer();
-	Create_LineBuffer();
+void Create_SpriteBuffer() {
+	Create_StreamBuffer(Batch_Data.SpriteStream, MaxQuads * sizeof(SpriteInstance));
+	if (!Batch_Data.SpriteStream.Mapped)
+		Batch_Data.SpriteBuffer = new SpriteInstance[MaxQuads];
 
-	glUseProgram(Batch::quad_shader_program.GetHandle());
-	GLuint loc = glGetUniformLocation(Batch::quad_shader_program.GetHandle(), "uTex2d");
-	int samplers[32];
-	for (size_t i = 0; i < 32; ++i)
-		samplers[i] = (int)i;
-	glUniform1iv(loc, 32, samplers);
+	glCreateVertexArrays(1, &Batch_Data.SpriteVAO);
+	glBindVertexArray(Batch_Data.SpriteVAO);
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glEnableVertexArrayAttrib(Batch_Data.SpriteVAO, 0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (const void*)offsetof(SpriteInstance, Position));
+	glVertexAttribDivisor(0, 1);
 
-	glEnable(GL_DEPTH_TEST);
-	glDepthMask(GL_TRUE);
-	glDepthFunc(GL_LEQUAL);
-	glDepthRange(0.f, 1.f);
+	glEnableVertexArrayAttrib(Batch_Data.SpriteVAO, 1);
+	glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (const void*)offsetof(SpriteInstance, Rotation));
+	glVertexAttribDivisor(1, 1);
+
+	glEnableVertexArrayAttrib(Batch_Data.SpriteVAO, 2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (const void*)offsetof(SpriteInstance, Size));
+	glVertexAttribDivisor(2, 1);
+
+	glEnableVertexArrayAttrib(Batch_Data.SpriteVAO, 3);
+	glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (const void*)offsetof(SpriteInstance, UVRect));
+	glVertexAttribDivisor(3, 1);
+
+	glEnableVertexArrayAttrib(Batch_Data.SpriteVAO, 4);
+	glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteInstance), (const void*)offsetof(SpriteInstance, Color));
+	glVertexAttribDivisor(4, 1);
+
+	glEnableVertexArrayAttrib(Batch_Data.SpriteVAO, 5);
+	glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (const void*)offsetof(SpriteInstance, TexIndex));
+	glVertexAttribDivisor(5, 1);
+
+	glEnableVertexArrayAttrib(Batch_Data.SpriteVAO, 6);
+	glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (const void*)offsetof(SpriteInstance, Anim));
+	glVertexAttribDivisor(6, 1);
 }
 /**************************************************************************/
 /*!
   \brief
-	Free-ing of memory used in BatchRendering
+	Sends the quads, sprites and lines written so far to the GPU.
 */
 /**************************************************************************/
-void Batch::Cleanup() {
-	glDeleteVertexArrays(1, &Batch_Data.QuadVAO);
-	glDeleteBuffers(1, &Batch_Data.QuadVBO);
-	glDeleteBuffers(1, &Batch_Data.QuadIBO);
-	glDeleteTextures(1, &Batch_Data.WhiteTexture);
+void UploadBatch() {
+	// Mapped streams were written in place, only the fallback needs an upload.
+	// Both count as uploaded, the GPU reads mapped memory over the bus too.
+	GLsizeiptr quads = (uint8_t*)Batch_Data.QuadBufferPtr - (uint8_t*)Batch_Data.QuadBuffer;
+	if (Batch_Data.QuadIndexCount && !Batch_Data.QuadStream.Mapped) {
+		glBindBuffer(GL_ARRAY_BUFFER, Batch_Data.QuadStream.VBO);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, quads, Batch_Data.QuadBuffer);
+	}
 
-	glDeleteVertexArrays(1, &Batch_Data.LineVAO);
-	glDeleteBuffers(1, &Batch_Data.LineVBO);
+	GLsizeiptr sprites = (uint8_t*)Batch_Data.SpriteBufferPtr - (uint8_t*)Batch_Data.SpriteBuffer;
+	if (Batch_Data.SpriteCount && !Batch_Data.SpriteStream.Mapped) {
+		glBindBuffer(GL_ARRAY_BUFFER, Batch_Data.SpriteStream.VBO);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sprites, Batch_Data.SpriteBuffer);
+	}
+	
+	GLsizeiptr lines = (uint8_t*)Batch_Data.LineBufferPtr - (uint8_t*)Batch_Data.LineBuffer;
+	if (Batch_Data.LineIndexCount) {
+		glBindBuffer(GL_ARRAY_BUFFER, Batch_Data.LineVBO);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, lines, Batch_Data.LineBuffer);
+	}
 
-	delete[] Batch_Data.QuadBuffer;
-	delete[] Batch_Data.LineBuffer;
+	Batch_Data.Stats.BytesUploaded += (Batch_Data.QuadIndexCount ? quads : 0) + (Batch_Data.SpriteCount ? sprites : 0) + (Batch_Data.LineIndexCount ? lines : 0);
 }
+void Flush_Batch(Batch::FlushReason reason);
 /**************************************************************************/
 /*!
   \brief
-	Setting all pointers to start of the batch.
+	Flushes the batch if another quad (and texture, if needed) does not fit.
+
+  \param textured
+	Whether the quad needs a texture slot.
 */
 /**************************************************************************/
-void Batch::StartBatch() {
-	Batch_Data.QuadIndexCount = 0;
-	Batch_Data.QuadBufferPtr = Batch_Data.QuadBuffer;
-
-	Batch_Data.LineIndexCount = 0;
-	Batch_Data.LineBufferPtr = Batch_Data.LineBuffer;
+void FlushIfFull(bool textured) {
+	bool full = Batch_Data.Instanced ? Batch_Data.SpriteCount >= MaxQuads : Batch_Data.QuadIndexCount >= MaxIndex;
+	if (full || (textured && Batch_Data.TextureSlotIndex >= MaxTextures)) {
+		UploadBatch();
+		Flush_Batch(full ? Batch::QuadsFull : Batch::TexturesFull);
+	}
 }
 /**************************************************************************/
 /*!
   \brief
-	Binding all required buffers to send to GPU for drawing.
+	Finds the texture slot of texid, taking the next free slot if it is not
+	bound yet.
+
+  \param texid
+	Texture to find.
 */
 /**************************************************************************/
-void Batch::EndBatch() {
-	if (Batch_Data.QuadIndexCount) {
-		GLsizeiptr size = (uint8_t*)Batch_Data.QuadBufferPtr - (uint8_t*)Batch_Data.QuadBuffer;
-		glBindBuffer(GL_ARRAY_BUFFER, Batch_Data.QuadVBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, Batch_Data.QuadBuffer);
+float GetTextureIndex(GLuint texid) {
+	for (GLuint i = 0; i < Batch_Data.TextureSlotIndex; ++i)
+	{
+		if (Batch_Data.TextureSlots[i] == texid)
+			return (float)i;
 	}
-	
-	if (Batch_Data.LineIndexCount) {
-		GLsizeiptr size = (uint8_t*)Batch_Data.LineBufferPtr - (uint8_t*)Batch_Data.LineBuffer;
-		glBindBuffer(GL_ARRAY_BUFFER, Batch_Data.LineVBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, Batch_Data.LineBuffer);
+
+	if (Batch_Data.TextureSlotIndex < MaxTextures) {
+		Batch_Data.TextureSlots[Batch_Data.TextureSlotIndex] = texid;
+		return (float)Batch_Data.TextureSlotIndex++;
 	}
+	return 0.f;
 }
 /**************************************************************************/
 /*!
   \brief
-	Draw all current Quads and/or Lines called using draw calls.
-*/
-/**************************************************************************/
-void Batch::Flush() {
-	glm::mat4 view = glm::ortho(0.f + (camera.GetCameraPosition().x / GLSetup::width), 1.f + (camera.GetCameraPosition().x / GLSetup::width)
-		, 0.f + (camera.GetCameraPosition().y / GLSetup::height), 1.f + (camera.GetCameraPosition().y / GLSetup::height));
-
-	if (Batch_Data.QuadIndexCount) {
-		quad_shader_program.Use();
-		for (GLuint i = 0; i < Batch_Data.TextureSlotIndex; ++i)
-			glBindTextureUnit(i, Batch_Data.TextureSlots[i]);
-
-		glBindVertexArray(Batch_Data.QuadVAO);
-		glDrawElements(GL_TRIANGLES, Batch_Data.QuadIndexCount, GL_UNSIGNED_INT, nullptr);
-
-		Batch_Data.QuadIndexCount = 0;
-		Batch_Data.TextureSlotIndex = 1;	
-
-		GLuint loc2 = glGetUniformLocation(Batch::quad_shader_program.GetHandle(), "uViewProj");
-		if (loc2 >= 0)
-			glUniformMatrix4fv(loc2, 1, GL_FALSE, glm::value_ptr(view));
+	Transforms a quad into four QuadVertex.
 
-		glm::mat4 device(1.f / GLSetup::width, 0.f, 0.f, 0.f,
-			0.f, 1.f / GLSetup::height, 0.f, 0.f,
-			0.f, 0.f, 1.f, 0.f,
-			0.f, 0.f, 0.f, 1.f);
+  \param out
+	The four vertices are written here.
 
-		GLuint loc = glGetUniformLocation(quad_shader_program.GetHandle(), "uTransform");
-		if (loc >= 0)
-			glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(device));
-
-		GLint lightSize = glGetUniformLocation(quad_shader_program.GetHandle(), "light_size");
-		glUniform1i(lightSize, (GLint)Batch_Data.lightIntensities.size());
+  \param pos
+	Position(x,y,z) of the quad's center.
 
-		if (Batch_Data.lightPositions.size() > 0 && Batch_Data.lightColors.size() > 0 && Batch_Data.lightIntensities.size() > 0) {
-			GLint lightPositionsLoc = glGetUniformLocation(quad_shader_program.GetHandle(), "light_pos");
-			GLint lightColorsLoc = glGetUniformLocation(quad_shader_program.GetHandle(), "light_color");
-			GLint lightIntensitiesLoc = glGetUniformLocation(quad_shader_program.GetHandle(), "light_intensity");
+  \param size
+	Final size(x,y) of the quad, scale already applied.
 
-			glUniform3fv(lightPositionsLoc, (GLsizei)Batch_Data.lightPositions.size(), glm::value_ptr(Batch_Data.lightPositions[0]));
-			glUniform3fv(lightColorsLoc, (GLsizei)Batch_Data.lightColors.size(), glm::value_ptr(Batch_Data.lightColors[0]));
-			glUniform1fv(lightIntensitiesLoc, (GLsizei)Batch_Data.lightIntensities.size(), &Batch_Data.lightIntensities[0]);
+  \param angle
+	Rotation of the quad.
 
+  \param uv_start
+	UV of the bottom left corner.
 
-			Batch_Data.lightPositions.clear();
-			Batch_Data.lightColors.clear();
-			Batch_Data.lightIntensities.clear();
-		}
-	}
-	
-	if (Batch_Data.LineIndexCount) {
-		line_shader_program.Use();
-		glBindVertexArray(Batch_Data.LineVAO);
-		glLineWidth(Batch_Data.LineWidth);
-		glDrawArrays(GL_LINES, 0, Batch_Data.LineIndexCount);
+  \param uv_end
+	UV of the top right corner.
 
-		Batch_Data.LineIndexCount = 0;
+  \param clr
+	Color(r,g,b,a) of the quad.
 
-		GLuint loc2 = glGetUniformLocation(Batch::line_shader_program.GetHandle(), "uViewProj");
-		if (loc2 >= 0)
-			glUniformMatrix4fv(loc2, 1, GL_FALSE, glm::value_ptr(view));
-	}
+  \param TexIndex
+	Texture slot of the quad, 0 is the white texture.
+*/
+/**************************************************************************/
+void WriteQuadVertices(QuadVertex* out, const glm::vec3& pos, const glm::vec2& size, float angle, const glm::vec2& uv_start, const glm::vec2& uv_end, const glm::vec4& clr, float TexIndex) {
+	glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(pos))
+		* glm::rotate(glm::mat4(1.f), angle, glm::vec3(0.f, 0.f, 1.f))
+		* glm::scale(glm::mat4(1.f), glm::vec3(size, 1.f));
+
+	out->Position = transform * glm::vec4{ -0.5f, -0.5f, 0.0f, 1.f };
+	out->Color = clr;
+	out->TexCoords = { uv_start.x, uv_start.y };
+	out->TexIndex = TexIndex;
+	++out;
+
+	out->Position = transform * glm::vec4{ 0.5f, -0.5f, 0.0f, 1.f };
+	out->Color = clr;
+	out->TexCoords = { uv_end.x, uv_start.y };
+	out->TexIndex = TexIndex;
+	++out;
+
+	out->Position = transform * glm::vec4{ 0.5f,  0.5f, 0.0f, 1.f };
+	out->Color = clr;
+	out->TexCoords = { uv_end.x, uv_end.y };
+	out->TexIndex = TexIndex;
+	++out;
+
+	out->Position = transform * glm::vec4{ -0.5f,  0.5f, 0.0f, 1.f };
+	out->Color = clr;
+	out->TexCoords = { uv_start.x, uv_end.y };
+	out->TexIndex = TexIndex;
 }
 /**************************************************************************/
 /*!
   \brief
-	Draw a Colored Quad.
+	Adds one quad to the batch. With instancing a single SpriteInstance is
+	written and sprite.vert builds the corners, otherwise the quad is
+	transformed here into four QuadVertex.
 
   \param pos
-	Position(x,y,z) in screen space of quad to draw.
+	Position(x,y,z) of the quad's center.
 
   \param size
-	Size(x,y) of quad to draw.
+	Final size(x,y) of the quad, scale already applied.
 
-  \param scale
-	Scale(x,y) of quad to draw.
+  \param angle
+	Rotation of the quad.
+
+  \param uv_start
+	UV of the bottom left corner.
+
+  \param uv_end
+	UV of the top right corner.
 
   \param clr
-	Color(r,g,b,a) of quad to draw.
+	Color(r,g,b,a) of the quad.
+
+  \param TexIndex
+	Texture slot of the quad, 0 is the white texture.
+
+  \param anim
+	Flipbook of the quad. sprite.vert picks the frame, without instancing
+	it is picked here from the same frame time.
 */
 /**************************************************************************/
-void Batch::DrawQuad(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, const glm::vec4& clr, const float& angle_in_degree) {
-	if (Batch_Data.QuadIndexCount >= MaxIndex) {
-		EndBatch();
-		Flush();
-		StartBatch();
+void SubmitQuad(const glm::vec3& pos, const glm::vec2& size, float angle, const glm::vec2& uv_start, const glm::vec2& uv_end, const glm::vec4& clr, float TexIndex, const glm::vec4& anim) {
+	if (Batch_Data.Instanced) {
+		glm::vec4 c = glm::clamp(clr, 0.f, 1.f) * 255.f + 0.5f;
+		Batch_Data.SpriteBufferPtr->Position = pos;
+		Batch_Data.SpriteBufferPtr->Rotation = angle;
+		Batch_Data.SpriteBufferPtr->Size = size;
+		Batch_Data.SpriteBufferPtr->UVRect = { uv_start.x, uv_start.y, uv_end.x, uv_end.y };
+		Batch_Data.SpriteBufferPtr->Color = (GLuint)c.r | ((GLuint)c.g << 8) | ((GLuint)c.b << 16) | ((GLuint)c.a << 24);
+		Batch_Data.SpriteBufferPtr->TexIndex = TexIndex;
+		Batch_Data.SpriteBufferPtr->Anim = anim;
+		++Batch_Data.SpriteBufferPtr;
+		++Batch_Data.SpriteCount;
+		return;
 	}
 
-	glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(pos))
-		* glm::rotate(glm::mat4(1.f), angle_in_degree, glm::vec3(0.f, 0.f, 1.f))
-		* glm::scale(glm::mat4(1.f), glm::vec3(size * scale / 100.f, 1.f));
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { 0.f, 0.f };
-	Batch_Data.QuadBufferPtr->TexIndex = 0.f;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { 1.f, 0.f };
-	Batch_Data.QuadBufferPtr->TexIndex = 0.f;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { 1.f, 1.f };
-	Batch_Data.QuadBufferPtr->TexIndex = 0.f;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { 0.f, 1.f };
-	Batch_Data.QuadBufferPtr->TexIndex = 0.f;
-	++Batch_Data.QuadBufferPtr;
-
+	// Same frame as sprite.vert would pick
+	glm::vec2 offset{ 0.f, 0.f };
+	float frames = std::abs(anim.z);
+	if (frames > 1.f) {
+		float frame = std::floor((Batch_Data.Frame.Time - anim.x) / anim.y);
+		if (anim.z < 0.f) frame = frame < 0.f ? 0.f : frame > frames - 1.f ? frames - 1.f : frame;
+		else frame -= frames * std::floor(frame / frames);
+		offset = glm::vec2{ frame - anim.w * std::floor(frame / anim.w), std::floor(frame / anim.w) } * (uv_end - uv_start);
+	}
+	WriteQuadVertices(Batch_Data.QuadBufferPtr, pos, size, angle, uv_start + offset, uv_end + offset, clr, TexIndex);
+	Batch_Data.QuadBufferPtr += 4;
 	Batch_Data.QuadIndexCount += 6;
 }
 /**************************************************************************/
 /*!
   \brief
-	Draw a Textured Quad.
+	Queues one quad on the current layer. Quads are opaque unless their
+	alpha is below 1. Textured quads count as translucent since sprite
+	sheets have soft alpha edges, unless the texture is known to have no
+	blended texels.
 
   \param pos
-	Position(x,y,z) in screen space of quad to draw.
+	Position(x,y,z) of the quad's center.
 
   \param size
-	Size(x,y) of quad to draw.
-
-  \param scale
-	Scale(x,y) of quad to draw.
-
-  \param texid
-	Texture of quad to draw.
-*/
-/**************************************************************************/
-void Batch::DrawQuad(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const float& angle_in_degree) {
-	if (Batch_Data.QuadIndexCount >= MaxIndex || Batch_Data.TextureSlotIndex > 31) {
-		EndBatch();
-		Flush();
-		StartBatch();
-	}
-
-	glm::vec4 clr = { 1.f, 1.f, 1.f, 1.f };
-
-	float TexIndex = 0.f;
-	for (GLuint i = 0; i < Batch_Data.TextureSlotIndex; ++i)
-	{
-		if (Batch_Data.TextureSlots[i] == texid) {
-			TexIndex = (float)i;
-			break;
-		}
-	}
-
-	if (TexIndex == 0.f && Batch_Data.TextureSlotIndex < 32) {
-		TexIndex = (float)Batch_Data.TextureSlotIndex;
-		Batch_Data.TextureSlots[Batch_Data.TextureSlotIndex] = texid;
-		++Batch_Data.TextureSlotIndex;
-	}
+	Final size(x,y) of the quad, scale already applied.
 
-	glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(pos))
-		* glm::rotate(glm::mat4(1.f), angle_in_degree, glm::vec3(0.f, 0.f, 1.f))
-		* glm::scale(glm::mat4(1.f), glm::vec3(size * scale/100.f, 1.f));
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { 0.f, 0.f };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { 1.f, 0.f };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { 1.f, 1.f };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { 0.f, 1.f };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
+  \param angle
+	Rotation of the quad.
 
-	Batch_Data.QuadIndexCount += 6;
-}
+  \param uv_start
+	UV of the bottom left corner.
 
-void Batch::DrawQuadWithUV(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const glm::vec2& uv_start, const glm::vec2& uv_end, const float& angle_in_degree) {
-	if (Batch_Data.QuadIndexCount >= MaxIndex || Batch_Data.TextureSlotIndex > 31) {
-		EndBatch();
-		Flush();
-		StartBatch();
-	}
+  \param uv_end
+	UV of the top right corner.
 
-	glm::vec4 clr = { 1.f, 1.f, 1.f, 1.f };
+  \param clr
+	Color(r,g,b,a) of the quad.
 
-	float TexIndex = 0.f;
-	for (GLuint i = 0; i < Batch_Data.TextureSlotIndex; ++i)
-	{
-		if (Batch_Data.TextureSlots[i] == texid) {
-			TexIndex = (float)i;
-			break;
-		}
-	}
+  \param texid
+	Texture of the quad, 0 for none.
 
-	if (TexIndex == 0.f && Batch_Data.TextureSlotIndex < 32) {
-		TexIndex = (float)Batch_Data.TextureSlotIndex;
-		Batch_Data.TextureSlots[Batch_Data.TextureSlotIndex] = texid;
-		++Batch_Data.TextureSlotIndex;
-	}
+  \param edge
+	Distance field edge for text quads, which are not lit. 0 for others.
 
-	glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(pos))
-		* glm::rotate(glm::mat4(1.f), angle_in_degree, glm::vec3(0.f, 0.f, 1.f))
-		* glm::scale(glm::mat4(1.f), glm::vec3(size * scale / 100.f, 1.f));
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { uv_start.x, uv_start.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { uv_end.x, uv_start.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { uv_end.x, uv_end.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { uv_start.x, uv_end.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
+  \param anim
+	Flipbook start, frame duration, frames and frames per row. Zero for
+	still quads.
 
-	Batch_Data.QuadIndexCount += 6;
+  \param opaque
+	Texture has no blended texels, each is solid or discarded by quad.frag.
+*/
+/**************************************************************************/
+void Enqueue(const glm::vec3& pos, const glm::vec2& size, float angle, const glm::vec2& uv_start, const glm::vec2& uv_end, const glm::vec4& clr, GLuint texid, float edge = 0.f, const glm::vec4& anim = {}, bool opaque = false) {
+	bool translucent = (texid != 0 && !opaque) || clr.a < 1.f;
+	uint64_t key = RenderQueue::MakeKey(Batch_Data.Layer, pos.z, translucent, 0, texid);
+	RenderQueue& queue = Batch_Data.Baking ? Batch_Data.StaticQueue : Record_Pass().Queue;
+	queue.Submit(key, { pos, size, angle, uv_start, uv_end, clr, texid, edge, anim });
 }
+/**************************************************************************/
+/*!
+  \brief
+	Create the camera, frame and light uniform buffers and bind them to
+	their binding points.
+*/
+/**************************************************************************/
+void Create_UniformBuffers() {
+	glCreateBuffers(1, &Batch_Data.CameraUBO);
+	glNamedBufferData(Batch_Data.CameraUBO, sizeof(CameraBlock), nullptr, GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_UNIFORM_BUFFER, CameraBinding, Batch_Data.CameraUBO);
 
-void Batch::DrawQuadWithPixelCoords(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const glm::vec2& uv_start, const glm::vec2& uv_end, const glm::vec2 texsize, const glm::vec4 clr, const float& angle_in_degree) {
-	if (Batch_Data.QuadIndexCount >= MaxIndex || Batch_Data.TextureSlotIndex > 31) {
-		EndBatch();
-		Flush();
-		StartBatch();
-	}
-
-	//glm::vec4 clr = { 1.f, 1.f, 1.f, 1.f };
-
-	float TexIndex = 0.f;
-	for (GLuint i = 0; i < Batch_Data.TextureSlotIndex; ++i)
-	{
-		if (Batch_Data.TextureSlots[i] == texid) {
-			TexIndex = (float)i;
-			break;
-		}
-	}
-
-	if (TexIndex == 0.f && Batch_Data.TextureSlotIndex < 32) {
-		TexIndex = (float)Batch_Data.TextureSlotIndex;
-		Batch_Data.TextureSlots[Batch_Data.TextureSlotIndex] = texid;
-		++Batch_Data.TextureSlotIndex;
-	}
+	glCreateBuffers(1, &Batch_Data.FrameUBO);
+	glNamedBufferData(Batch_Data.FrameUBO, sizeof(FrameBlock), &Batch_Data.Frame, GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_UNIFORM_BUFFER, FrameBinding, Batch_Data.FrameUBO);
 
-	glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(pos))
-		* glm::rotate(glm::mat4(1.f), angle_in_degree, glm::vec3(0.f, 0.f, 1.f))
-		* glm::scale(glm::mat4(1.f), glm::vec3(size * scale / 100.f, 1.f));
-
-	glm::vec2 start = { uv_start.x / texsize.x, uv_start.y / texsize.y };
-	glm::vec2 end = { uv_end.x / texsize.x, uv_end.y / texsize.y };
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { start.x, start.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { end.x, start.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { end.x, end.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { start.x, end.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
+	glCreateBuffers(1, &Batch_Data.LightUBO);
+	glNamedBufferData(Batch_Data.LightUBO, sizeof(LightBlock), &Batch_Data.Lights, GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_UNIFORM_BUFFER, LightBinding, Batch_Data.LightUBO);
 
-	Batch_Data.QuadIndexCount += 6;
+	glCreateBuffers(1, &Batch_Data.LightDataSSBO);
+	glCreateBuffers(1, &Batch_Data.LightGridSSBO);
 }
 /**************************************************************************/
 /*!
   \brief
-	Draw a Colored Line.
+	Uploads the camera block if the camera or window size changed since the
+	last upload.
+
+  \param cam
+	Camera position the pass was recorded with.
+*/
+/**************************************************************************/
+void UpdateCameraBlock(const glm::vec3& cam) {
+	CameraBlock block;
+	block.ViewProj = glm::ortho(0.f + (cam.x / GLSetup::width), 1.f + (cam.x / GLSetup::width)
+		, 0.f + (cam.y / GLSetup::height), 1.f + (cam.y / GLSetup::height));
+	block.Transform = glm::mat4(1.f / GLSetup::width, 0.f, 0.f, 0.f,
+		0.f, 1.f / GLSetup::height, 0.f, 0.f,
+		0.f, 0.f, 1.f, 0.f,
+		0.f, 0.f, 0.f, 1.f);
+
+	if (block.ViewProj != Batch_Data.Camera.ViewProj || block.Transform != Batch_Data.Camera.Transform) {
+		Batch_Data.Camera = block;
+		glNamedBufferSubData(Batch_Data.CameraUBO, 0, sizeof(CameraBlock), &Batch_Data.Camera);
+		Batch_Data.Stats.BytesUploaded += sizeof(CameraBlock);
+	}
+}
+/**************************************************************************/
+/*!
+  \brief
+	Uploads data to a shader storage buffer, growing it when the data does
+	not fit, and binds it to its binding point.
+*/
+/**************************************************************************/
+void Upload_StorageBuffer(GLuint& buffer, GLsizeiptr& capacity, GLuint binding, const void* data, GLsizeiptr size) {
+	if (size > capacity) {
+		capacity = size * 2;
+		glDeleteBuffers(1, &buffer);
+		glCreateBuffers(1, &buffer);
+		glNamedBufferData(buffer, capacity, nullptr, GL_DYNAMIC_DRAW);
+	}
+	if (size)
+		glNamedBufferSubData(buffer, 0, size, data);
+	Batch_Data.Stats.BytesUploaded += size;
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Culls the lights against 32x32 screen tiles and uploads them, if lights
+	were set or the camera moved since the last upload. Each tile gets the
+	list of lights whose radius reaches it, so quad.frag only loops over
+	the lights near each fragment.
+
+	The grid buffer holds a first/count pair per tile followed by the light
+	indices, filled with a counting pass so each list is contiguous.
+
+  \param cam
+	Camera position the pass was recorded with.
+*/
+/**************************************************************************/
+void UpdateLightBlock(const glm::vec3& cam) {
+	GLint tiles_x = (GLint)std::ceil(GLSetup::width / LightTileSize);
+	GLint tiles_y = (GLint)std::ceil(GLSetup::height / LightTileSize);
+	LightBlock& block = Batch_Data.Lights;
+	bool moved = block.Origin != glm::vec2(cam) || block.TilesX != tiles_x || block.TilesY != tiles_y;
+	if (!Batch_Data.LightsDirty && !moved)
+		return;
+
+	RenderStats::Begin(RenderStats::Lights);
+	block.Origin = glm::vec2(cam);
+	block.TileSize = LightTileSize;
+	block.TilesX = tiles_x;
+	block.TilesY = tiles_y;
+
+	std::vector<LightData>& lights = Batch_Data.LightList;
+	lights.clear();
+	for (size_t i = 0; i < Batch_Data.lightIntensities.size(); ++i) {
+		float radius = Batch_Data.lightIntensities[i] * LightRange;
+		if (radius <= 0.f)
+			continue;
+		lights.push_back({ glm::vec4(Batch_Data.lightPositions[i], radius), glm::vec4(Batch_Data.lightColors[i], Batch_Data.lightIntensities[i]) });
+	}
+	block.Count = (GLint)lights.size();
+
+	// Tile range a light touches, empty if it is off screen
+	auto tile_range = [&](const LightData& light, glm::ivec2& min, glm::ivec2& max) {
+		glm::vec2 center = (glm::vec2(light.Position) - block.Origin) / LightTileSize;
+		float r = light.Position.w / LightTileSize;
+		min = glm::ivec2(glm::floor(center - r));
+		max = glm::ivec2(glm::floor(center + r));
+		min.x = min.x < 0 ? 0 : min.x;
+		min.y = min.y < 0 ? 0 : min.y;
+		max.x = max.x >= tiles_x ? tiles_x - 1 : max.x;
+		max.y = max.y >= tiles_y ? tiles_y - 1 : max.y;
+	};
+	// Circle against tile rectangle, the corners of the range are often missed
+	auto touches = [&](const LightData& light, int x, int y) {
+		glm::vec2 tile_min = block.Origin + glm::vec2(x, y) * LightTileSize;
+		glm::vec2 closest = glm::clamp(glm::vec2(light.Position), tile_min, tile_min + LightTileSize);
+		glm::vec2 d = closest - glm::vec2(light.Position);
+		return glm::dot(d, d) <= light.Position.w * light.Position.w;
+	};
+
+	std::vector<GLuint>& grid = Batch_Data.LightGrid;
+	size_t header = (size_t)tiles_x * tiles_y * 2;
+	grid.assign(header, 0);
+
+	// Count lights per tile, then turn the counts into offsets
+	for (const LightData& light : lights) {
+		glm::ivec2 min, max;
+		tile_range(light, min, max);
+		for (int y = min.y; y <= max.y; ++y)
+			for (int x = min.x; x <= max.x; ++x)
+				if (touches(light, x, y))
+					++grid[((size_t)y * tiles_x + x) * 2 + 1];
+	}
+	GLuint offset = (GLuint)header;
+	for (size_t t = 0; t < header; t += 2) {
+		grid[t] = offset;
+		offset += grid[t + 1];
+		grid[t + 1] = 0;
+	}
+
+	grid.resize(offset);
+	for (size_t i = 0; i < lights.size(); ++i) {
+		glm::ivec2 min, max;
+		tile_range(lights[i], min, max);
+		for (int y = min.y; y <= max.y; ++y)
+			for (int x = min.x; x <= max.x; ++x)
+				if (touches(lights[i], x, y)) {
+					size_t t = ((size_t)y * tiles_x + x) * 2;
+					grid[grid[t] + grid[t + 1]++] = (GLuint)i;
+				}
+	}
+
+	Upload_StorageBuffer(Batch_Data.LightDataSSBO, Batch_Data.LightDataCapacity, LightDataBinding, lights.data(), (GLsizeiptr)(lights.size() * sizeof(LightData)));
+	Upload_StorageBuffer(Batch_Data.LightGridSSBO, Batch_Data.LightGridCapacity, LightGridBinding, grid.data(), (GLsizeiptr)(grid.size() * sizeof(GLuint)));
+	glNamedBufferSubData(Batch_Data.LightUBO, 0, sizeof(LightBlock), &block);
+	Batch_Data.Stats.BytesUploaded += sizeof(LightBlock);
+	Batch_Data.LightsDirty = false;
+	RenderStats::End(RenderStats::Lights);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Deletes the baked static buffers.
+*/
+/**************************************************************************/
+void Delete_StaticChunks() {
+	for (StaticChunk& chunk : Batch_Data.StaticChunks) {
+		glDeleteVertexArrays(1, &chunk.VAO);
+		glDeleteBuffers(1, &chunk.VBO);
+	}
+	Batch_Data.StaticChunks.clear();
+}
+/**************************************************************************/
+/*!
+  \brief
+	Uploads baked vertices into an immutable buffer with its own vertex array,
+	sharing the batch's index buffer.
+*/
+/**************************************************************************/
+void Upload_StaticChunk(StaticChunk& chunk, const std::vector<QuadVertex>& vertices) {
+	glCreateBuffers(1, &chunk.VBO);
+	glNamedBufferStorage(chunk.VBO, (GLsizeiptr)(vertices.size() * sizeof(QuadVertex)), vertices.data(), 0);
+	Batch_Data.Stats.BytesUploaded += vertices.size() * sizeof(QuadVertex);
+	chunk.IndexCount = (GLsizei)(vertices.size() / 4 * 6);
+
+	glCreateVertexArrays(1, &chunk.VAO);
+	glBindVertexArray(chunk.VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+	Set_QuadAttribs(chunk.VAO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Batch_Data.QuadIBO);
+	glBindVertexArray(0);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Draw all current Quads and/or Lines called using draw calls.
+
+  \param reason
+	Why the batch is drawn now, counted if anything was drawn.
+*/
+/**************************************************************************/
+void Flush_Batch(Batch::FlushReason reason) {
+	const BatchPass& pass = *Batch_Data.Drawing;
+	UpdateCameraBlock(pass.Camera);
+	Batch::Stats& stats = Batch_Data.Stats;
+	if (Batch_Data.QuadIndexCount || Batch_Data.SpriteCount || Batch_Data.LineIndexCount)
+		++stats.Flushes[reason];
+
+	if (Batch_Data.QuadIndexCount || Batch_Data.SpriteCount) {
+		UpdateLightBlock(pass.Camera);
+		for (GLuint i = 0; i < Batch_Data.TextureSlotIndex; ++i)
+			glBindTextureUnit(i, Batch_Data.TextureSlots[i]);
+		stats.TextureBinds += Batch_Data.TextureSlotIndex;
+
+		if (Batch_Data.QuadIndexCount) {
+			Batch::quad_shader_program.Use();
+			glBindVertexArray(Batch_Data.QuadVAO);
+			glDrawElementsBaseVertex(GL_TRIANGLES, Batch_Data.QuadIndexCount, GL_UNSIGNED_INT, nullptr, (GLint)(Batch_Data.QuadStream.Region * MaxVert));
+			Stream_End(Batch_Data.QuadStream);
+			++stats.DrawCalls;
+			stats.Quads += Batch_Data.QuadIndexCount / 6;
+		}
+
+		if (Batch_Data.SpriteCount) {
+			Batch::sprite_shader_program.Use();
+			glBindVertexArray(Batch_Data.SpriteVAO);
+			glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, Batch_Data.SpriteCount, (GLuint)(Batch_Data.SpriteStream.Region * MaxQuads));
+			Stream_End(Batch_Data.SpriteStream);
+			++stats.DrawCalls;
+			stats.Quads += Batch_Data.SpriteCount;
+		}
+
+		Batch_Data.QuadIndexCount = 0;
+		Batch_Data.SpriteCount = 0;
+		Batch_Data.TextureSlotIndex = 1;
+		BeginBatchRegion();
+	}
+	
+	if (Batch_Data.LineIndexCount) {
+		Batch::line_shader_program.Use();
+		glBindVertexArray(Batch_Data.LineVAO);
+		glLineWidth(pass.LineWidth);
+		glDrawArrays(GL_LINES, 0, Batch_Data.LineIndexCount);
+		++stats.DrawCalls;
+
+		Batch_Data.LineIndexCount = 0;
+	}
+}
+/**************************************************************************/
+/*!
+  \brief
+	Replaces the baked static buffers. Opaque quads are sorted the same way
+	as a pass and split into buffers of up to MaxTextures textures and
+	MaxQuads quads, each buffer one draw call. Textured quads are opaque
+	when their texture has no blended texels. Translucent quads are kept
+	aside to be sorted into each pass, as drawing them ahead of the queue
+	with depth writes on would hide what is behind them.
+
+  \param queue
+	Quads recorded between BeginStatic and EndStatic.
+*/
+/**************************************************************************/
+void Bake_StaticChunks(RenderQueue& queue) {
+	Delete_StaticChunks();
+	Batch_Data.StaticTranslucent.Clear();
+	queue.Sort();
+
+	std::vector<QuadVertex> vertices;
+	StaticChunk chunk;
+	chunk.Textures[0] = Batch_Data.WhiteTexture;
+
+	for (size_t i = 0; i < queue.Size(); ++i) {
+		const RenderQueue::Quad& q = queue[i];
+		if (RenderQueue::IsTranslucent(queue.GetKey(i))) {
+			Batch_Data.StaticTranslucent.Submit(queue.GetKey(i), q);
+			continue;
+		}
+
+		GLuint slot = 0;
+		if (q.texid) {
+			for (slot = 1; slot < chunk.TextureCount; ++slot) {
+				if (chunk.Textures[slot] == q.texid)
+					break;
+			}
+		}
+
+		bool full = vertices.size() / 4 >= MaxQuads || (slot == chunk.TextureCount && slot >= MaxTextures);
+		if (full) {
+			Upload_StaticChunk(chunk, vertices);
+			Batch_Data.StaticChunks.push_back(chunk);
+			vertices.clear();
+			chunk = StaticChunk{};
+			chunk.Textures[0] = Batch_Data.WhiteTexture;
+			slot = q.texid ? 1 : 0;
+		}
+		if (q.texid && slot == chunk.TextureCount)
+			chunk.Textures[chunk.TextureCount++] = q.texid;
+
+		vertices.resize(vertices.size() + 4);
+		float index = q.edge > 0.f ? (float)slot + (float)MaxTextures + q.edge : (float)slot;
+		WriteQuadVertices(&vertices[vertices.size() - 4], q.pos, q.size, q.angle, q.uv_start, q.uv_end, q.clr, index);
+	}
+
+	if (!vertices.empty()) {
+		Upload_StaticChunk(chunk, vertices);
+		Batch_Data.StaticChunks.push_back(chunk);
+	}
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draws the baked static quads, one draw call per buffer. Nothing is
+	uploaded except the camera and light blocks.
+*/
+/**************************************************************************/
+void Draw_StaticChunks() {
+	if (Batch_Data.StaticChunks.empty())
+		return;
+
+	UpdateCameraBlock(Batch_Data.Drawing->Camera);
+	UpdateLightBlock(Batch_Data.Drawing->Camera);
+	Batch::quad_shader_program.Use();
+	for (const StaticChunk& chunk : Batch_Data.StaticChunks) {
+		for (GLuint i = 0; i < chunk.TextureCount; ++i)
+			glBindTextureUnit(i, chunk.Textures[i]);
+		glBindVertexArray(chunk.VAO);
+		glDrawElements(GL_TRIANGLES, chunk.IndexCount, GL_UNSIGNED_INT, nullptr);
+
+		Batch_Data.Stats.TextureBinds += chunk.TextureCount;
+		Batch_Data.Stats.Quads += chunk.IndexCount / 6;
+		++Batch_Data.Stats.DrawCalls;
+	}
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draws a recorded pass: the opaque baked quads if asked for, then the
+	queue sorted by layer, depth and texture with the static translucent
+	quads in it, then the lines. Runs on the thread
+	that owns the OpenGL context.
+
+  \param pass
+	Pass to draw. Its lights are swapped out.
+*/
+/**************************************************************************/
+void Submit_Pass(BatchPass& pass) {
+	Batch_Data.Drawing = &pass;
+	Batch_Data.QuadIndexCount = 0;
+	Batch_Data.SpriteCount = 0;
+	BeginBatchRegion();
+
+	Batch_Data.lightPositions.swap(pass.LightPositions);
+	Batch_Data.lightColors.swap(pass.LightColors);
+	Batch_Data.lightIntensities.swap(pass.LightIntensities);
+	Batch_Data.LightsDirty = true;
+
+	if (pass.Static) {
+		Draw_StaticChunks();
+		const RenderQueue& translucent = Batch_Data.StaticTranslucent;
+		for (size_t i = 0; i < translucent.Size(); ++i)
+			pass.Queue.Submit(translucent.GetKey(i), translucent[i]);
+	}
+
+	pass.Queue.Sort();
+	for (size_t i = 0; i < pass.Queue.Size(); ++i) {
+		const RenderQueue::Quad& q = pass.Queue[i];
+		FlushIfFull(q.texid != 0);
+		// quad.frag reads slots past MaxTextures as text, with the edge in the fraction
+		float index = q.texid ? GetTextureIndex(q.texid) : 0.f;
+		SubmitQuad(q.pos, q.size, q.angle, q.uv_start, q.uv_end, q.clr, q.edge > 0.f ? index + (float)MaxTextures + q.edge : index, q.anim);
+	}
+
+	// Lines go with the last quads, MaxVert at a time
+	size_t line = 0;
+	do {
+		size_t count = pass.Lines.size() - line;
+		count = count < MaxVert ? count : MaxVert;
+		std::copy(pass.Lines.begin() + line, pass.Lines.begin() + line + count, Batch_Data.LineBuffer);
+		Batch_Data.LineBufferPtr = Batch_Data.LineBuffer + count;
+		Batch_Data.LineIndexCount = (GLuint)count;
+		line += count;
+
+		UploadBatch();
+		Flush_Batch(line < pass.Lines.size() ? Batch::LinesFull : Batch::EndOfPass);
+	} while (line < pass.Lines.size());
+
+	Batch_Data.Drawing = nullptr;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Initialize all things required to run BatchRendering.
+*/
+/**************************************************************************/
+void Batch::Init() {
+	Create_QuadBuffer();
+	Create_LineBuffer();
+	Create_SpriteBuffer();
+	Create_UniformBuffers();
+	Batch_Data.Instanced = sprite_shader_program.IsLinked() == GL_TRUE;
+
+	int samplers[32];
+	for (size_t i = 0; i < 32; ++i)
+		samplers[i] = (int)i;
+
+	glUseProgram(Batch::quad_shader_program.GetHandle());
+	glUniform1iv(Batch::quad_shader_program.GetUniformLocation("uTex2d"), 32, samplers);
+
+	if (Batch_Data.Instanced) {
+		glUseProgram(Batch::sprite_shader_program.GetHandle());
+		glUniform1iv(Batch::sprite_shader_program.GetUniformLocation("uTex2d"), 32, samplers);
+	}
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_TRUE);
+	glDepthFunc(GL_LEQUAL);
+	glDepthRange(0.f, 1.f);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Free-ing of memory used in BatchRendering
+*/
+/**************************************************************************/
+void Batch::Cleanup() {
+	glDeleteVertexArrays(1, &Batch_Data.QuadVAO);
+	Delete_StreamBuffer(Batch_Data.QuadStream);
+	glDeleteBuffers(1, &Batch_Data.QuadIBO);
+	glDeleteTextures(1, &Batch_Data.WhiteTexture);
+
+	glDeleteVertexArrays(1, &Batch_Data.SpriteVAO);
+	Delete_StreamBuffer(Batch_Data.SpriteStream);
+
+	Delete_StaticChunks();
+	Batch_Data.StaticTranslucent.Clear();
+
+	glDeleteVertexArrays(1, &Batch_Data.LineVAO);
+	glDeleteBuffers(1, &Batch_Data.LineVBO);
+
+	glDeleteBuffers(1, &Batch_Data.CameraUBO);
+	glDeleteBuffers(1, &Batch_Data.FrameUBO);
+	glDeleteBuffers(1, &Batch_Data.LightUBO);
+	glDeleteBuffers(1, &Batch_Data.LightDataSSBO);
+	glDeleteBuffers(1, &Batch_Data.LightGridSSBO);
+
+	if (!Batch_Data.QuadStream.Mapped)
+		delete[] Batch_Data.QuadBuffer;
+	if (!Batch_Data.SpriteStream.Mapped)
+		delete[] Batch_Data.SpriteBuffer;
+	delete[] Batch_Data.LineBuffer;
+
+	Batch_Data.Recording = nullptr;
+	Batch_Data.FreePasses.clear();
+	Batch_Data.Passes.clear();
+}
+/**************************************************************************/
+/*!
+  \brief
+	Start recording a pass. Lights are set again every pass.
+*/
+/**************************************************************************/
+void Batch::StartBatch() {
+	if (Batch_Data.Recording)
+		Release_Pass(Batch_Data.Recording);
+	Batch_Data.Recording = Acquire_Pass();
+	Batch_Data.Layer = RenderQueue::World;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Close the pass, keeping the camera and line width it is drawn with.
+*/
+/**************************************************************************/
+void Batch::EndBatch() {
+	BatchPass& pass = Record_Pass();
+	pass.Camera = Batch::camera.GetCameraPosition();
+	pass.LineWidth = Batch_Data.LineWidth;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Hand the pass to the render thread, which sorts the quads by layer, depth
+	and texture, uploads and draws them. Runs right away when rendering is
+	not threaded.
+*/
+/**************************************************************************/
+void Batch::Flush() {
+	if (!Batch_Data.Recording)
+		return;
+
+	BatchPass* pass = Batch_Data.Recording;
+	Batch_Data.Recording = nullptr;
+	RenderThread::Submit([pass] {
+		Submit_Pass(*pass);
+		Release_Pass(pass);
+	});
+}
+/**************************************************************************/
+/*!
+  \brief
+	Start baking static quads. Draw calls made until EndStatic are kept
+	instead of being batched this frame.
+*/
+/**************************************************************************/
+void Batch::BeginStatic() {
+	Batch_Data.StaticQueue.Clear();
+	Batch_Data.Baking = true;
+	Batch_Data.StaticDirty = false;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Hands the baked quads to the render thread, which replaces the last bake
+	with them.
+*/
+/**************************************************************************/
+void Batch::EndStatic() {
+	Batch_Data.Baking = false;
+	std::shared_ptr<RenderQueue> queue = std::make_shared<RenderQueue>(std::move(Batch_Data.StaticQueue));
+	Batch_Data.StaticQueue.Clear();
+	RenderThread::Submit([queue] { Bake_StaticChunks(*queue); });
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw the baked static quads with this pass, the opaque ones first and
+	the translucent ones sorted in with the rest.
+*/
+/**************************************************************************/
+void Batch::DrawStatic() {
+	Record_Pass().Static = true;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Flags the static quads as out of date, to be baked again.
+*/
+/**************************************************************************/
+void Batch::InvalidateStatic() {
+	Batch_Data.StaticDirty = true;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Whether the static quads need to be baked again.
+*/
+/**************************************************************************/
+bool Batch::IsStaticDirty() {
+	return Batch_Data.StaticDirty;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw a Colored Quad.
+
+  \param pos
+	Position(x,y,z) in screen space of quad to draw.
+
+  \param size
+	Size(x,y) of quad to draw.
+
+  \param scale
+	Scale(x,y) of quad to draw.
+
+  \param clr
+	Color(r,g,b,a) of quad to draw.
+*/
+/**************************************************************************/
+void Batch::DrawQuad(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, const glm::vec4& clr, const float& angle_in_degree) {
+	Enqueue(pos, size * scale / 100.f, angle_in_degree, { 0.f, 0.f }, { 1.f, 1.f }, clr, 0);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw a Textured Quad.
+
+  \param pos
+	Position(x,y,z) in screen space of quad to draw.
+
+  \param size
+	Size(x,y) of quad to draw.
+
+  \param scale
+	Scale(x,y) of quad to draw.
+
+  \param texid
+	Texture of quad to draw.
+*/
+/**************************************************************************/
+void Batch::DrawQuad(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const float& angle_in_degree) {
+	Enqueue(pos, size * scale / 100.f, angle_in_degree, { 0.f, 0.f }, { 1.f, 1.f }, { 1.f, 1.f, 1.f, 1.f }, texid);
+}
+
+void Batch::DrawQuadWithUV(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const glm::vec2& uv_start, const glm::vec2& uv_end, const float& angle_in_degree) {
+	Enqueue(pos, size * scale / 100.f, angle_in_degree, uv_start, uv_end, { 1.f, 1.f, 1.f, 1.f }, texid);
+}
+
+void Batch::DrawQuadWithPixelCoords(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const glm::vec2& uv_start, const glm::vec2& uv_end, const glm::vec2 texsize, const glm::vec4 clr, const float& angle_in_degree, const glm::vec2& atlas_min, const glm::vec2& atlas_max, bool opaque) {
+	glm::vec2 start = atlas_min + glm::vec2{ uv_start.x / texsize.x, uv_start.y / texsize.y } * (atlas_max - atlas_min);
+	glm::vec2 end = atlas_min + glm::vec2{ uv_end.x / texsize.x, uv_end.y / texsize.y } * (atlas_max - atlas_min);
+
+	Enqueue(pos, size * scale / 100.f, angle_in_degree, start, end, clr, texid, 0.f, {}, opaque);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw a Colored Line.
 
   \param p0
 	Start position(x,y,z) of line to draw.
@@ -553,33 +1374,9 @@ void Batch::DrawQuadWithPixelCoords(const glm::vec3& pos, const glm::vec2& size,
 */
 /**************************************************************************/
 void Batch::DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& clr) {
-	if (Batch_Data.LineIndexCount >= MaxIndex) {
-		EndBatch();
-		Flush();
-		StartBatch();
-	}
-
-	Batch_Data.LineBufferPtr->Position = p0;
-	Batch_Data.LineBufferPtr->Color = clr;
-	++Batch_Data.LineBufferPtr;
-
-	Batch_Data.LineBufferPtr->Position = p1;
-	Batch_Data.LineBufferPtr->Color = clr;
-	++Batch_Data.LineBufferPtr;
-
-	Batch_Data.LineIndexCount += 2;
-
-	glm::mat4 s = glm::scale(glm::mat4(1.f), { 1.f,1.f,1.f });
-	glm::mat4 device(1.f / GLSetup::width, 0.f, 0.f, 0.f,
-		0.f, 1.f / GLSetup::height, 0.f, 0.f,
-		0.f, 0.f, 1.f, 0.f,
-		0.f, 0.f, 0.f, 1.f);
-	glm::mat4 transform = device * s;
-
-	line_shader_program.Use();
-	GLuint loc = glGetUniformLocation(line_shader_program.GetHandle(), "uTransform");
-	if (loc >= 0)
-		glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(transform));
+	std::vector<LineVertex>& lines = Record_Pass().Lines;
+	lines.push_back({ p0, clr });
+	lines.push_back({ p1, clr });
 }
 /**************************************************************************/
 /*!
@@ -614,56 +1411,38 @@ void Batch::DrawBox(const glm::vec3& pos, const glm::vec2& size, const glm::vec2
 }
 
 void Batch::DrawSprite(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const glm::vec2& texcoords, glm::vec2& texsize, const glm::vec4 clr, const float& angle_in_degree) {
-	if (Batch_Data.QuadIndexCount >= MaxIndex || Batch_Data.TextureSlotIndex > 31) {
-		EndBatch();
-		Flush();
-		StartBatch();
-	}
-
-	float TexIndex = 0.f;
-	for (GLuint i = 0; i < Batch_Data.TextureSlotIndex; ++i)
-	{
-		if (Batch_Data.TextureSlots[i] == texid) {
-			TexIndex = (float)i;
-			break;
-		}
-	}
-
-	if (TexIndex == 0.f && Batch_Data.TextureSlotIndex < 32) {
-		TexIndex = (float)Batch_Data.TextureSlotIndex;
-		Batch_Data.TextureSlots[Batch_Data.TextureSlotIndex] = texid;
-		++Batch_Data.TextureSlotIndex;
-	}
-
-	glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(pos))
-		* glm::rotate(glm::mat4(1.f), angle_in_degree, glm::vec3(0.f, 0.f, 1.f))
-		* glm::scale(glm::mat4(1.f), glm::vec3(size * scale / 100.f, 1.f));
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { texcoords.x, texcoords.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f, -0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { texcoords.x + texsize.x, texcoords.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ 0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { texcoords.x + texsize.x, texcoords.y + texsize.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadBufferPtr->Position = transform * glm::vec4{ -0.5f,  0.5f, 0.0f, 1.f };
-	Batch_Data.QuadBufferPtr->Color = clr;
-	Batch_Data.QuadBufferPtr->TexCoords = { texcoords.x, texcoords.y + texsize.y };
-	Batch_Data.QuadBufferPtr->TexIndex = TexIndex;
-	++Batch_Data.QuadBufferPtr;
-
-	Batch_Data.QuadIndexCount += 6;
+	Enqueue(pos, size * scale / 100.f, angle_in_degree, texcoords, texcoords + texsize, clr, texid);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw a sprite animation, its frame is picked on the GPU. Animations
+	played once are sent with a negative frame count.
+*/
+/**************************************************************************/
+void Batch::DrawAnimatedSprite(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const glm::vec2& texcoords, const glm::vec2& texsize,
+	const Flipbook& flipbook, const glm::vec4 clr, const float& angle_in_degree) {
+	float frames = (float)(flipbook.Loop ? flipbook.Frames : -flipbook.Frames);
+	glm::vec4 anim{ flipbook.Start, flipbook.FrameDuration > 0.f ? flipbook.FrameDuration : 0.1f, frames, (float)(flipbook.FramesPerRow > 0 ? flipbook.FramesPerRow : 1) };
+	Enqueue(pos, size * scale / 100.f, angle_in_degree, texcoords, texcoords + texsize, clr, texid, 0.f, anim);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw one unlit glyph of a string from a font's distance field atlas.
+*/
+/**************************************************************************/
+void Batch::DrawGlyph(const glm::vec3& pos, const glm::vec2& size, GLuint texid, const glm::vec2& uv_start, const glm::vec2& uv_end, const glm::vec4& clr, float edge) {
+	Enqueue(pos, size, 0.f, uv_start, uv_end, clr, texid, edge < 0.05f ? 0.05f : (edge > 0.95f ? 0.95f : edge));
+}
+/**************************************************************************/
+/*!
+  \brief
+	Set the render layer of quads drawn after this call.
+*/
+/**************************************************************************/
+void Batch::SetLayer(uint8_t layer) {
+	Batch_Data.Layer = layer;
 }
 /**************************************************************************/
 /*!
@@ -677,25 +1456,58 @@ void Batch::DrawSprite(const glm::vec3& pos, const glm::vec2& size, const glm::v
 void Batch::SetLineWidth(float width) {
 	Batch_Data.LineWidth = width;
 }
+/**************************************************************************/
+/*!
+  \brief
+	Add lights to the batch. There is no light limit, lights are culled
+	per screen tile when the batch is drawn.
 
+  \param pointlights
+	Lights to add.
+*/
+/**************************************************************************/
 void Batch::SetLight(std::vector<Lighting::PointLight> pointlights) {
-	if (Batch_Data.lightPositions.size() > 31 || Batch_Data.lightColors.size() > 31 || Batch_Data.lightIntensities.size() > 31) {
-		EndBatch();
-		Flush();
-		StartBatch();
-	}	
-
+	BatchPass& pass = Record_Pass();
 	for (const auto& pointlight : pointlights)
 	{
-		if (Batch_Data.lightPositions.size() > 31 || Batch_Data.lightColors.size() > 31 || Batch_Data.lightIntensities.size() > 31) {
-			EndBatch();
-			Flush();
-			StartBatch();
-		}
-
-		Batch_Data.lightPositions.push_back(pointlight.Pos);
-		Batch_Data.lightColors.push_back(pointlight.Color);
-		Batch_Data.lightIntensities.push_back(pointlight.LightIntensity);
+		pass.LightPositions.push_back(pointlight.Pos);
+		pass.LightColors.push_back(pointlight.Color);
+		pass.LightIntensities.push_back(pointlight.LightIntensity);
 	}
 }
+/**************************************************************************/
+/*!
+  \brief
+	Advance the frame block's time, read by shaders as uTime and uDeltaTime.
+*/
+/**************************************************************************/
+void Batch::SetFrameTime(float dt) {
+	Batch_Data.Clock += dt;
+	RenderThread::Submit([time = Batch_Data.Clock, dt] {
+		Batch_Data.Frame.Time = time;
+		Batch_Data.Frame.DeltaTime = dt;
+		glNamedBufferSubData(Batch_Data.FrameUBO, 0, sizeof(FrameBlock), &Batch_Data.Frame);
+		Batch_Data.Stats.BytesUploaded += sizeof(FrameBlock);
+	});
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gets the time advanced by SetFrameTime, on the recording side.
+*/
+/**************************************************************************/
+float Batch::GetClock() {
+	return Batch_Data.Clock;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gets the work counted since the last call and starts counting again.
+*/
+/**************************************************************************/
+Batch::Stats Batch::TakeStats() {
+	Stats stats = Batch_Data.Stats;
+	Batch_Data.Stats = Stats{};
+	return stats;
+}
 
@@ -20,10 +20,49 @@
 #include <string>
 #include <Graphics/GLFWsetup.h>
 #include <Graphics/Camera.h>
+#include <Graphics/RenderQueue.h>
 #include <Lighting/Lighting.h>
 
 class Batch {
 public:
+	// Why a batch was drawn
+	enum FlushReason : uint8_t {
+		QuadsFull = 0,		// no room for another quad
+		TexturesFull,		// no free texture slot
+		LinesFull,			// no room for another line
+		EndOfPass,			// the pass is done
+		FlushReasonCount
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Work done by the batch renderer, counted on the thread that draws.
+	*/
+	/**************************************************************************/
+	struct Stats {
+		uint32_t DrawCalls = 0;
+		uint32_t Flushes[FlushReasonCount]{};
+		uint32_t Quads = 0;				// batched and baked
+		uint32_t TextureBinds = 0;
+		uint64_t BytesUploaded = 0;		// vertex, uniform and storage data
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Timeline of an animated sprite. The frame shown is picked from it on
+		the GPU each frame, so a looping sprite needs no CPU update.
+	*/
+	/**************************************************************************/
+	struct Flipbook {
+		float Start = 0.f;			// GetClock time frame 0 was shown
+		float FrameDuration = 0.1f;	// seconds per frame
+		int Frames = 1;				// frames in the loop, row by row
+		int FramesPerRow = 1;
+		bool Loop = true;			// false holds the last frame once it is reached
+	};
+
 	/**************************************************************************/
 	/*!
 	  \brief
@@ -42,25 +81,71 @@ public:
 	/**************************************************************************/
 	/*!
 	  \brief
-		Setting all pointers to start of the batch.
+		Start recording a pass. Lights are set again every pass.
 	*/
 	/**************************************************************************/
 	static void StartBatch();
 	/**************************************************************************/
 	/*!
 	  \brief
-		Binding all required buffers to send to GPU for drawing.
+		Close the pass, keeping the camera and line width it is drawn with.
 	*/
 	/**************************************************************************/
 	static void EndBatch();
 	/**************************************************************************/
 	/*!
 	  \brief
-		Draw all current Quads and/or Lines called using draw calls.
+		Hand the pass to the render thread, which sorts the quads by layer,
+		depth and texture, uploads and draws them. Runs right away when
+		rendering is not threaded.
 	*/
 	/**************************************************************************/
 	static void Flush();
 
+	/**************************************************************************/
+	/*!
+	  \brief
+		Start baking static quads. Quads drawn until EndStatic are kept in
+		immutable buffers instead of the pass, replacing the last bake.
+	*/
+	/**************************************************************************/
+	static void BeginStatic();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Hands the baked quads to the render thread, which sorts and uploads
+		the opaque ones, up to MaxTextures textures per buffer so each buffer
+		is drawn with one call. Translucent quads are kept to be sorted into
+		each pass instead.
+	*/
+	/**************************************************************************/
+	static void EndStatic();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Draw the baked static quads with the pass, the opaque ones before the
+		queue and the translucent ones sorted into it. Call every frame
+		between StartBatch and EndBatch.
+	*/
+	/**************************************************************************/
+	static void DrawStatic();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Flags the static quads as out of date, to be baked again. Call when
+		objects are added or removed or something that may be baked changes.
+	*/
+	/**************************************************************************/
+	static void InvalidateStatic();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Whether the static quads were flagged out of date since the last
+		BeginStatic.
+	*/
+	/**************************************************************************/
+	static bool IsStaticDirty();
+
 	/**************************************************************************/
 	/*!
 	  \brief
@@ -164,10 +249,21 @@ public:
 
 	  \param angle_in_degree
 		rotation of angle in degree of texture.
+
+	  \param atlas_min
+		UV min of the image's region in texid, when texid is an atlas page.
+
+	  \param atlas_max
+		UV max of the image's region in texid, when texid is an atlas page.
+
+	  \param opaque
+		Texture has no blended texels, so the quad is drawn as opaque unless
+		clr is translucent.
 	*/
 	/**************************************************************************/
 	static void DrawQuadWithPixelCoords(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const glm::vec2& uv_start, const glm::vec2& uv_end,
-		const glm::vec2 texsize, const glm::vec4 clr = {1,1,1,1}, const float& angle_in_degree = 0);
+		const glm::vec2 texsize, const glm::vec4 clr = {1,1,1,1}, const float& angle_in_degree = 0, const glm::vec2& atlas_min = { 0.f, 0.f }, const glm::vec2& atlas_max = { 1.f, 1.f },
+		bool opaque = false);
 	/**************************************************************************/
 	/*!
 	  \brief
@@ -232,6 +328,84 @@ public:
 	/**************************************************************************/
 	static void DrawSprite(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const glm::vec2& texcoords, glm::vec2& texsize, const glm::vec4 clr = {1.f, 1.f, 1.f, 1.f}, const float& angle_in_degree = 0);
 	/**************************************************************************/
+	/*!
+	  \brief
+		Draw a looping sprite animation. sprite.vert offsets the first frame's
+		UVs by the frame reached at uTime, frames being laid out row by row
+		one frame size apart.
+
+	  \param pos
+		Position(x,y,z) in screen space of quad to draw.
+
+	  \param size
+		Size(x,y) of quad to draw.
+
+	  \param scale
+		Scale(x,y) of quad to draw.
+
+	  \param texid
+		Sprite sheet of quad to draw.
+
+	  \param texcoords
+		UV of the first frame.
+
+	  \param texsize
+		UV size of one frame.
+
+	  \param flipbook
+		Timeline of the animation.
+
+	  \param clr
+		Tint color of texture.
+
+	  \param angle_in_degree
+		rotation of angle in degree of texture.
+	*/
+	/**************************************************************************/
+	static void DrawAnimatedSprite(const glm::vec3& pos, const glm::vec2& size, const glm::vec2& scale, GLuint texid, const glm::vec2& texcoords, const glm::vec2& texsize,
+		const Flipbook& flipbook, const glm::vec4 clr = { 1.f, 1.f, 1.f, 1.f }, const float& angle_in_degree = 0);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Draw one glyph of a string from a font's distance field atlas. Glyphs
+		are not lit, so text keeps the color it was given.
+
+	  \param pos
+		Position(x,y,z) of the glyph's center.
+
+	  \param size
+		Final size(x,y) of the glyph.
+
+	  \param texid
+		Glyph atlas of the font.
+
+	  \param uv_start
+		UV of the bottom left corner.
+
+	  \param uv_end
+		UV of the top right corner.
+
+	  \param clr
+		Color(r,g,b,a) of the text.
+
+	  \param edge
+		Distance treated as the glyph's outline, 0.5 is the real outline and
+		lower values grow the glyph, for outlines and shadows.
+	*/
+	/**************************************************************************/
+	static void DrawGlyph(const glm::vec3& pos, const glm::vec2& size, GLuint texid, const glm::vec2& uv_start, const glm::vec2& uv_end, const glm::vec4& clr, float edge = 0.5f);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Set the render layer of quads drawn after this call. StartBatch resets
+		it to RenderQueue::World.
+
+	  \param layer
+		RenderQueue::World, RenderQueue::UI or RenderQueue::Overlay.
+	*/
+	/**************************************************************************/
+	static void SetLayer(uint8_t layer);
+	/**************************************************************************/
 	/*!
 	  \brief
 		Set the width of line drawn.
@@ -244,17 +418,49 @@ public:
 	/**************************************************************************/
 	/*!
 	  \brief
-		Set lights position, color and intensity.
+		Add lights to the batch. There is no light limit, lights are culled
+		against 32x32 screen tiles and lit within a radius set by intensity.
 
 	  \param pointlights
-		Lights to set.
+		Lights to add.
 	*/
 	/**************************************************************************/
 	static void SetLight(std::vector<Lighting::PointLight> pointlights);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Advance the time in the frame uniform block. Call once per frame.
+
+	  \param dt
+		Delta time.
+	*/
+	/**************************************************************************/
+	static void SetFrameTime(float dt);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the time advanced by SetFrameTime, in seconds. It is the uTime
+		the frame being recorded is drawn with, so flipbooks started from it
+		line up with the GPU.
+	*/
+	/**************************************************************************/
+	static float GetClock();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the work counted since the last call and starts counting again.
+		Call with the OpenGL context current, once per frame.
+
+	  \return
+		Counters of the frame just drawn.
+	*/
+	/**************************************************************************/
+	static Stats TakeStats();
 
 	//Variable
 	static GLSLShader quad_shader_program;
 	static GLSLShader line_shader_program;
+	static GLSLShader sprite_shader_program;	// Instanced quads, quad_shader_program is used if it fails to link
 	static Camera camera;
 };
 
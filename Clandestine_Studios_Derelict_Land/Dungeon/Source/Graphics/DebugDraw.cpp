@@ -0,0 +1,487 @@
+/******************************************************************************/
+/*!
+\file    DebugDraw.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Immediate mode debug shapes for gizmos, collider boxes and anything
+		 else worth seeing while tuning a level. Lines, rectangles and
+		 circles are kept as one 32 byte instance each and drawn on top of
+		 the frame with a single instanced call, debug.vert expanding each
+		 one to a quad and debug.frag cutting out its outline. Labels are
+		 queued into the sprite batch as text.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/DebugDraw.h>
+
+#ifndef DISABLE_DEBUG_DRAW
+#include <Graphics/BatchRendering.h>
+#include <Graphics/Fonts.h>
+#include <Graphics/RenderThread.h>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+static const size_t InitialShapes = 1024;
+
+// Must match aKind in debug.vert
+enum ShapeKind : GLuint {
+	KindLine = 0,
+	KindRect,
+	KindCircle
+};
+
+// One record per shape, debug.vert expands it to a quad
+struct ShapeInstance
+{
+	glm::vec2 A;		// line start, or center
+	glm::vec2 B;		// line end, or half size
+	float Thickness;	// outline width, 0 fills rectangles and circles
+	float Angle;		// rectangle rotation in radians
+	GLuint Color;
+	GLuint Kind;
+};
+
+struct Shape
+{
+	ShapeInstance Instance;
+	float Lifetime;
+	uint32_t Category;
+};
+
+struct LabelEntry
+{
+	std::string Text;
+	glm::vec2 Position;
+	glm::vec4 Color;
+	float Scale;
+	float Lifetime;
+	uint32_t Category;
+};
+
+struct DebugDrawData
+{
+	GLuint VAO = 0;
+	GLuint VBO = 0;
+	GLsizeiptr Capacity = 0;
+
+	// Recording side, only used by the thread calling the Draw functions
+	std::vector<Shape> Shapes;
+	std::vector<LabelEntry> Labels;
+	const std::map<char, Character>* Font = nullptr;
+	size_t Drawn = 0;
+
+	// Instance lists handed to the render thread, returned once drawn
+	std::mutex FrameMutex;
+	std::vector<std::vector<ShapeInstance>> FreeFrames;
+};
+
+static DebugDrawData Debug_Draw_Data;
+GLSLShader DebugDraw::shader_program;
+uint32_t DebugDraw::Enabled = DebugDraw::AllCategories;
+
+/**************************************************************************/
+/*!
+  \brief
+	Packs a color into RGBA8, the same way the sprite batch does.
+*/
+/**************************************************************************/
+static GLuint Pack_Color(const glm::vec4& clr) {
+	glm::vec4 c = glm::clamp(clr, 0.f, 1.f) * 255.f + 0.5f;
+	return (GLuint)c.r | ((GLuint)c.g << 8) | ((GLuint)c.b << 16) | ((GLuint)c.a << 24);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Keeps a shape until its lifetime runs out.
+*/
+/**************************************************************************/
+static void Add_Shape(const ShapeInstance& instance, DebugDraw::Category category, float lifetime) {
+	Debug_Draw_Data.Shapes.push_back({ instance, lifetime, category });
+}
+/**************************************************************************/
+/*!
+  \brief
+	Takes an empty instance list, reusing one the render thread is done with.
+*/
+/**************************************************************************/
+static std::vector<ShapeInstance> Take_Frame() {
+	std::lock_guard<std::mutex> lock(Debug_Draw_Data.FrameMutex);
+	if (Debug_Draw_Data.FreeFrames.empty())
+		return {};
+	std::vector<ShapeInstance> frame = std::move(Debug_Draw_Data.FreeFrames.back());
+	Debug_Draw_Data.FreeFrames.pop_back();
+	return frame;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gives a drawn instance list back, emptied but keeping its memory.
+*/
+/**************************************************************************/
+static void Give_Frame(std::vector<ShapeInstance>& frame) {
+	frame.clear();
+	std::lock_guard<std::mutex> lock(Debug_Draw_Data.FrameMutex);
+	Debug_Draw_Data.FreeFrames.push_back(std::move(frame));
+}
+/**************************************************************************/
+/*!
+  \brief
+	Uploads the shapes of a frame and draws them with one instanced call,
+	over everything and with the camera block of the last pass. Runs on the
+	thread that owns the OpenGL context.
+*/
+/**************************************************************************/
+static void Draw_Shapes(const std::vector<ShapeInstance>& frame) {
+	GLsizeiptr size = (GLsizeiptr)(frame.size() * sizeof(ShapeInstance));
+	if (size > Debug_Draw_Data.Capacity) {
+		Debug_Draw_Data.Capacity = size * 2;
+		glNamedBufferData(Debug_Draw_Data.VBO, Debug_Draw_Data.Capacity, nullptr, GL_STREAM_DRAW);
+	}
+	glNamedBufferSubData(Debug_Draw_Data.VBO, 0, size, frame.data());
+
+	glDisable(GL_DEPTH_TEST);
+	DebugDraw::shader_program.Use();
+	glBindVertexArray(Debug_Draw_Data.VAO);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)frame.size());
+	glEnable(GL_DEPTH_TEST);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Creates the instance buffer. Every attribute advances once per instance,
+	the quad corners come from gl_VertexID in debug.vert.
+
+  \param font
+	Font labels are drawn with.
+*/
+/**************************************************************************/
+void DebugDraw::Init(const std::map<char, Character>& font) {
+	Debug_Draw_Data.Font = &font;
+	Debug_Draw_Data.Capacity = InitialShapes * sizeof(ShapeInstance);
+
+	glCreateBuffers(1, &Debug_Draw_Data.VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, Debug_Draw_Data.VBO);
+	glBufferData(GL_ARRAY_BUFFER, Debug_Draw_Data.Capacity, nullptr, GL_STREAM_DRAW);
+
+	glCreateVertexArrays(1, &Debug_Draw_Data.VAO);
+	glBindVertexArray(Debug_Draw_Data.VAO);
+
+	glEnableVertexArrayAttrib(Debug_Draw_Data.VAO, 0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ShapeInstance), (const void*)offsetof(ShapeInstance, A));
+	glVertexAttribDivisor(0, 1);
+
+	glEnableVertexArrayAttrib(Debug_Draw_Data.VAO, 1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(ShapeInstance), (const void*)offsetof(ShapeInstance, B));
+	glVertexAttribDivisor(1, 1);
+
+	glEnableVertexArrayAttrib(Debug_Draw_Data.VAO, 2);
+	glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(ShapeInstance), (const void*)offsetof(ShapeInstance, Thickness));
+	glVertexAttribDivisor(2, 1);
+
+	glEnableVertexArrayAttrib(Debug_Draw_Data.VAO, 3);
+	glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(ShapeInstance), (const void*)offsetof(ShapeInstance, Angle));
+	glVertexAttribDivisor(3, 1);
+
+	glEnableVertexArrayAttrib(Debug_Draw_Data.VAO, 4);
+	glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ShapeInstance), (const void*)offsetof(ShapeInstance, Color));
+	glVertexAttribDivisor(4, 1);
+
+	glEnableVertexArrayAttrib(Debug_Draw_Data.VAO, 5);
+	glVertexAttribIPointer(5, 1, GL_UNSIGNED_INT, sizeof(ShapeInstance), (const void*)offsetof(ShapeInstance, Kind));
+	glVertexAttribDivisor(5, 1);
+
+	glBindVertexArray(0);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Frees the instance buffer and every shape still alive.
+*/
+/**************************************************************************/
+void DebugDraw::Cleanup() {
+	glDeleteVertexArrays(1, &Debug_Draw_Data.VAO);
+	glDeleteBuffers(1, &Debug_Draw_Data.VBO);
+	Debug_Draw_Data.VAO = Debug_Draw_Data.VBO = 0;
+	Debug_Draw_Data.Capacity = 0;
+
+	Debug_Draw_Data.Shapes.clear();
+	Debug_Draw_Data.Labels.clear();
+	Debug_Draw_Data.FreeFrames.clear();
+	Debug_Draw_Data.Font = nullptr;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw a line.
+
+  \param p0
+	Start position(x,y) of the line.
+
+  \param p1
+	End position(x,y) of the line.
+
+  \param clr
+	Color(r,g,b,a) of the line.
+
+  \param category
+	Category of the line, nothing is recorded if it is switched off.
+
+  \param lifetime
+	Seconds the line stays after this frame.
+*/
+/**************************************************************************/
+void DebugDraw::Line(const glm::vec2& p0, const glm::vec2& p1, const glm::vec4& clr, Category category, float lifetime) {
+	ThickLine(p0, p1, DefaultThickness, clr, category, lifetime);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw a line of a given width.
+
+  \param p0
+	Start position(x,y) of the line.
+
+  \param p1
+	End position(x,y) of the line.
+
+  \param thickness
+	Width of the line, in pixels.
+
+  \param clr
+	Color(r,g,b,a) of the line.
+
+  \param category
+	Category of the line, nothing is recorded if it is switched off.
+
+  \param lifetime
+	Seconds the line stays after this frame.
+*/
+/**************************************************************************/
+void DebugDraw::ThickLine(const glm::vec2& p0, const glm::vec2& p1, float thickness, const glm::vec4& clr, Category category, float lifetime) {
+	if (!IsEnabled(category))
+		return;
+	Add_Shape({ p0, p1, thickness, 0.f, Pack_Color(clr), KindLine }, category, lifetime);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw a rectangle.
+
+  \param center
+	Position(x,y) of the rectangle's center.
+
+  \param size
+	Size(x,y) of the rectangle.
+
+  \param clr
+	Color(r,g,b,a) of the rectangle.
+
+  \param thickness
+	Width of the outline in pixels, 0 fills the rectangle.
+
+  \param angle_in_degree
+	Rotation of the rectangle about its center.
+
+  \param category
+	Category of the rectangle, nothing is recorded if it is switched off.
+
+  \param lifetime
+	Seconds the rectangle stays after this frame.
+*/
+/**************************************************************************/
+void DebugDraw::Rect(const glm::vec2& center, const glm::vec2& size, const glm::vec4& clr, float thickness, float angle_in_degree, Category category, float lifetime) {
+	if (!IsEnabled(category))
+		return;
+	Add_Shape({ center, size * 0.5f, thickness, glm::radians(angle_in_degree), Pack_Color(clr), KindRect }, category, lifetime);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw a circle.
+
+  \param center
+	Position(x,y) of the circle's center.
+
+  \param radius
+	Radius of the circle.
+
+  \param clr
+	Color(r,g,b,a) of the circle.
+
+  \param thickness
+	Width of the outline in pixels, 0 fills the circle.
+
+  \param category
+	Category of the circle, nothing is recorded if it is switched off.
+
+  \param lifetime
+	Seconds the circle stays after this frame.
+*/
+/**************************************************************************/
+void DebugDraw::Circle(const glm::vec2& center, float radius, const glm::vec4& clr, float thickness, Category category, float lifetime) {
+	if (!IsEnabled(category))
+		return;
+	Add_Shape({ center, { radius, radius }, thickness, 0.f, Pack_Color(clr), KindCircle }, category, lifetime);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw an arrow, a line with a head of two lines at its end.
+
+  \param from
+	Tail position(x,y) of the arrow.
+
+  \param to
+	Tip position(x,y) of the arrow.
+
+  \param clr
+	Color(r,g,b,a) of the arrow.
+
+  \param head
+	Length of the two lines of the head.
+
+  \param thickness
+	Width of the lines, in pixels.
+
+  \param category
+	Category of the arrow, nothing is recorded if it is switched off.
+
+  \param lifetime
+	Seconds the arrow stays after this frame.
+*/
+/**************************************************************************/
+void DebugDraw::Arrow(const glm::vec2& from, const glm::vec2& to, const glm::vec4& clr, float head, float thickness, Category category, float lifetime) {
+	if (!IsEnabled(category))
+		return;
+	ThickLine(from, to, thickness, clr, category, lifetime);
+
+	glm::vec2 d = to - from;
+	float length = glm::length(d);
+	if (length <= 0.f)
+		return;
+	// Head lines are 30 degrees either side of the shaft
+	glm::vec2 back = -d / length * head;
+	const float c = 0.8660254f, s = 0.5f;
+	ThickLine(to, to + glm::vec2(back.x * c - back.y * s, back.x * s + back.y * c), thickness, clr, category, lifetime);
+	ThickLine(to, to + glm::vec2(back.x * c + back.y * s, -back.x * s + back.y * c), thickness, clr, category, lifetime);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw a line of text at a position in the world.
+
+  \param pos
+	Position(x,y) of the start of the text's baseline.
+
+  \param text
+	Text to draw.
+
+  \param clr
+	Color(r,g,b,a) of the text.
+
+  \param scale
+	Size of the text, 1 is the font's size.
+
+  \param category
+	Category of the label, nothing is recorded if it is switched off.
+
+  \param lifetime
+	Seconds the label stays after this frame.
+*/
+/**************************************************************************/
+void DebugDraw::Label(const glm::vec2& pos, const std::string& text, const glm::vec4& clr, float scale, Category category, float lifetime) {
+	if (!IsEnabled(category))
+		return;
+	Debug_Draw_Data.Labels.push_back({ text, pos, clr, scale, lifetime, category });
+}
+/**************************************************************************/
+/*!
+  \brief
+	Queue the labels into the sprite batch. FontsRender places text from
+	the camera in window pixels, so the world position is moved into that
+	space first.
+*/
+/**************************************************************************/
+void DebugDraw::DrawLabels() {
+	if (Debug_Draw_Data.Labels.empty() || !Debug_Draw_Data.Font)
+		return;
+
+	glm::vec2 cam = Batch::camera.GetCameraPosition();
+	glm::vec2 to_window = { (float)FontsRender::WindowWidth / (float)GLSetup::width, (float)FontsRender::WindowHeight / (float)GLSetup::height };
+	for (const LabelEntry& label : Debug_Draw_Data.Labels) {
+		glm::vec2 pos = (label.Position - cam) * to_window;
+		FontsRender::RenderText(*Debug_Draw_Data.Font, label.Text, pos.x, pos.y, 0.9999f, label.Scale, glm::vec3(label.Color), label.Color.a);
+	}
+}
+/**************************************************************************/
+/*!
+  \brief
+	Draw the shapes over the pass just flushed, then drop those whose
+	lifetime ran out. A shape with no lifetime is drawn once.
+
+  \param dt
+	Delta time, taken off every lifetime.
+*/
+/**************************************************************************/
+void DebugDraw::Flush(float dt) {
+	Debug_Draw_Data.Drawn = Debug_Draw_Data.Shapes.size() + Debug_Draw_Data.Labels.size();
+	if (!Debug_Draw_Data.Drawn)
+		return;
+
+	if (!Debug_Draw_Data.Shapes.empty()) {
+		std::vector<ShapeInstance> frame = Take_Frame();
+		frame.reserve(Debug_Draw_Data.Shapes.size());
+		for (const Shape& shape : Debug_Draw_Data.Shapes)
+			frame.push_back(shape.Instance);
+		RenderThread::Submit([frame = std::move(frame)]() mutable {
+			Draw_Shapes(frame);
+			Give_Frame(frame);
+		});
+	}
+
+	Debug_Draw_Data.Shapes.erase(std::remove_if(Debug_Draw_Data.Shapes.begin(), Debug_Draw_Data.Shapes.end(),
+		[dt](Shape& shape) { shape.Lifetime -= dt; return shape.Lifetime < 0.f; }), Debug_Draw_Data.Shapes.end());
+	Debug_Draw_Data.Labels.erase(std::remove_if(Debug_Draw_Data.Labels.begin(), Debug_Draw_Data.Labels.end(),
+		[dt](LabelEntry& label) { label.Lifetime -= dt; return label.Lifetime < 0.f; }), Debug_Draw_Data.Labels.end());
+}
+/**************************************************************************/
+/*!
+  \brief
+	Switch a category on or off. Shapes of a category switched off are
+	dropped.
+
+  \param category
+	Category to switch.
+
+  \param enabled
+	Whether its shapes are recorded.
+*/
+/**************************************************************************/
+void DebugDraw::SetEnabled(Category category, bool enabled) {
+	Enabled = enabled ? Enabled | category : Enabled & ~category;
+	if (enabled)
+		return;
+
+	Debug_Draw_Data.Shapes.erase(std::remove_if(Debug_Draw_Data.Shapes.begin(), Debug_Draw_Data.Shapes.end(),
+		[category](const Shape& shape) { return (shape.Category & category) != 0; }), Debug_Draw_Data.Shapes.end());
+	Debug_Draw_Data.Labels.erase(std::remove_if(Debug_Draw_Data.Labels.begin(), Debug_Draw_Data.Labels.end(),
+		[category](const LabelEntry& label) { return (label.Category & category) != 0; }), Debug_Draw_Data.Labels.end());
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gets the number of shapes and labels drawn by the last Flush.
+*/
+/**************************************************************************/
+size_t DebugDraw::GetDrawnCount() {
+	return Debug_Draw_Data.Drawn;
+}
+#endif
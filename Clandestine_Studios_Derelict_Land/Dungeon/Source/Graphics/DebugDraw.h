@@ -0,0 +1,296 @@
+/******************************************************************************/
+/*!
+\file    DebugDraw.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Immediate mode debug shapes for gizmos, collider boxes and anything
+		 else worth seeing while tuning a level. Lines, rectangles and
+		 circles are kept as one 32 byte instance each and drawn on top of
+		 the frame with a single instanced call, debug.vert expanding each
+		 one to a quad and debug.frag cutting out its outline. Labels are
+		 queued into the sprite batch as text.
+
+		 Shapes last one frame unless given a lifetime, and belong to a
+		 category that can be switched off. Defining DISABLE_DEBUG_DRAW
+		 compiles every call away.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+#include <GL/glew.h>
+#include "Graphics/glslshader.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+//#define DISABLE_DEBUG_DRAW
+
+struct Character;
+
+class DebugDraw {
+public:
+	// Groups of shapes, switched on and off together
+	enum Category : uint32_t {
+		General = 1u << 0,
+		Gizmos = 1u << 1,		// transform gizmos of the selected object
+		Colliders = 1u << 2,	// collision boxes with showBox set
+		AllCategories = 0xffffffffu
+	};
+
+	static constexpr float DefaultThickness{ 2.f };	// pixels, lines and outlines
+
+#ifndef DISABLE_DEBUG_DRAW
+	/**************************************************************************/
+	/*!
+	  \brief
+		Creates the instance buffer. Call with the OpenGL context current,
+		after shader_program is set.
+
+	  \param font
+		Font labels are drawn with.
+	*/
+	/**************************************************************************/
+	static void Init(const std::map<char, Character>& font);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Frees the instance buffer and every shape still alive.
+	*/
+	/**************************************************************************/
+	static void Cleanup();
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Draw a line.
+
+	  \param p0
+		Start position(x,y) of the line.
+
+	  \param p1
+		End position(x,y) of the line.
+
+	  \param clr
+		Color(r,g,b,a) of the line.
+
+	  \param category
+		Category of the line, nothing is recorded if it is switched off.
+
+	  \param lifetime
+		Seconds the line stays after this frame.
+	*/
+	/**************************************************************************/
+	static void Line(const glm::vec2& p0, const glm::vec2& p1, const glm::vec4& clr, Category category = General, float lifetime = 0.f);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Draw a line of a given width.
+
+	  \param p0
+		Start position(x,y) of the line.
+
+	  \param p1
+		End position(x,y) of the line.
+
+	  \param thickness
+		Width of the line, in pixels.
+
+	  \param clr
+		Color(r,g,b,a) of the line.
+
+	  \param category
+		Category of the line, nothing is recorded if it is switched off.
+
+	  \param lifetime
+		Seconds the line stays after this frame.
+	*/
+	/**************************************************************************/
+	static void ThickLine(const glm::vec2& p0, const glm::vec2& p1, float thickness, const glm::vec4& clr, Category category = General, float lifetime = 0.f);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Draw a rectangle.
+
+	  \param center
+		Position(x,y) of the rectangle's center.
+
+	  \param size
+		Size(x,y) of the rectangle.
+
+	  \param clr
+		Color(r,g,b,a) of the rectangle.
+
+	  \param thickness
+		Width of the outline in pixels, 0 fills the rectangle.
+
+	  \param angle_in_degree
+		Rotation of the rectangle about its center.
+
+	  \param category
+		Category of the rectangle, nothing is recorded if it is switched off.
+
+	  \param lifetime
+		Seconds the rectangle stays after this frame.
+	*/
+	/**************************************************************************/
+	static void Rect(const glm::vec2& center, const glm::vec2& size, const glm::vec4& clr, float thickness = DefaultThickness, float angle_in_degree = 0.f,
+		Category category = General, float lifetime = 0.f);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Draw a circle.
+
+	  \param center
+		Position(x,y) of the circle's center.
+
+	  \param radius
+		Radius of the circle.
+
+	  \param clr
+		Color(r,g,b,a) of the circle.
+
+	  \param thickness
+		Width of the outline in pixels, 0 fills the circle.
+
+	  \param category
+		Category of the circle, nothing is recorded if it is switched off.
+
+	  \param lifetime
+		Seconds the circle stays after this frame.
+	*/
+	/**************************************************************************/
+	static void Circle(const glm::vec2& center, float radius, const glm::vec4& clr, float thickness = DefaultThickness, Category category = General, float lifetime = 0.f);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Draw an arrow, a line with a head of two lines at its end.
+
+	  \param from
+		Tail position(x,y) of the arrow.
+
+	  \param to
+		Tip position(x,y) of the arrow.
+
+	  \param clr
+		Color(r,g,b,a) of the arrow.
+
+	  \param head
+		Length of the two lines of the head.
+
+	  \param thickness
+		Width of the lines, in pixels.
+
+	  \param category
+		Category of the arrow, nothing is recorded if it is switched off.
+
+	  \param lifetime
+		Seconds the arrow stays after this frame.
+	*/
+	/**************************************************************************/
+	static void Arrow(const glm::vec2& from, const glm::vec2& to, const glm::vec4& clr, float head = 15.f, float thickness = DefaultThickness,
+		Category category = General, float lifetime = 0.f);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Draw a line of text at a position in the world.
+
+	  \param pos
+		Position(x,y) of the start of the text's baseline.
+
+	  \param text
+		Text to draw.
+
+	  \param clr
+		Color(r,g,b,a) of the text.
+
+	  \param scale
+		Size of the text, 1 is the font's size.
+
+	  \param category
+		Category of the label, nothing is recorded if it is switched off.
+
+	  \param lifetime
+		Seconds the label stays after this frame.
+	*/
+	/**************************************************************************/
+	static void Label(const glm::vec2& pos, const std::string& text, const glm::vec4& clr, float scale = 0.5f, Category category = General, float lifetime = 0.f);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Queue the labels into the sprite batch. Call before Batch::EndBatch.
+	*/
+	/**************************************************************************/
+	static void DrawLabels();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Draw the shapes over the pass just flushed, with the camera it was
+		drawn with, then drop those whose lifetime ran out. Call after
+		Batch::Flush, once per frame. Does nothing if there are no shapes.
+
+	  \param dt
+		Delta time, taken off every lifetime.
+	*/
+	/**************************************************************************/
+	static void Flush(float dt);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Switch a category on or off. Shapes of a category switched off are
+		dropped.
+
+	  \param category
+		Category to switch.
+
+	  \param enabled
+		Whether its shapes are recorded.
+	*/
+	/**************************************************************************/
+	static void SetEnabled(Category category, bool enabled);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Whether shapes of a category are recorded.
+	*/
+	/**************************************************************************/
+	static bool IsEnabled(Category category) { return (Enabled & category) != 0; }
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the number of shapes and labels drawn by the last Flush.
+	*/
+	/**************************************************************************/
+	static size_t GetDrawnCount();
+
+	//Variable
+	static GLSLShader shader_program;
+
+private:
+	static uint32_t Enabled;
+#else
+	static void Init(const std::map<char, Character>&) {}
+	static void Cleanup() {}
+	static void Line(const glm::vec2&, const glm::vec2&, const glm::vec4&, Category = General, float = 0.f) {}
+	static void ThickLine(const glm::vec2&, const glm::vec2&, float, const glm::vec4&, Category = General, float = 0.f) {}
+	static void Rect(const glm::vec2&, const glm::vec2&, const glm::vec4&, float = DefaultThickness, float = 0.f, Category = General, float = 0.f) {}
+	static void Circle(const glm::vec2&, float, const glm::vec4&, float = DefaultThickness, Category = General, float = 0.f) {}
+	static void Arrow(const glm::vec2&, const glm::vec2&, const glm::vec4&, float = 15.f, float = DefaultThickness, Category = General, float = 0.f) {}
+	static void Label(const glm::vec2&, const std::string&, const glm::vec4&, float = 0.5f, Category = General, float = 0.f) {}
+	static void DrawLabels() {}
+	static void Flush(float) {}
+	static void SetEnabled(Category, bool) {}
+	static bool IsEnabled(Category) { return false; }
+	static size_t GetDrawnCount() { return 0; }
+
+	//Variable
+	static inline GLSLShader shader_program;
+#endif
+};
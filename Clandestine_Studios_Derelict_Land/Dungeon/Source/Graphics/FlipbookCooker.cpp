@@ -0,0 +1,328 @@
+/******************************************************************************/
+/*!
+\file    FlipbookCooker.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Offline flipbook cooker. Every animation listed in
+		 ./Data/Flipbooks.txt, either a directory of frame images or a
+		 sprite sheet, is block compressed one frame at a time into a .flip
+		 file that FlipbookStream plays back a few frames at a time. Run the
+		 game with --cook-flipbooks.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/FlipbookCooker.h>
+#include <Graphics/FlipbookStream.h>
+#include <Graphics/TextureCooker.h>
+#include <CoreSys/CommandLine.h>
+#include "../3rdParty/stb_image.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+	/**************************************************************************/
+	/*!
+	  \brief
+		Frames of a flipbook, loaded one at a time so a long animation is
+		never in memory whole. A sprite sheet is the exception, it is one
+		image and is kept decoded while it is cut up.
+	*/
+	/**************************************************************************/
+	struct FrameSource {
+		std::vector<std::string> files;		// one image per frame, empty for a sprite sheet
+		std::vector<unsigned char> sheet;
+		int sheet_w{}, sheet_h{};
+		int per_row{ 1 }, per_column{ 1 };
+
+		int Count() const { return files.empty() ? per_row * per_column : static_cast<int>(files.size()); }
+
+		bool Load(int frame, std::vector<unsigned char>& rgba, int& w, int& h) const {
+			if (!files.empty()) {
+				int channels{};
+				unsigned char* data = stbi_load(files[frame].c_str(), &w, &h, &channels, 4);
+				if (!data) { std::cout << "[FlipbookCooker] Failed to load " << files[frame] << "\n"; return false; }
+				rgba.assign(data, data + static_cast<size_t>(w) * h * 4);
+				stbi_image_free(data);
+				return true;
+			}
+
+			// Frames go row by row from the first texture row, as in Assets::AddSpriteAnimation
+			w = sheet_w / per_row;
+			h = sheet_h / per_column;
+			const int x0 = (frame % per_row) * w, y0 = (frame / per_row) * h;
+			rgba.resize(static_cast<size_t>(w) * h * 4);
+			for (int y = 0; y < h; ++y) {
+				const unsigned char* src = &sheet[(static_cast<size_t>(y0 + y) * sheet_w + x0) * 4];
+				std::copy(src, src + static_cast<size_t>(w) * 4, &rgba[static_cast<size_t>(y) * w * 4]);
+			}
+			return true;
+		}
+	};
+
+	bool IsImage(const std::filesystem::path& path) {
+		std::string ext = path.extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga";
+	}
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Finds the frames of a flipbook. Images in a directory are frames in
+		name order, so they need names that sort, like 001.png.
+	*/
+	/**************************************************************************/
+	bool OpenSource(const FlipbookCooker::Entry& entry, FrameSource& source) {
+		std::error_code ec;
+		if (std::filesystem::is_directory(entry.source, ec)) {
+			for (const auto& file : std::filesystem::directory_iterator(entry.source)) {
+				if (!file.is_regular_file() || !IsImage(file.path())) continue;
+				source.files.push_back(file.path().generic_string());
+			}
+			std::sort(source.files.begin(), source.files.end());
+			if (source.files.empty()) { std::cout << "[FlipbookCooker] No frames in " << entry.source << "\n"; return false; }
+			return true;
+		}
+
+		int channels{};
+		unsigned char* data = stbi_load(entry.source.c_str(), &source.sheet_w, &source.sheet_h, &channels, 4);
+		if (!data) { std::cout << "[FlipbookCooker] Failed to load " << entry.source << "\n"; return false; }
+		source.sheet.assign(data, data + static_cast<size_t>(source.sheet_w) * source.sheet_h * 4);
+		stbi_image_free(data);
+		source.per_row = entry.frames_per_row > 0 ? entry.frames_per_row : 1;
+		source.per_column = entry.frames_per_column > 0 ? entry.frames_per_column : 1;
+		if (source.sheet_w < source.per_row || source.sheet_h < source.per_column) { std::cout << "[FlipbookCooker] " << entry.source << " is smaller than its frame count\n"; return false; }
+		return true;
+	}
+
+	bool HasAlpha(const std::vector<unsigned char>& rgba) {
+		for (size_t i = 3; i < rgba.size(); i += 4) {
+			if (rgba[i] != 255) return true;
+		}
+		return false;
+	}
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Reads the flipbook list, a name and a source on each line, followed
+		by the frames per row and column when the source is a sprite sheet.
+	*/
+	/**************************************************************************/
+	bool ReadList(const std::string& list, std::vector<FlipbookCooker::Entry>& entries) {
+		std::ifstream file(list);
+		if (!file.is_open()) return false;
+		std::string line;
+		while (std::getline(file, line)) {
+			std::istringstream fields(line);
+			FlipbookCooker::Entry entry;
+			if (!(fields >> entry.name >> entry.source)) continue;
+			fields >> entry.frames_per_row >> entry.frames_per_column;
+			entries.push_back(entry);
+		}
+		return true;
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Reads cooker settings from the command line.
+
+  \param argc
+	Number of arguments.
+
+  \param argv
+	Arguments.
+
+  \param settings
+	Settings to fill in.
+
+  \return
+	True if all arguments were valid.
+*/
+/**************************************************************************/
+bool FlipbookCooker::ParseArguments(int argc, char** argv, Settings& settings) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--cook-flipbooks") continue;
+		if (arg == "--force") { settings.Force = true; continue; }
+		std::string value;
+		if (!CommandLine::NextArgument(argc, argv, i, value)) return false;
+
+		if (arg == "--list") settings.List = value;
+		else { std::cout << "Unknown argument " << arg << "\n"; return false; }
+	}
+
+	if (!std::filesystem::is_regular_file(settings.List)) {
+		std::cout << "Invalid flipbook list " << settings.List << "\n";
+		return false;
+	}
+	return true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Cooks one flipbook into its .flip. Frames are loaded flipped, as the
+	game loads images. Every frame is read once to pick DXT1 or DXT5, which
+	is the same for the whole flipbook, and again to compress it, so only
+	one frame is in memory at a time.
+
+  \param entry
+	Flipbook to cook.
+
+  \param result
+	Savings of the flipbook.
+
+  \return
+	False if a frame could not be read or the .flip written.
+*/
+/**************************************************************************/
+bool FlipbookCooker::CookFlipbook(const Entry& entry, Result& result) {
+	result = { entry.name, 0, 0, 0, false, 0, 0, 0.0 };
+
+	FrameSource source;
+	if (!OpenSource(entry, source)) return false;
+	result.frames = source.Count();
+
+	std::vector<unsigned char> rgba;
+	for (int frame = 0; frame < result.frames; ++frame) {
+		int w{}, h{};
+		if (!source.Load(frame, rgba, w, h)) return false;
+		if (frame && (w != result.w || h != result.h)) { std::cout << "[FlipbookCooker] Frame " << frame << " of " << entry.name << " is not " << result.w << "x" << result.h << "\n"; return false; }
+		result.w = w;
+		result.h = h;
+		result.alpha = result.alpha || HasAlpha(rgba);
+	}
+
+	std::string cooked = FlipbookStream::Cooked_Path(entry.source.c_str());
+	std::error_code ec;
+	std::filesystem::create_directories(std::filesystem::path(cooked).parent_path(), ec);
+	std::ofstream file(cooked, std::ios::binary);
+	if (!file.is_open()) { std::cout << "[FlipbookCooker] Could not write " << cooked << "\n"; return false; }
+
+	// The frame table is written again once the frames are in
+	FlipbookStream::FileHeader header{ FlipbookStream::Magic, FlipbookStream::Version, static_cast<uint32_t>(result.w), static_cast<uint32_t>(result.h),
+		static_cast<uint32_t>(result.frames), result.alpha ? 1u : 0u };
+	std::vector<uint64_t> offsets(static_cast<size_t>(result.frames) + 1);
+	offsets[0] = sizeof(header) + offsets.size() * sizeof(uint64_t);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+
+	std::vector<unsigned char> blocks;
+	for (int frame = 0; frame < result.frames; ++frame) {
+		int w{}, h{};
+		if (!source.Load(frame, rgba, w, h)) return false;
+		blocks.clear();
+		TextureCooker::CompressImage(rgba, w, h, result.alpha, blocks);
+		file.write(reinterpret_cast<const char*>(blocks.data()), static_cast<std::streamsize>(blocks.size()));
+		offsets[frame + 1] = offsets[frame] + blocks.size();
+	}
+	file.seekp(sizeof(header));
+	file.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+	file.close();
+	if (!file) { std::cout << "[FlipbookCooker] Could not write " << cooked << "\n"; return false; }
+
+	result.sheet_bytes = static_cast<size_t>(result.w) * result.h * 4 * result.frames * 4 / 3;
+	result.ring_bytes = FlipbookStream::RingSize * blocks.size();
+
+	// What FlipbookStream reads before the first frame can be shown
+	auto start = std::chrono::steady_clock::now();
+	std::ifstream check(cooked, std::ios::binary);
+	check.read(reinterpret_cast<char*>(&header), sizeof(header));
+	check.read(reinterpret_cast<char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+	blocks.resize(static_cast<size_t>(offsets[1] - offsets[0]));
+	check.read(reinterpret_cast<char*>(blocks.data()), static_cast<std::streamsize>(blocks.size()));
+	result.first_frame_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	if (!check.good()) { std::cout << "[FlipbookCooker] Could not read back " << cooked << "\n"; return false; }
+	return true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Cooks every flipbook in the list that has no up to date .flip. A .flip
+	is up to date when it is newer than all of its frames.
+
+  \param settings
+	Cooker settings.
+
+  \return
+	True if every flipbook was cooked.
+*/
+/**************************************************************************/
+bool FlipbookCooker::Cook(const Settings& settings) {
+	std::vector<Entry> entries;
+	if (!ReadList(settings.List, entries)) { std::cout << "[FlipbookCooker] Could not open " << settings.List << "\n"; return false; }
+
+	stbi_set_flip_vertically_on_load(1);
+
+	size_t cooked_count = 0, up_to_date = 0, failed = 0;
+	size_t sheet_total = 0, ring_total = 0;
+	std::cout << std::fixed << std::setprecision(2);
+	for (const Entry& entry : entries) {
+		if (!settings.Force) {
+			std::error_code ec;
+			auto cooked_time = std::filesystem::last_write_time(FlipbookStream::Cooked_Path(entry.source.c_str()), ec);
+			bool exists = !ec;
+			// Only the file times are needed, sheets are not decoded for this
+			if (exists && std::filesystem::is_directory(entry.source, ec)) {
+				for (const auto& file : std::filesystem::directory_iterator(entry.source))
+					exists = exists && !(file.is_regular_file() && IsImage(file.path()) && file.last_write_time(ec) > cooked_time);
+			}
+			else if (exists) {
+				exists = std::filesystem::last_write_time(entry.source, ec) <= cooked_time;
+			}
+			if (exists) { ++up_to_date; continue; }
+		}
+
+		Result result;
+		if (!CookFlipbook(entry, result)) { ++failed; continue; }
+		++cooked_count;
+		sheet_total += result.sheet_bytes;
+		ring_total += result.ring_bytes;
+		std::cout << "[FlipbookCooker] " << result.name << " " << result.frames << " frames of " << result.w << "x" << result.h << (result.alpha ? " DXT5 " : " DXT1 ")
+			<< result.sheet_bytes / 1048576.0 << " MB as a sheet -> " << result.ring_bytes / 1048576.0 << " MB streamed, first frame in "
+			<< result.first_frame_ms << " ms\n";
+	}
+
+	std::cout << "[FlipbookCooker] Cooked " << cooked_count << " flipbooks (" << up_to_date << " up to date, " << failed << " failed): "
+		<< sheet_total / 1048576.0 << " MB -> " << ring_total / 1048576.0 << " MB\n";
+	return failed == 0;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Runs the cooker from the command line.
+
+  \param argc
+	Number of arguments.
+
+  \param argv
+	Arguments.
+
+  \return
+	0 on success.
+*/
+/**************************************************************************/
+int FlipbookCooker::Run(int argc, char** argv) {
+	Settings settings;
+	if (!ParseArguments(argc, argv, settings)) {
+		std::cout << "Usage: --cook-flipbooks [--force] [--list ./Data/Flipbooks.txt]\n";
+		return 1;
+	}
+	return Cook(settings) ? 0 : 1;
+}
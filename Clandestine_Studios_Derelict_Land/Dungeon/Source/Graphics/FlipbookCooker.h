@@ -0,0 +1,128 @@
+/******************************************************************************/
+/*!
+\file    FlipbookCooker.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Offline flipbook cooker. Every animation listed in
+		 ./Data/Flipbooks.txt, either a directory of frame images or a
+		 sprite sheet, is block compressed one frame at a time into a .flip
+		 file that FlipbookStream plays back a few frames at a time. Run the
+		 game with --cook-flipbooks.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace FlipbookCooker {
+	/**************************************************************************/
+	/*!
+	  \brief
+		Cooker settings, all can be changed from the command line.
+	*/
+	/**************************************************************************/
+	struct Settings {
+		std::string List{ "./Data/Flipbooks.txt" };	// --list, one flipbook per line
+		bool Force{ false };							// --force, cook flipbooks whose .flip is up to date
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		One line of the flipbook list. Frames of a sprite sheet are cut out
+		row by row, the frame counts are ignored for a directory.
+	*/
+	/**************************************************************************/
+	struct Entry {
+		std::string name;
+		std::string source;
+		int frames_per_row{ 1 };
+		int frames_per_column{ 1 };
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		What cooking one flipbook saved.
+	*/
+	/**************************************************************************/
+	struct Result {
+		std::string name;
+		int w, h, frames;
+		bool alpha;				// DXT5 if true, DXT1 otherwise
+		size_t sheet_bytes;		// RGBA8 with mips, every frame as one sprite sheet
+		size_t ring_bytes;		// compressed frames FlipbookStream keeps at once
+		double first_frame_ms;	// opening the .flip and reading its first frame
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Reads cooker settings from the command line.
+
+	  \param argc
+		Number of arguments.
+
+	  \param argv
+		Arguments.
+
+	  \param settings
+		Settings to fill in.
+
+	  \return
+		True if all arguments were valid.
+	*/
+	/**************************************************************************/
+	bool ParseArguments(int argc, char** argv, Settings& settings);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Cooks one flipbook into its .flip.
+
+	  \param entry
+		Flipbook to cook.
+
+	  \param result
+		Savings of the flipbook.
+
+	  \return
+		False if a frame could not be read or the .flip written.
+	*/
+	/**************************************************************************/
+	bool CookFlipbook(const Entry& entry, Result& result);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Cooks every flipbook in the list that has no up to date .flip.
+
+	  \param settings
+		Cooker settings.
+
+	  \return
+		True if every flipbook was cooked.
+	*/
+	/**************************************************************************/
+	bool Cook(const Settings& settings);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Runs the cooker from the command line.
+
+	  \param argc
+		Number of arguments.
+
+	  \param argv
+		Arguments.
+
+	  \return
+		0 on success.
+	*/
+	/**************************************************************************/
+	int Run(int argc, char** argv);
+}
@@ -0,0 +1,421 @@
+/******************************************************************************/
+/*!
+\file    FlipbookStream.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Streams the frames of a long animation instead of keeping the whole
+		 sprite sheet in memory. FlipbookCooker writes each frame as its own
+		 block compressed chunk into a .flip file. While a flipbook is
+		 drawn, a worker thread reads the frames just ahead of the one shown
+		 into a small ring, and the thread owning the OpenGL context uploads
+		 them into a ring of textures the same size. Memory use does not
+		 depend on the length of the animation, and opening one only reads
+		 its frame table.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/FlipbookStream.h>
+#include <Graphics/RenderThread.h>
+#include <Graphics/Texture.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+struct StreamData
+{
+	std::thread Thread;
+	std::mutex Mutex;
+	std::condition_variable JobReady;
+	std::condition_variable JobDone;
+	std::deque<std::pair<FlipbookStream*, int>> Jobs;	// stream and slot to read
+	std::vector<FlipbookStream*> Streams;				// every flipbook, for Update
+	FlipbookStream* Busy = nullptr;						// stream being read from
+	bool Stopping = false;
+
+	std::atomic<size_t> ResidentBytes{ 0 };
+};
+
+static StreamData Stream_Data;
+
+/**************************************************************************/
+/*!
+  \brief
+	Gets the size of one frame of a flipbook, in blocks of 4x4 pixels.
+
+  \param header
+	Header of the flipbook.
+
+  \return
+	Bytes of one block compressed frame.
+*/
+/**************************************************************************/
+static size_t Frame_Bytes(const FlipbookStream::FileHeader& header) {
+	return static_cast<size_t>((header.Width + 3) / 4) * ((header.Height + 3) / 4) * (header.Alpha ? 16 : 8);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Registers the flipbook so Update uploads its frames and Shutdown frees
+	its textures.
+*/
+/**************************************************************************/
+FlipbookStream::FlipbookStream() {
+	std::lock_guard<std::mutex> lock(Stream_Data.Mutex);
+	Stream_Data.Streams.push_back(this);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Drops the flipbook's queued reads, waits for a read in progress and
+	frees its textures on the OpenGL thread.
+*/
+/**************************************************************************/
+FlipbookStream::~FlipbookStream() {
+	std::unique_lock<std::mutex> lock(Stream_Data.Mutex);
+	Stream_Data.Jobs.erase(std::remove_if(Stream_Data.Jobs.begin(), Stream_Data.Jobs.end(),
+		[this](const std::pair<FlipbookStream*, int>& job) { return job.first == this; }), Stream_Data.Jobs.end());
+	Stream_Data.Streams.erase(std::remove(Stream_Data.Streams.begin(), Stream_Data.Streams.end(), this), Stream_Data.Streams.end());
+	Stream_Data.JobDone.wait(lock, [this] { return Stream_Data.Busy != this; });
+	lock.unlock();
+
+	// Shutdown frees the rings it can, this only happens for flipbooks replaced while running
+	if (textures[0]) {
+		Stream_Data.ResidentBytes -= RingSize * Frame_Bytes(header);
+		RenderThread::Submit([names = std::vector<GLuint>(textures, textures + RingSize)] { glDeleteTextures(RingSize, names.data()); });
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Starts the thread reading frames from disk. Does nothing if it is
+	already running.
+*/
+/**************************************************************************/
+void FlipbookStream::Init() {
+	std::lock_guard<std::mutex> lock(Stream_Data.Mutex);
+	if (Stream_Data.Thread.joinable())
+		return;
+	Stream_Data.Stopping = false;
+	Stream_Data.Thread = std::thread(Run);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Stops the reading thread, dropping the reads still queued, and frees
+	the textures of every flipbook. Call on the OpenGL thread.
+*/
+/**************************************************************************/
+void FlipbookStream::Shutdown() {
+	{
+		std::lock_guard<std::mutex> lock(Stream_Data.Mutex);
+		Stream_Data.Stopping = true;
+		Stream_Data.Jobs.clear();
+	}
+	Stream_Data.JobReady.notify_all();
+	if (Stream_Data.Thread.joinable())
+		Stream_Data.Thread.join();
+
+	std::lock_guard<std::mutex> lock(Stream_Data.Mutex);
+	for (FlipbookStream* stream : Stream_Data.Streams) {
+		std::lock_guard<std::mutex> stream_lock(stream->mutex);
+		stream->Release();
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Uploads the frames read since the last call and frees the rings of
+	flipbooks not drawn for ReleaseAfter frames. Call on the OpenGL thread
+	once per frame.
+*/
+/**************************************************************************/
+void FlipbookStream::Update() {
+	std::lock_guard<std::mutex> lock(Stream_Data.Mutex);
+	for (FlipbookStream* stream : Stream_Data.Streams)
+		stream->Upload();
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Gets the video memory taken by the rings of every flipbook.
+
+  \return
+	Bytes of compressed frames held in textures.
+*/
+/**************************************************************************/
+size_t FlipbookStream::GetResidentBytes() {
+	return Stream_Data.ResidentBytes;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Gets the path of the cooked flipbook of a folder of frames.
+
+  \param source
+	Folder of frames, with or without a trailing separator.
+
+  \return
+	Path of the .flip file next to the cooked textures.
+*/
+/**************************************************************************/
+std::string FlipbookStream::Cooked_Path(char const* source) {
+	std::string trimmed = source;
+	while (trimmed.size() > 1 && (trimmed.back() == '/' || trimmed.back() == '\\'))
+		trimmed.pop_back();
+	return std::filesystem::path(Texture::Cooked_Path(trimmed.c_str())).replace_extension(".flip").generic_string();
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Opens a cooked flipbook, reading only its header and frame table. The
+	file is kept open for the reading thread.
+
+  \param filename
+	Path of the .flip file.
+
+  \return
+	True if the file is a flipbook with a valid frame table.
+*/
+/**************************************************************************/
+bool FlipbookStream::Open(const std::string& filename) {
+	file.open(filename, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	FileHeader read{};
+	file.read(reinterpret_cast<char*>(&read), sizeof(read));
+	if (!file.good() || read.Magic != Magic || read.Version != Version || !read.Frames || !read.Width || !read.Height) {
+		std::cout << "[FlipbookStream] " << filename << " is not a flipbook\n";
+		file.close();
+		return false;
+	}
+
+	// Every frame is one level of the same size, anything else is a broken file
+	std::vector<uint64_t> table(read.Frames + 1);
+	file.read(reinterpret_cast<char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(uint64_t)));
+	const size_t frame_bytes = Frame_Bytes(read);
+	for (uint32_t i = 0; file.good() && i < read.Frames; ++i) {
+		if (table[i + 1] - table[i] != frame_bytes)
+			file.setstate(std::ios::failbit);
+	}
+	if (!file.good()) {
+		std::cout << "[FlipbookStream] Frame table of " << filename << " is broken\n";
+		file.close();
+		return false;
+	}
+
+	header = read;
+	offsets = std::move(table);
+	return true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Marks a frame as drawn and queues reads of the frames after it that are
+	not in the ring yet.
+
+  \param frame
+	Frame to show, clamped or wrapped into the flipbook.
+
+  \param loop
+	Whether the frames after the last one wrap to the first.
+
+  \return
+	Texture holding the frame, the last frame shown while it is still
+	loading, or 0 if nothing was uploaded yet.
+*/
+/**************************************************************************/
+GLuint FlipbookStream::Show(int frame, bool loop) {
+	const int frames = GetFrames();
+	if (!frames)
+		return 0;
+	frame = frame < 0 ? 0 : frame < frames ? frame : loop ? frame % frames : frames - 1;
+
+	int queued[RingSize]{};
+	int count = 0;
+	GLuint texture = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		drawn = true;
+
+		// The slot shown is left alone, so the ring holds it and the frames after it
+		for (int ahead = 0; ahead < RingSize - 1; ++ahead) {
+			int wanted = frame + ahead;
+			if (wanted >= frames) {
+				if (!loop) break;
+				wanted %= frames;
+			}
+			const int index = wanted % RingSize;
+			Slot& slot = slots[index];
+			if ((slot.frame == wanted && slot.state != SlotState::Empty) || index == shown || slot.state == SlotState::Reading)
+				continue;
+			slot.frame = wanted;
+			slot.state = SlotState::Queued;
+			queued[count++] = index;
+		}
+
+		const int index = frame % RingSize;
+		if (slots[index].frame == frame && slots[index].state == SlotState::Uploaded)
+			shown = index;
+		texture = shown >= 0 ? textures[shown] : 0;
+	}
+
+	if (count) {
+		{
+			std::lock_guard<std::mutex> lock(Stream_Data.Mutex);
+			for (int i = 0; i < count; ++i)
+				Stream_Data.Jobs.emplace_back(this, queued[i]);
+		}
+		Stream_Data.JobReady.notify_one();
+	}
+	return texture;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Body of the reading thread. Reads queued frames into their slots, one
+	at a time, until Shutdown.
+*/
+/**************************************************************************/
+void FlipbookStream::Run() {
+	std::unique_lock<std::mutex> lock(Stream_Data.Mutex);
+	for (;;) {
+		Stream_Data.JobReady.wait(lock, [] { return Stream_Data.Stopping || !Stream_Data.Jobs.empty(); });
+		if (Stream_Data.Stopping)
+			return;
+
+		std::pair<FlipbookStream*, int> job = Stream_Data.Jobs.front();
+		Stream_Data.Jobs.pop_front();
+		Stream_Data.Busy = job.first;
+		lock.unlock();
+
+		job.first->Read(job.second);
+
+		lock.lock();
+		Stream_Data.Busy = nullptr;
+		Stream_Data.JobDone.notify_all();
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Reads the frame queued in a slot from the file. Runs on the reading
+	thread, with the stream lock only held to change the slot's state.
+
+  \param index
+	Slot to fill.
+*/
+/**************************************************************************/
+void FlipbookStream::Read(int index) {
+	Slot& slot = slots[index];
+	int frame{};
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		// Queued more than once, or refilled with a frame that was read already
+		if (slot.state != SlotState::Queued)
+			return;
+		slot.state = SlotState::Reading;
+		frame = slot.frame;
+	}
+
+	slot.data.resize(static_cast<size_t>(offsets[frame + 1] - offsets[frame]));
+	file.seekg(static_cast<std::streamoff>(offsets[frame]));
+	file.read(reinterpret_cast<char*>(slot.data.data()), static_cast<std::streamsize>(slot.data.size()));
+	const bool read = file.good();
+	if (!read) {
+		std::cout << "[FlipbookStream] Failed to read frame " << frame << "\n";
+		file.clear();
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	slot.state = read ? SlotState::Read : SlotState::Empty;
+	slot.frame = read ? slot.frame : -1;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Creates the ring of textures if needed and uploads the slots read from
+	disk, or frees the ring once the flipbook has not been drawn for
+	ReleaseAfter frames. Runs on the OpenGL thread.
+*/
+/**************************************************************************/
+void FlipbookStream::Upload() {
+	std::lock_guard<std::mutex> lock(mutex);
+	idle = drawn ? 0 : idle > ReleaseAfter ? idle : idle + 1;
+	drawn = false;
+	if (idle > ReleaseAfter) {
+		Release();
+		return;
+	}
+
+	const GLenum format = header.Alpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	const GLsizei width = static_cast<GLsizei>(header.Width), height = static_cast<GLsizei>(header.Height);
+	if (!textures[0]) {
+		glCreateTextures(GL_TEXTURE_2D, RingSize, textures);
+		for (GLuint texture : textures) {
+			glTextureStorage2D(texture, 1, format, width, height);
+			glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		}
+		Stream_Data.ResidentBytes += RingSize * Frame_Bytes(header);
+	}
+
+	for (int index = 0; index < RingSize; ++index) {
+		Slot& slot = slots[index];
+		if (slot.state != SlotState::Read)
+			continue;
+		glCompressedTextureSubImage2D(textures[index], 0, 0, 0, width, height, format, static_cast<GLsizei>(slot.data.size()), slot.data.data());
+		slot.state = SlotState::Uploaded;
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Frees the ring of textures and the buffers of every slot. Skipped while
+	a slot is being read, to be tried again on the next Update. Call with
+	the stream lock held, on the OpenGL thread.
+*/
+/**************************************************************************/
+void FlipbookStream::Release() {
+	// The reading thread still owns a buffer, try again on the next Update
+	for (const Slot& slot : slots) {
+		if (slot.state == SlotState::Reading)
+			return;
+	}
+
+	if (textures[0]) {
+		glDeleteTextures(RingSize, textures);
+		std::fill(textures, textures + RingSize, 0u);
+		Stream_Data.ResidentBytes -= RingSize * Frame_Bytes(header);
+	}
+	for (Slot& slot : slots) {
+		slot.frame = -1;
+		slot.state = SlotState::Empty;
+		std::vector<unsigned char>().swap(slot.data);
+	}
+	shown = -1;
+}
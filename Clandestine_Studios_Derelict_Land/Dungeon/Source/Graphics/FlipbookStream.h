@@ -0,0 +1,192 @@
+/******************************************************************************/
+/*!
+\file    FlipbookStream.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Streams the frames of a long animation instead of keeping the whole
+		 sprite sheet in memory. FlipbookCooker writes each frame as its own
+		 block compressed chunk into a .flip file. While a flipbook is
+		 drawn, a worker thread reads the frames just ahead of the one shown
+		 into a small ring, and the thread owning the OpenGL context uploads
+		 them into a ring of textures the same size. Memory use does not
+		 depend on the length of the animation, and opening one only reads
+		 its frame table.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class FlipbookStream {
+public:
+	/**************************************************************************/
+	/*!
+	  \brief
+		Start of a .flip file. It is followed by Frames + 1 offsets from the
+		start of the file, frame i being the bytes between offsets i and
+		i + 1, each one a single DXT1 or DXT5 level stored bottom row first.
+	*/
+	/**************************************************************************/
+	struct FileHeader {
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t Frames;
+		uint32_t Alpha;			// DXT5 if not 0, DXT1 otherwise
+	};
+
+	static constexpr uint32_t Magic{ 0x50494C46 };	// "FLIP"
+	static constexpr uint32_t Version{ 1 };
+	static constexpr int RingSize{ 4 };				// frames held, the one shown and the ones after it
+	static constexpr int ReleaseAfter{ 120 };		// frames not drawn before the ring is freed
+
+	FlipbookStream();
+	~FlipbookStream();
+	FlipbookStream(const FlipbookStream&) = delete;
+	FlipbookStream& operator=(const FlipbookStream&) = delete;
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Starts the thread reading frames.
+	*/
+	/**************************************************************************/
+	static void Init();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Stops the reading thread and frees the rings of every flipbook. Call
+		with the OpenGL context current.
+	*/
+	/**************************************************************************/
+	static void Shutdown();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Uploads the frames read since the last call, makes the rings of
+		flipbooks that started being drawn and frees those no longer drawn.
+		Call once per frame with the OpenGL context current.
+	*/
+	/**************************************************************************/
+	static void Update();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the video memory taken by the rings of every flipbook.
+	*/
+	/**************************************************************************/
+	static size_t GetResidentBytes();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Where the .flip of a frame directory or sprite sheet is written,
+		next to the cooked .dds files.
+
+	  \param source
+		Directory of frame images, or sprite sheet.
+	*/
+	/**************************************************************************/
+	static std::string Cooked_Path(char const* source);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Opens a .flip file, reading only its header and frame table.
+
+	  \param filename
+		.flip file written by FlipbookCooker.
+
+	  \return
+		False if the file is missing or not a flipbook.
+	*/
+	/**************************************************************************/
+	bool Open(const std::string& filename);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the texture to draw a frame with and asks for the frames after
+		it. Until the frame is uploaded, the last frame shown is returned
+		again, or 0 if none was.
+
+	  \param frame
+		Frame to show.
+
+	  \param loop
+		Whether the frames after the last one are the first ones.
+
+	  \return
+		Texture holding the frame, or an earlier one.
+	*/
+	/**************************************************************************/
+	GLuint Show(int frame, bool loop);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the number of frames.
+	*/
+	/**************************************************************************/
+	int GetFrames() const { return static_cast<int>(header.Frames); }
+
+private:
+	/**************************************************************************/
+	/*!
+	  \brief
+		Body of the reading thread, reads the slots queued by Show in order.
+	*/
+	/**************************************************************************/
+	static void Run();
+
+	enum class SlotState { Empty, Queued, Reading, Read, Uploaded };
+
+	struct Slot {
+		int frame{ -1 };
+		SlotState state{ SlotState::Empty };
+		std::vector<unsigned char> data;	// owned by the reading thread while Reading
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Reads the queued frame of a slot, on the reading thread.
+	*/
+	/**************************************************************************/
+	void Read(int slot);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Makes or frees the ring and uploads the frames read, with the OpenGL
+		context current.
+	*/
+	/**************************************************************************/
+	void Upload();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Frees the textures and buffers of the ring, with the OpenGL context
+		current.
+	*/
+	/**************************************************************************/
+	void Release();
+
+	std::mutex mutex;
+	FileHeader header{};
+	std::vector<uint64_t> offsets;
+	std::ifstream file;					// only read by the reading thread
+	Slot slots[RingSize];
+	GLuint textures[RingSize]{};
+	int shown{ -1 };					// slot last returned by Show, never refilled while shown
+	int idle{};							// Update calls since Show was last called
+	bool drawn{ false };				// Show was called since the last Update
+};
@@ -12,134 +12,155 @@
  */
 /******************************************************************************/
 #include "Fonts.h"
+#include "Graphics/BatchRendering.h"
+#include <cstdint>
 
 
 //Variables
 GLint FontsRender::WindowWidth;
 GLint FontsRender::WindowHeight;
-unsigned int FontsRender::VAO;
-unsigned int FontsRender::VBO;
-GLSLShader FontsRender::text_shdrpgm;
-
+TextStyle FontsRender::Style;
 
 /**************************************************************************/
 /*!
 	\brief
-	Initializes Values used by this class for ortho projection
-	\param
-	Windowwidth, the width of the window
-	\param
-	Windowheight, the height of the window
+	Lays out text into glyph quads, relative to the text's origin. Lines
+	break at new line characters, and at "\\n" typed into the editor.
+	\param font
+	This is a map of the fonts loaded, sharing one atlas texture
+	\param text
+	This is a string of text to lay out
+	\param scale
+	scale factor of the text
+	\param line_spacing
+	distance between the baselines of two lines
+	\param layout
+	the glyph quads are written here, replacing what it held
 */
 /**************************************************************************/
-void FontsRender::Init(GLint windowWidth, GLint windowHeight)
+static void LayoutText(const std::map<char, Character>& font, const std::string& text, float scale, float line_spacing, GameUI::TextLayout& layout)
 {
-	WindowWidth = windowWidth;
-	WindowHeight = windowHeight;
+	layout.glyphs.clear();
+	layout.texid = font.empty() ? 0 : font.begin()->second.TextureID;
 
-#ifdef TESTING_OF_FONTSRENDER_RENDER
-	std::cout << "[FontsRender::Init] Initialized with Window Width,Height: " << WindowWidth << "," << WindowHeight<< std::endl;
-	std::cout << "[FontsRender::Init] Values are used for ortho projection of Fonts" << std::endl;
-#endif
+	float x = 0.f, y = 0.f;
+	for (size_t i = 0; i < text.size(); ++i)
+	{
+		if (text[i] == '\n' || (text[i] == '\\' && i + 1 < text.size() && text[i + 1] == 'n'))
+		{
+			if (text[i] == '\\')
+				++i;
+			x = 0.f;
+			y -= line_spacing;
+			continue;
+		}
+
+		auto it = font.find(text[i]);
+		if (it == font.end())
+			continue;
+		const Character& ch = it->second;
+
+		float xpos = x + ch.Bearing.x * scale;
+		float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+
+		float w = ch.Size.x * scale;
+		float h = ch.Size.y * scale;
+
+		// glyph rows are stored top down in the atlas
+		if (ch.Size.x && ch.Size.y)
+			layout.glyphs.push_back({ { xpos + w * 0.5f, ypos + h * 0.5f }, { w, h },
+				{ ch.UVMin.x, ch.UVMax.y }, { ch.UVMax.x, ch.UVMin.y }, i });
 
+		// now advance cursors for next glyph (note that advance is number of 1/64 pixels)
+		x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
+	}
 }
 
 /**************************************************************************/
 /*!
 	\brief
-	This function compilers the shader program , for rendering fonts
-	specifically.
+	Submits laid out text to the batch, one quad per glyph. Text is laid
+	out in window coordinates (ortho 0..WindowWidth, 0..WindowHeight) and
+	moved into the batch's camera space here, on the UI layer.
+	\param layout
+	the glyph quads to draw
+	\param x
+	x position of text rendered on screen
+	\param y
+	y position of text rendered on screen
+	\param z_depth
+	depth of the text
+	\param RGBA
+	the color and alpha of text rendered
+	\param visible_chars
+	glyphs of characters from this index on are not drawn
 */
 /**************************************************************************/
-void FontsRender::ShaderProgram_Setup()
+static void SubmitLayout(const GameUI::TextLayout& layout, float x, float y, float z_depth, const glm::vec4& RGBA, size_t visible_chars)
 {
-	std::string FR_vs_source =
-		"#version 450 core                             \n"
-		"                                              \n"
-		"uniform mat4 Projection_Mat4;                      \n"
-		"                                              \n"
-		"layout (location=0) in vec4 vertex;		   \n"
-		"out vec2 TexCoords;					           \n"
-		"											   \n"
-		"                                              \n"
-		"void main()                               \n"
-		"{                                             \n"
-		"	gl_Position = Projection_Mat4 * vec4(vertex.x, vertex.y , 0.999999, 1.0);   \n"
-		"	TexCoords = vec2(vertex.z,vertex.w);						\n"
-		"}                                             \n";
-
-
-	std::string FR_fs_source =
-		"#version 450 core                              \n"
-		"                                               \n"
-		"in vec2 TexCoords;								\n"
-		"out vec4 color;							    \n"
-		"                                               \n"
-		"uniform sampler2D text;						\n"
-		"uniform vec4 textRGBA;							\n"
-		"                                               \n"
-		"void main()									\n"
-		"{                                             \n"
-		"	vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);   \n"
-		"	color = vec4(textRGBA) * sampled;						\n"
-
-		"}                                             \n";
-
-	text_shdrpgm.CompileShaderFromString(GL_VERTEX_SHADER, FR_vs_source);
-	text_shdrpgm.CompileShaderFromString(GL_FRAGMENT_SHADER, FR_fs_source);
-	text_shdrpgm.Link();
-	
+	glm::vec2 to_batch = { (float)GLSetup::width / (float)FontsRender::WindowWidth, (float)GLSetup::height / (float)FontsRender::WindowHeight };
+	glm::vec2 cam = Batch::camera.GetCameraPosition();
+	const TextStyle& style = FontsRender::Style;
+
+	Batch::SetLayer(RenderQueue::UI);
+
+	// Shadows, then outlines, then the text itself. Each pass covers the whole
+	// string so a glyph's shadow never lands on the glyph before it.
+	struct Pass { glm::vec2 offset; glm::vec4 clr; float edge; };
+	Pass passes[3];
+	int pass_cnt = 0;
+	if (style.ShadowOffset.x != 0.f || style.ShadowOffset.y != 0.f)
+		passes[pass_cnt++] = { style.ShadowOffset, style.ShadowColor * glm::vec4(1.f, 1.f, 1.f, RGBA.a), 0.5f - 0.5f * style.Outline };
+	if (style.Outline > 0.f)
+		passes[pass_cnt++] = { { 0.f, 0.f }, style.OutlineColor * glm::vec4(1.f, 1.f, 1.f, RGBA.a), 0.5f - 0.5f * style.Outline };
+	passes[pass_cnt++] = { { 0.f, 0.f }, RGBA, 0.5f };
+
+	for (int p = 0; p < pass_cnt; ++p)
+	{
+		glm::vec2 origin = { x + passes[p].offset.x, y + passes[p].offset.y };
 
-	if (GL_FALSE == text_shdrpgm.IsLinked()) {
-		std::cout << "Unable to compile/link/validate shader programs\n";
-		std::cout << text_shdrpgm.GetLog() << "\n";
-		assert(text_shdrpgm.IsLinked());
-		std::exit(EXIT_FAILURE);
-	}
-	
+		for (const GameUI::GlyphQuad& g : layout.glyphs)
+		{
+			// glyphs are in text order, so the rest are hidden too
+			if (g.char_idx >= visible_chars)
+				break;
 
-#ifdef TESTING_OF_FONTSRENDER_RENDER
-	std::cout << "[FontsRender::ShaderProgram_Setup] " << text_shdrpgm.GetHandle() << std::endl;
-#endif
+			glm::vec2 center = origin + glm::vec2(g.center.x, g.center.y);
+			Batch::DrawGlyph({ cam + center * to_batch, z_depth }, glm::vec2(g.size.x, g.size.y) * to_batch, layout.texid,
+				{ g.uv_start.x, g.uv_start.y }, { g.uv_end.x, g.uv_end.y }, passes[p].clr, passes[p].edge);
+		}
+	}
 }
 
 /**************************************************************************/
 /*!
 	\brief
-	This function initialise the shaderprogram's VAO and VBOs
+	Initializes Values used by this class for ortho projection
+	\param
+	Windowwidth, the width of the window
+	\param
+	Windowheight, the height of the window
 */
 /**************************************************************************/
-
-void FontsRender::ShaderProgram_Init()
+void FontsRender::Init(GLint windowWidth, GLint windowHeight)
 {
+	WindowWidth = windowWidth;
+	WindowHeight = windowHeight;
 
-	GLuint Text_VAO, Text_VBO;
-	glGenVertexArrays(1, &Text_VAO);
-	glGenBuffers(1, &Text_VBO);
-	glBindVertexArray(Text_VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, Text_VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
-
-	VAO = Text_VAO;
-	VBO = Text_VBO;
-	
 #ifdef TESTING_OF_FONTSRENDER_RENDER
-	std::cout << "[FontsRender::ShaderProgram_Init] SHDRPGM INIT" << std::endl;
-	std::cout << "[FontsRender::ShaderProgram_Init] VAO: " << FontsRender::VAO << std::endl;
-	std::cout << "[FontsRender::ShaderProgram_Init] VBO: " << FontsRender::VBO << std::endl;
+	std::cout << "[FontsRender::Init] Initialized with Window Width,Height: " << WindowWidth << "," << WindowHeight<< std::endl;
+	std::cout << "[FontsRender::Init] Values are used for ortho projection of Fonts" << std::endl;
 #endif
+
 }
 
 /**************************************************************************/
 	/*!
 	  \brief
-		This function initialise the shaderprogram's VAO and VBOs
+		This function queues a string of text into the sprite batch, drawn
+		on the next Batch::EndBatch and Batch::Flush
 	  \param font
-		This is a map of the fonts loaded, and its texture gluint
+		This is a map of the fonts loaded, and its atlas texture
 	  \param text
 		This is a string of text to render
 	  \param x
@@ -153,118 +174,32 @@ void FontsRender::ShaderProgram_Init()
 
 */
 /**************************************************************************/
-void FontsRender::RenderText(std::map<char, Character> font, std::string text, float x, float y, float z_depth, float scale, glm::vec3 TextColor,float TextAlpha)
+void FontsRender::RenderText(const std::map<char, Character>& font, std::string text, float x, float y, float z_depth, float scale, glm::vec3 TextColor,float TextAlpha)
 {
 #ifdef TESTING_OF_FONTSRENDER_RENDER // found in Fonts.h
 	std::cout << "[FontsRender::Render] WindowWidth " << WindowWidth << std::endl;
 	std::cout << "[FontsRender::Render] WindowHeight " << WindowHeight << std::endl;
-	std::cout << "[FontsRender::Render] VAO: " << FontsRender::VAO << std::endl;
-	std::cout << "[FontsRender::Render] VBO: " << FontsRender::VBO << std::endl;
-	std::cout << "[FontsRender::Render] text_shdrpgm handle " << text_shdrpgm.GetHandle() << std::endl;
 	std::cout << "[FontsRender::Render] Rendering of Text Called" << std::endl;
 	std::cout << "[FontsRender::Render] Param Font Map size " << font.size() << std::endl;
 	std::cout << "[FontsRender::Render] Param Text" << text << std::endl;
 	std::cout << "[FontsRender::Render] Param x" << x << std::endl;
 	std::cout << "[FontsRender::Render] Param y" << y << std::endl;
 	std::cout << "[FontsRender::Render] Param scale" << scale << std::endl;
-	
-	char test = 'T';
-	std::cout << "[FontsRender::Render] Map::adv " << font[test].Advance << std::endl;
-	std::cout << "[FontsRender::Render] Map::bearing.x " << font[test].Bearing.x << std::endl;
-	std::cout << "[FontsRender::Render] Map::bearing.y " << font[test].Bearing.y << std::endl;
-	std::cout << "[FontsRender::Render] Map::size.x " << font[test].Size.x << std::endl;
-	std::cout << "[FontsRender::Render] Map::size.y " << font[test].Size.y << std::endl;
-	std::cout << "[FontsRender::Render] Map::textureID " << font[test].TextureID << std::endl;
-	
-
 #endif
 
-	std::string new_line = "\n";
+	// debug text changes every frame, so it is laid out every call into one
+	// reused layout instead of being cached
+	static GameUI::TextLayout layout;
+	LayoutText(font, text, scale, FONT_BASE_SIZE * scale, layout);
 
-	if (text.find(new_line) != std::string::npos) // no new line chars found
-	{
-		//std::cout << " new line chars found\n";
-		std::cout << text;
-	}
-
-
-	glm::mat4 projection = glm::ortho(0.0f, (GLfloat)WindowWidth, 0.0f, (GLfloat)WindowHeight);
-
-
-	// activate corresponding render state	
-	text_shdrpgm.Use();
-
-	// UNIFORM VARIABLES
-	//text_shdrpgm.SetUniform("textAlpha", TextAlpha);
-	//text_shdrpgm.SetUniform("textColor", TextColor);
 	glm::vec4 RGBA = { TextColor.x,TextColor.y ,TextColor.z, TextAlpha };
-	text_shdrpgm.SetUniform("textRGBA", RGBA);
-	text_shdrpgm.SetUniform("Projection_Mat4", projection);
-	text_shdrpgm.SetUniform("float_depth", z_depth);
-
-	glActiveTexture(GL_TEXTURE0);
-	glBindVertexArray(FontsRender::VAO);
-
-	glm::vec4 test_vertice;
-	// iterate through all characters
-	std::string::const_iterator c;
-	for (c = text.begin(); c != text.end(); c++)
-	{
-		Character ch = font[*c];
-
-		float xpos = x + ch.Bearing.x * scale;
-		float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-
-		float w = ch.Size.x * scale;
-		float h = ch.Size.y * scale;
-		// update VBO for each character
-		
-		float vertices[6][4] = {
-			{ xpos,     ypos + h,   0.0f, 0.0f },
-			{ xpos,     ypos,       0.0f, 1.0f },
-			{ xpos + w, ypos,       1.0f, 1.0f },
-
-			{ xpos,     ypos + h,   0.0f, 0.0f },
-			{ xpos + w, ypos,       1.0f, 1.0f },
-			{ xpos + w, ypos + h,   1.0f, 0.0f }
-		};
-
-		if (c == text.begin())
-		{
-			test_vertice.x = vertices[1][0];
-			test_vertice.y = vertices[1][1];
-			test_vertice.z = vertices[1][2];
-			test_vertice.w = vertices[1][3];
-		}
-
-
-		// render glyph texture over quad
-		glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-
-		// update content of VBO memory
-		glBindBuffer(GL_ARRAY_BUFFER, FontsRender::VBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-		// render quad
-		glDrawArrays(GL_TRIANGLES, 0, 6);
-		// now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-		x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
-	}
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
-
-	text_shdrpgm.UnUse();
-
+	SubmitLayout(layout, x, y, z_depth, RGBA, SIZE_MAX);
 }
 
 /**************************************************************************/
 	/*!
 	  \brief
-		This function initialise the shaderprogram's VAO and VBOs, ideally 
+		This function queues a gameui's text into the sprite batch, ideally 
 		for the render of gameui font text that will contain 
 		rendering of multiple lines
 	  \param GO
@@ -272,119 +207,47 @@ void FontsRender::RenderText(std::map<char, Character> font, std::string text, f
 		include, components used are the transfrom and gameui components.
 */
 /**************************************************************************/
-void FontsRender::RenderText(std::map<char, Character> font, GameObject* GO)
+void FontsRender::RenderText(const std::map<char, Character>& font, GameObject* GO)
 {
-#ifdef TESTING_OF_FONTSRENDER_RENDER // found in Fonts.h
-	std::cout << "[FontsRender::Render] WindowWidth " << WindowWidth << std::endl;
-	std::cout << "[FontsRender::Render] WindowHeight " << WindowHeight << std::endl;
-	std::cout << "[FontsRender::Render] VAO: " << FontsRender::VAO << std::endl;
-	std::cout << "[FontsRender::Render] VBO: " << FontsRender::VBO << std::endl;
-	std::cout << "[FontsRender::Render] text_shdrpgm handle " << text_shdrpgm.GetHandle() << std::endl;
-	std::cout << "[FontsRender::Render] Rendering of Text Called" << std::endl;
-	std::cout << "[FontsRender::Render] Param Font Map size " << font.size() << std::endl;
-	std::cout << "[FontsRender::Render] Param Text" << text << std::endl;
-	std::cout << "[FontsRender::Render] Param x" << x << std::endl;
-	std::cout << "[FontsRender::Render] Param y" << y << std::endl;
-	std::cout << "[FontsRender::Render] Param scale" << scale << std::endl;
-
-	char test = 'T';
-	std::cout << "[FontsRender::Render] Map::adv " << font[test].Advance << std::endl;
-	std::cout << "[FontsRender::Render] Map::bearing.x " << font[test].Bearing.x << std::endl;
-	std::cout << "[FontsRender::Render] Map::bearing.y " << font[test].Bearing.y << std::endl;
-	std::cout << "[FontsRender::Render] Map::size.x " << font[test].Size.x << std::endl;
-	std::cout << "[FontsRender::Render] Map::size.y " << font[test].Size.y << std::endl;
-	std::cout << "[FontsRender::Render] Map::textureID " << font[test].TextureID << std::endl;
-
-
-#endif
-
-	//get the transform and the gameui components to get position and font data
+	//get the transform to get the position of the text
 	Transform* trf = dynamic_cast<Transform*>(GO->GetComponent(ComponentType::Transform));
-	GameUI* gui = (dynamic_cast<GameUI*>(GO->GetComponent(ComponentType::GameUI)));
-
-	// vector to store the lines
-	std::vector<std::string> lines;
-	std::string temp = std::regex_replace(gui->GetText(), std::regex(R"(\\n)"), "\n");
-	lines = splitString(temp, "\n");
-
 
-	//create projection matrix
-	glm::mat4 projection = glm::ortho(0.0f, (GLfloat)WindowWidth, 0.0f, (GLfloat)WindowHeight);
-
-
-	// activate corresponding render state	
-	text_shdrpgm.Use();
-
-	// UNIFORM VARIABLES
-	//text_shdrpgm.SetUniform("textAlpha", TextAlpha);
-	//text_shdrpgm.SetUniform("textColor", TextColor);
-	glm::vec4 RGBA = { gui->GetFontColor_vec3().x, gui->GetFontColor_vec3().y,gui->GetFontColor_vec3().z,gui->Alpha };
-	text_shdrpgm.SetUniform("textRGBA", RGBA);
-	text_shdrpgm.SetUniform("Projection_Mat4", projection);
-	text_shdrpgm.SetUniform("float_depth", gui->GetFontDepth());
+	RenderText(font, GO, trf->Position.x, trf->Position.y);
+}
 
-	glActiveTexture(GL_TEXTURE0);
-	glBindVertexArray(FontsRender::VAO);
-	
+/**************************************************************************/
+	/*!
+	  \brief
+		This function queues a gameui's text into the sprite batch, at a
+		position on screen. The text is laid out again only when its text,
+		font, size or line spacing changed since the last call.
+	  \param GO
+		This param contains all the data required for rendering of the font,
+		the gameui component is used.
+	  \param x
+		x position of the text's origin on screen, before the gameui offset
+	  \param y
+		y position of the text's origin on screen, before the gameui offset
+*/
+/**************************************************************************/
+void FontsRender::RenderText(const std::map<char, Character>& font, GameObject* GO, float x, float y)
+{
+	GameUI* gui = (dynamic_cast<GameUI*>(GO->GetComponent(ComponentType::GameUI)));
+	GameUI::TextLayout& layout = gui->Layout;
 
-	for (int i = 0; i < lines.size(); i++)
+	if (layout.font_map != &font || layout.size != gui->GetSize() || layout.line_spacing != gui->GetLineSpacing()
+		|| layout.font != gui->GetTextFontFamily() || layout.text != gui->GetText())
 	{
-
-		Vec2 pos = { trf->Position.x + gui->x_offset ,
-				trf->Position.y + gui->y_offset };
-
-		pos.y -= static_cast<float>(i * gui->GetLineSpacing());
-
-
-		// iterate through all characters
-		std::string::const_iterator c;
-		for (c = lines[i].begin(); c != lines[i].end(); c++)
-		{
-			Character ch = font[*c];
-
-			float xpos = pos.x + ch.Bearing.x * gui->GetSize();
-			float ypos = pos.y - (ch.Size.y - ch.Bearing.y) * gui->GetSize();
-
-			float w = ch.Size.x * gui->GetSize();
-			float h = ch.Size.y * gui->GetSize();
-			// update VBO for each character
-
-			float vertices[6][4] = {
-				{ xpos,     ypos + h,   0.0f, 0.0f },
-				{ xpos,     ypos,       0.0f, 1.0f },
-				{ xpos + w, ypos,       1.0f, 1.0f },
-
-				{ xpos,     ypos + h,   0.0f, 0.0f },
-				{ xpos + w, ypos,       1.0f, 1.0f },
-				{ xpos + w, ypos + h,   1.0f, 0.0f }
-			};
-
-
-			// render glyph texture over quad
-			glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-
-			// update content of VBO memory
-			glBindBuffer(GL_ARRAY_BUFFER, FontsRender::VBO);
-			glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-			glEnable(GL_BLEND);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-			// render quad
-			glDrawArrays(GL_TRIANGLES, 0, 6);
-			// now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-			pos.x += (ch.Advance >> 6) * gui->GetSize(); // bitshift by 6 to get value in pixels (2^6 = 64)
-		}
-
+		layout.font_map = &font;
+		layout.font = gui->GetTextFontFamily();
+		layout.size = gui->GetSize();
+		layout.line_spacing = gui->GetLineSpacing();
+		layout.text = gui->GetText();
+		LayoutText(font, layout.text, layout.size, static_cast<float>(layout.line_spacing), layout);
 	}
-	
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
-
-	text_shdrpgm.UnUse();
-	
 
+	glm::vec4 RGBA = { gui->GetFontColor_vec3().x, gui->GetFontColor_vec3().y,gui->GetFontColor_vec3().z,gui->Alpha };
+	SubmitLayout(layout, x + gui->x_offset, y + gui->y_offset, gui->GetFontDepth(), RGBA, gui->VisibleChars);
 }
 
 /**************************************************************************/
@@ -407,7 +270,7 @@ void FontsRender::RenderText(std::map<char, Character> font, GameObject* GO)
 	the color of text rendered
 */
 /**************************************************************************/
-void FontsRender::RenderDEBUG_INFO(std::map<char, Character> font, DebugData data, float x, float y, float scale, glm::vec3 TextColor)
+void FontsRender::RenderDEBUG_INFO(const std::map<char, Character>& font, DebugData data, float x, float y, float scale, glm::vec3 TextColor)
 {
 	
 
@@ -415,6 +278,8 @@ void FontsRender::RenderDEBUG_INFO(std::map<char, Character> font, DebugData dat
 	debug_data_ss << " MouseCoord: " << data.Mouse_x_screencoord << "," << data.Mouse_y_screencoord 
 		<< "Frame: " << data.Frame_cnt
 		<< " GameObjects: " << data.GO_cnt
+		<< " Drawn: " << data.Drawn_cnt
+		<< " Culled: " << data.Culled_cnt
 		<< " FPS: " << std::setw(8) << std::setprecision(5) << static_cast<double>(1 / data.dt)
 		<< " Delta Time: " << data.dt;
 
@@ -446,7 +311,7 @@ void FontsRender::RenderDEBUG_INFO(std::map<char, Character> font, DebugData dat
 
 */
 /**************************************************************************/
-void FontsRender::RenderDEBUG_Performance_Data(std::map<char, Character> font, float y_increment, float x, float y, float scale, glm::vec3 TextColor)
+void FontsRender::RenderDEBUG_Performance_Data(const std::map<char, Character>& font, float y_increment, float x, float y, float scale, glm::vec3 TextColor)
 {
 	FontsRender::RenderText(font, "Performance Stats", x, y, 0.999f, scale*1.25f, TextColor,1.f);
 	//float curr_y = y;
@@ -494,4 +359,18 @@ std::vector<std::string> FontsRender::splitString(const std::string longtext_str
 
 	return tokens;
 		
-}
\ No newline at end of file
+}
+
+/**************************************************************************/
+	/*!
+	  \brief
+		Sets the outline and drop shadow of text rendered after this call.
+	  \param style
+		The outline and shadow to use, a default TextStyle turns both off
+	  */
+/**************************************************************************/
+void FontsRender::SetTextStyle(const TextStyle& style)
+{
+	Style = style;
+	Style.Outline = Style.Outline < 0.f ? 0.f : (Style.Outline > 0.9f ? 0.9f : Style.Outline);
+}
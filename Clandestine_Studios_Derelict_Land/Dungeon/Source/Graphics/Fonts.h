@@ -24,20 +24,40 @@
 #include <regex>
 
 #include FT_FREETYPE_H
+#include FT_MODULE_H
 
 //#define TESTING_OF_FONTSRENDER_RENDER
 
+// Glyphs are stored as signed distance fields rendered at SDF_GLYPH_SIZE px,
+// holding distances up to SDF_SPREAD px from the outline. Metrics are kept
+// at FONT_BASE_SIZE px, the size a text scale of 1 draws at.
+#define FONT_BASE_SIZE 48
+#define SDF_GLYPH_SIZE 32
+#define SDF_SPREAD 8
+
 struct Character {
-    unsigned int TextureID;  // ID handle of the glyph texture
-    glm::ivec2   Size;       // Size of glyph
-    glm::ivec2   Bearing;    // Offset from baseline to left/top of glyph
+    unsigned int TextureID;  // ID handle of the font's glyph atlas
+    glm::vec2    Size;       // Size of glyph
+    glm::vec2    Bearing;    // Offset from baseline to left/top of glyph
     unsigned int Advance;    // Offset to advance to next glyph
+    glm::vec2    UVMin;      // Top left of the glyph in the atlas
+    glm::vec2    UVMax;      // Bottom right of the glyph in the atlas
+};
+
+struct TextStyle
+{
+    float     Outline = 0.f;                        // Outline width, 0 to 1 of SDF_SPREAD, 0 for none
+    glm::vec4 OutlineColor = { 0.f, 0.f, 0.f, 1.f };
+    glm::vec2 ShadowOffset = { 0.f, 0.f };          // Drop shadow offset in pixels, 0 for none
+    glm::vec4 ShadowColor = { 0.f, 0.f, 0.f, 0.5f };
 };
 
 struct DebugData
 {
     int Frame_cnt;
     int GO_cnt;
+    int Drawn_cnt;
+    int Culled_cnt;
     float dt;
     int Mouse_x_screencoord;
     int Mouse_y_screencoord;
@@ -62,26 +82,10 @@ public:
     /**************************************************************************/
     /*!
       \brief
-        This function compilers the shader program , for rendering fonts 
-        specifically.
-    */
-    /**************************************************************************/
-    static void ShaderProgram_Setup();
-
-    /**************************************************************************/
-    /*!
-      \brief
-        This function initialise the shaderprogram's VAO and VBOs
-    */
-    /**************************************************************************/
-    static void ShaderProgram_Init();
-
-    /**************************************************************************/
-    /*!
-      \brief
-        This function initialise the shaderprogram's VAO and VBOs
+        This function queues a string of text into the sprite batch, drawn
+        on the next Batch::EndBatch and Batch::Flush
       \param font
-        This is a map of the fonts loaded, and its texture gluint
+        This is a map of the fonts loaded, and its atlas texture
       \param text
         This is a string of text to render
       \param x
@@ -95,13 +99,13 @@ public:
 
     */
     /**************************************************************************/
-    static void RenderText(std::map<char, Character> font, std::string text,  float x, float y, float z_depth ,  float scale, glm::vec3 TextColor, float TextAlpha);
+    static void RenderText(const std::map<char, Character>& font, std::string text,  float x, float y, float z_depth ,  float scale, glm::vec3 TextColor, float TextAlpha);
 
 
     /**************************************************************************/
         /*!
           \brief
-            This function initialise the shaderprogram's VAO and VBOs, ideally
+            This function queues a gameui's text into the sprite batch, ideally
             for the render of gameui font text that will contain
             rendering of multiple lines
           \param GO
@@ -109,7 +113,25 @@ public:
             include, components used are the transfrom and gameui components.
     */
     /**************************************************************************/
-    static void RenderText(std::map<char, Character> font,GameObject* GO);
+    static void RenderText(const std::map<char, Character>& font,GameObject* GO);
+
+    /**************************************************************************/
+        /*!
+          \brief
+            This function queues a gameui's text into the sprite batch, at a
+            position on screen. The laid out glyphs are cached in the gameui
+            and only laid out again when the text, font, size or line
+            spacing changes.
+          \param GO
+            This param contains all the data required for rendering of the font,
+            the gameui component is used.
+          \param x
+            x position of the text's origin on screen, before the gameui offset
+          \param y
+            y position of the text's origin on screen, before the gameui offset
+    */
+    /**************************************************************************/
+    static void RenderText(const std::map<char, Character>& font, GameObject* GO, float x, float y);
 
     /**************************************************************************/
     /*!
@@ -131,7 +153,7 @@ public:
         the color of text rendered
     */
     /**************************************************************************/
-    static void RenderDEBUG_INFO(std::map<char, Character> font, DebugData data, float x, float y, float scale, glm::vec3 TextColor);
+    static void RenderDEBUG_INFO(const std::map<char, Character>& font, DebugData data, float x, float y, float scale, glm::vec3 TextColor);
    
     /**************************************************************************/
     /*!
@@ -153,7 +175,7 @@ public:
         the color of text rendered
     */
     /**************************************************************************/
-    static void RenderDEBUG_Performance_Data(std::map<char, Character> font, float y_increment, float x, float y, float scale, glm::vec3 TextColor);
+    static void RenderDEBUG_Performance_Data(const std::map<char, Character>& font, float y_increment, float x, float y, float scale, glm::vec3 TextColor);
 
 
     /**************************************************************************/
@@ -170,13 +192,21 @@ public:
    /**************************************************************************/
    static std::vector<std::string> splitString(const std::string longtext_str, std::string delimiter);
 
+    /**************************************************************************/
+    /*!
+      \brief
+        Sets the outline and drop shadow of text rendered after this call.
+      \param style
+        The outline and shadow to use, a default TextStyle turns both off
+    */
+    /**************************************************************************/
+    static void SetTextStyle(const TextStyle& style);
+
 
     //Variables
     static GLint WindowWidth;
     static GLint WindowHeight;
-    static unsigned int VAO;
-    static unsigned int VBO;
-    static GLSLShader text_shdrpgm;
+    static TextStyle Style;
 
     static std::map<std::string, double> Sys_To_Percentage_MAP;
     
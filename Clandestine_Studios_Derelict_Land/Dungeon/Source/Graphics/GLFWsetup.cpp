@@ -9,6 +9,7 @@
 #include <iostream>
 #include <sstream>
 #include "Graphics/GLFWsetup.h"
+#include "Graphics/RenderThread.h"
 #include "Input/Input.h" // GetKeyInput
 
 // Static variables
@@ -146,7 +147,7 @@ void GLSetup::error_callback(int error, char const* description) {
 /**************************************************************************/
 void GLSetup::framebuffer_callback(GLFWwindow* ptr_win, int w, int h) {
 	glfwGetFramebufferSize(ptr_win, &w, &h);
-	glViewport(0, 0, w, h);
+	RenderThread::Submit([w, h] { glViewport(0, 0, w, h); });
 }
 /**************************************************************************/
 /*!
@@ -15,6 +15,11 @@
  /******************************************************************************/
 
 #include "Graphics.h"
+#include "Graphics/DebugDraw.h"
+#include "Graphics/RenderGrid.h"
+#include "Graphics/RenderStats.h"
+#include "Graphics/RenderThread.h"
+#include "Graphics/TextureLoader.h"
 
 //#define RENDER_TO_IMGUI_GAMEWINDOW
 //#define ACCURATE_BUTTONS_BUT_SHIFTED_GAMEUI
@@ -36,6 +41,32 @@ extern bool keystateI, keystateK, keystateJ, keystateL, keystateF11;
 Vec2 camera_drag_pos; // original position of camera when dragging
 bool fullscreen;
 
+//Culling
+RenderGrid render_grid;
+std::vector<char> visible_objects; // one flag per game object, filled by CullObjects
+
+//Static batches
+std::vector<char> static_objects; // one flag per game object, filled by UpdateStaticBatches
+
+/**************************************************************************/
+/*!
+  \brief
+	What a static object looked like when it was baked. Scripts write
+	transforms and colours directly, so this is compared every frame to find
+	baked objects that have changed since.
+*/
+/**************************************************************************/
+struct BakedState
+{
+	Transform* go;
+	Renderer* RDR;
+	Vec2 position, scale, dimensions, uvmin, uvmax;
+	float depth, rotation, alpha;
+	Vec3 rgb;
+	std::string texhandle;
+};
+std::vector<BakedState> baked_states;
+
 
 /**************************************************************************/
 /*!
@@ -96,21 +127,32 @@ void Graphics::Init() {
 #endif	
 
 	mFrameBuffer = std::make_shared<FrameBuffer>(CurrentWidth, CurrentHeight);
-
+	// Textures are loaded at the tier matching the framebuffer
+	MasterObjectList->MasterAssets.SetOutputSize(CurrentWidth, CurrentHeight);
+
+	// Images are decoded in the background and show up over the first frames
+	TextureLoader::Init();
+	// Long animations are read a few frames at a time while they play
+	FlipbookStream::Init();
+	// Atlas remap table has to be read before any texture it covers is added
+	FilePtr::DeserializeAtlas("./Data/TextureAtlas.txt", MasterObjectList->MasterAssets);
+	FilePtr::DeserializeTextureBudget("./Data/TextureBudget.txt", MasterObjectList->MasterAssets);
 	FilePtr::DeserializeTextures("./Data/SpriteSheets.txt", MasterObjectList->MasterAssets);
 	FilePtr::DeserializeShaders("./Data/Shaders.txt", MasterObjectList->MasterAssets);
 	FilePtr::DeserializeFonts("./Data/Fonts.txt", MasterObjectList->MasterAssets);
 	FilePtr::DeserializeSpriteSheet("./Data/SpriteAnimations.txt", MasterObjectList->MasterAssets);
+	FilePtr::DeserializeFlipbooks("./Data/Flipbooks.txt", MasterObjectList->MasterAssets);
 
 	this->GetLevel()->GetAssets() = &MasterObjectList->MasterAssets;
 
 	Batch::line_shader_program = MasterObjectList->MasterAssets.GetShader("Line");
 	Batch::quad_shader_program = MasterObjectList->MasterAssets.GetShader("Quad");
-	FontsRender::text_shdrpgm = MasterObjectList->MasterAssets.GetShader("Font");
+	Batch::sprite_shader_program = MasterObjectList->MasterAssets.GetShader("Sprite");
+	DebugDraw::shader_program = MasterObjectList->MasterAssets.GetShader("Debug");
 
 	Batch::Init();
+	DebugDraw::Init(MasterObjectList->MasterAssets.GetFont("Roboto"));
 	FontsRender::Init(GetWindowWidth(), GetWindowHeight());
-	FontsRender::ShaderProgram_Init();
 
 	Batch::camera.SetCameraSpeed(5.f);
 	show_debug_Data = !fullscreen;
@@ -132,44 +174,232 @@ void DrawGizmos(const TransformMode mode, const bool isUI)
 {
 	Transform* go = dynamic_cast<Transform*>(editor->GetPropertyEditor().GetSelectedGameObject()->GetComponent(ComponentType::Transform));
 	if (go == nullptr) return;
-	// If the selected object has the GameUI component, then the gizmos will be drawn with the main camera's position temporarily added in.
-	// AKA, the GO itself is temporarily moved.
-	if (isUI) { go->Position += Vec2{ Batch::camera.GetCameraPosition().x, Batch::camera.GetCameraPosition().y }; }
-
+	// If the selected object has the GameUI component, then the gizmos will be drawn with the main camera's position added in.
+	const glm::vec2 pos = glm::vec2{ go->Position.x, go->Position.y } + (isUI ? glm::vec2(Batch::camera.GetCameraPosition()) : glm::vec2(0.f));
 	if (mode == TransformMode::Translate)
 	{
-		Batch::DrawLine({ go->Position.x, go->Position.y, 1.0f }, { go->Position.x + gizmosXLength, go->Position.y, 1.0f }, { 1,0,0,1 });
-		Batch::DrawLine({ go->Position.x, go->Position.y, 1.0f }, { go->Position.x, go->Position.y + gizmosYLength, 1.0f }, { 0,1,0,1 });
-		// ... and a box at the corner of the gizmos. (0.9f is the depth of the 'gizmos')
-		Batch::DrawQuad({ go->Position.x + gizmosXLength * 0.15f, go->Position.y + gizmosYLength * 0.15f, 1.0f },
-			{ 30.0f, 30.0f }, { 100,100 }, { 0,0,1,0.5f }, 0.0f);
+		DebugDraw::Arrow(pos, pos + glm::vec2(gizmosXLength, 0.f), { 1,0,0,1 }, 15.f, 4.f, DebugDraw::Gizmos);
+		DebugDraw::Arrow(pos, pos + glm::vec2(0.f, gizmosYLength), { 0,1,0,1 }, 15.f, 4.f, DebugDraw::Gizmos);
+		// ... and a box at the corner of the gizmos.
+		DebugDraw::Rect(pos + glm::vec2(gizmosXLength, gizmosYLength) * 0.15f, { 30.0f, 30.0f }, { 0,0,1,0.5f }, 0.f, 0.f, DebugDraw::Gizmos);
 	}
 	else if (mode == TransformMode::Rotate)
 	{
-		float x1, x2, y1, y2; const float radius = 50.0f;
-		// draw a (rather expensive) circle of 360 lines
-		for (int i = 0; i < 360; ++i)
-		{
-			x1 = go->Position.x + cos(glm::radians(float(i))) * radius;
-			y1 = go->Position.y + sin(glm::radians(float(i))) * radius;
-			x2 = go->Position.x + cos(glm::radians(i + 1.0f)) * radius;
-			y2 = go->Position.y + sin(glm::radians(i + 1.0f)) * radius;
-			Batch::DrawLine({ x1, y1, 1.0f }, { x2, y2, 1.0f }, { 1, 0, 0, 1 });
-		}
+		DebugDraw::Circle(pos, 50.0f, { 1,0,0,1 }, 4.f, DebugDraw::Gizmos);
 	}
 	else if (mode == TransformMode::Scale)
 	{
-		Batch::DrawLine({ go->Position.x, go->Position.y, 0.99f }, { go->Position.x + gizmosXLength, go->Position.y, 1.0f }, { 1,0,0,1 });
-		Batch::DrawLine({ go->Position.x, go->Position.y, 0.99f }, { go->Position.x, go->Position.y + gizmosYLength, 1.0f }, { 0,1,0,1 });
+		DebugDraw::ThickLine(pos, pos + glm::vec2(gizmosXLength, 0.f), 4.f, { 1,0,0,1 }, DebugDraw::Gizmos);
+		DebugDraw::ThickLine(pos, pos + glm::vec2(0.f, gizmosYLength), 4.f, { 0,1,0,1 }, DebugDraw::Gizmos);
 		// draw small quads at the ends of the two lines
-		Batch::DrawQuad({ go->Position.x + gizmosXLength, go->Position.y, 1.0f }, { 15.0f, 15.0f }, { 100,100 }, { 1,0,0,1 });
-		Batch::DrawQuad({ go->Position.x, go->Position.y + gizmosYLength, 1.0f }, { 15.0f, 15.0f }, { 100,100 }, { 0,1,0,1 });
+		DebugDraw::Rect(pos + glm::vec2(gizmosXLength, 0.f), { 15.0f, 15.0f }, { 1,0,0,1 }, 0.f, 0.f, DebugDraw::Gizmos);
+		DebugDraw::Rect(pos + glm::vec2(0.f, gizmosYLength), { 15.0f, 15.0f }, { 0,1,0,1 }, 0.f, 0.f, DebugDraw::Gizmos);
 		// and another at the center for general scaling
-		Batch::DrawQuad({ go->Position.x, go->Position.y, 1.0f }, { 30.0f, 30.0f }, { 100,100 }, { 1,1,1,1 });
+		DebugDraw::Rect(pos, { 30.0f, 30.0f }, { 1,1,1,1 }, 0.f, 0.f, DebugDraw::Gizmos);
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Marks which game objects are on screen. World objects are put in a grid
+	and queried with the camera rectangle, UI objects are drawn relative to
+	the camera so they are tested against the screen directly. The drawn and
+	culled counts go into the debug data.
+  \param objects
+	Game objects of the level.
+*/
+/**************************************************************************/
+void CullObjects(std::vector<GameObject*>& objects)
+{
+	static std::vector<size_t> hits;
+	render_grid.Clear();
+	hits.clear();
+	visible_objects.assign(objects.size(), 0);
+
+	glm::vec2 screen{ static_cast<float>(GLSetup::width), static_cast<float>(GLSetup::height) };
+	glm::vec2 cam_min{ Batch::camera.GetCameraPosition().x, Batch::camera.GetCameraPosition().y };
+	int candidates = 0, drawn = 0;
+
+	for (size_t i = 1; i < objects.size(); ++i)
+	{
+		if (objects[i]->GetActive() == false) { continue; }
+		if (objects[i]->GetComponent(ComponentType::GameUI) == nullptr) { continue; }
+		if (!GameObject::GetLayerMask().test(std::distance(GameObject::GetLayers().begin(), std::find(GameObject::GetLayers().begin(), GameObject::GetLayers().end(), objects[i]->layer)))) { continue; }
+		Transform* go = dynamic_cast<Transform*>(objects[i]->GetComponent(ComponentType::Transform));
+		if (go == nullptr) { continue; }
+		++candidates;
+
+		// Quads are drawn centered on Position with size Dimensions * Scale / 100
+		glm::vec2 half = glm::abs(glm::vec2{ go->Dimensions.x * go->Scale.x, go->Dimensions.y * go->Scale.y }) / 200.f;
+		if (go->RotationAngle != 0.f) { float radius = glm::length(half); half = { radius, radius }; }
+		glm::vec2 center{ go->Position.x, go->Position.y };
+
+		if (objects[i]->layer == "UI")
+		{
+			if (center.x + half.x >= 0.f && center.x - half.x <= screen.x && center.y + half.y >= 0.f && center.y - half.y <= screen.y)
+			{
+				visible_objects[i] = 1;
+				++drawn;
+			}
+		}
+		else { render_grid.Insert(i, center, half); }
+	}
+
+	render_grid.Query(cam_min, cam_min + screen, hits);
+	for (size_t i : hits) { visible_objects[i] = 1; }
+	drawn += static_cast<int>(hits.size());
+
+	debug_data.Drawn_cnt = drawn;
+	debug_data.Culled_cnt = candidates - drawn;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Checks if a game object can be baked into the static batches: a visible
+	world Renderer with nothing that moves it or changes how it looks.
+  \param object
+	Game object to check.
+  \return
+	True if the object is static.
+*/
+/**************************************************************************/
+bool IsStaticObject(GameObject* object)
+{
+	if (object->GetActive() == false || object->layer == "UI") { return false; }
+	if (object->GetComponent(ComponentType::GameUI) == nullptr || object->GetComponent(ComponentType::Transform) == nullptr) { return false; }
+	if (!GameObject::GetLayerMask().test(std::distance(GameObject::GetLayers().begin(), std::find(GameObject::GetLayers().begin(), GameObject::GetLayers().end(), object->layer)))) { return false; }
+
+	Renderer* RDR = dynamic_cast<Renderer*>(object->GetComponent(ComponentType::Renderer));
+	if (RDR == nullptr || !RDR->GetVisibility() || RDR->isDynamic) { return false; }
+
+	// Anything with physics, logic, input, animation or scripts may change every frame
+	if (object->GetComponent(ComponentType::RigidBody) || object->GetComponent(ComponentType::Logic) ||
+		object->GetComponent(ComponentType::Controller) || object->GetComponent(ComponentType::Animate)) { return false; }
+	for (int type = static_cast<int>(ComponentType::LogicTargets); type < static_cast<int>(ComponentType::ComponentTypeSize); ++type)
+	{
+		if (object->GetComponent(static_cast<ComponentType>(type))) { return false; }
+	}
+
+	Collision* col = dynamic_cast<Collision*>(object->GetComponent(ComponentType::Collision));
+	return col == nullptr || col->Body == BodyType::Static;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Draws an object's animated sprite. The object's playback goes with the
+	sprite and the frame is picked in sprite.vert. Streamed flipbooks are
+	drawn from the texture holding the current frame instead.
+  \param pos
+	Position(x,y,z) to draw at, offset by the camera for UI.
+  \param go
+	Transform of the object.
+  \param Anim
+	Animate component of the object.
+  \param assets
+	Assets to get the sprite sheet from.
+*/
+/**************************************************************************/
+void DrawAnimation(const glm::vec3& pos, Transform* go, Animate* Anim, Assets* assets)
+{
+	glm::vec4 clr{ Anim->RGB_0to1.x, Anim->RGB_0to1.y, Anim->RGB_0to1.z, Anim->Alpha_0to1 };
+	if (FlipbookStream* stream = assets->GetFlipbook(Anim->GetTexHandle())) {
+		GLuint texid = stream->Show(Anim->GetCurrentFrame(), Anim->GetLoop());
+		glm::vec2 whole{ 1.f, 1.f };
+		Batch::DrawSprite(pos, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y }, texid ? texid : TextureLoader::GetPlaceholder(), { 0.f, 0.f }, whole,
+			clr, go->RotationAngle);
+		return;
 	}
 
-	// Once the gizmos for any UI object is drawn, the GO's position is then returned to its original value.
-	if (isUI) { go->Position -= Vec2{ Batch::camera.GetCameraPosition().x, Batch::camera.GetCameraPosition().y }; }
+	const Assets::Sprite& sheet = assets->GetSprite(Anim->GetTexHandle());
+	Batch::Flipbook flipbook = Animation::GetFlipbook(Anim, sheet);
+	const glm::vec2& first = sheet.texcoords[flipbook.Frames > 1 ? 0 : Anim->GetCurrentFrame()];
+	Batch::DrawAnimatedSprite(pos, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y }, sheet.texid, first, sheet.texsize, flipbook,
+		clr, go->RotationAngle);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Checks if a baked object still looks the way it was baked.
+  \param baked
+	State of the object when it was baked.
+  \return
+	True if nothing drawn from the object has changed.
+*/
+/**************************************************************************/
+bool IsUnchanged(const BakedState& baked)
+{
+	const Transform* go = baked.go;
+	const Renderer* RDR = baked.RDR;
+	return go->Position.x == baked.position.x && go->Position.y == baked.position.y && go->Depth == baked.depth &&
+		go->Scale.x == baked.scale.x && go->Scale.y == baked.scale.y &&
+		go->Dimensions.x == baked.dimensions.x && go->Dimensions.y == baked.dimensions.y && go->RotationAngle == baked.rotation &&
+		RDR->RGB_0to1.x == baked.rgb.x && RDR->RGB_0to1.y == baked.rgb.y && RDR->RGB_0to1.z == baked.rgb.z && RDR->Alpha_0to1 == baked.alpha &&
+		RDR->Tex_UV_Min_COORD.x == baked.uvmin.x && RDR->Tex_UV_Min_COORD.y == baked.uvmin.y &&
+		RDR->Tex_UV_Max_COORD.x == baked.uvmax.x && RDR->Tex_UV_Max_COORD.y == baked.uvmax.y &&
+		RDR->isVisible && RDR->TexHandle == baked.texhandle;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Bakes non-moving level art into static batches so it is not queued and
+	uploaded every frame. The batches are only rebaked once flagged with
+	Batch::InvalidateStatic, which objects being added or removed, editor
+	changes, visibility changes and baked textures being loaded or evicted
+	do. A baked object that a script moves or recolours is taken out of the
+	batches and drawn with the dynamic objects from then on.
+  \param objects
+	Game objects of the level.
+  \param assets
+	Assets to get textures from.
+*/
+/**************************************************************************/
+void UpdateStaticBatches(std::vector<GameObject*>& objects, Assets* assets)
+{
+	if (!Batch::IsStaticDirty() && static_objects.size() == objects.size())
+	{
+		// Objects are only removed after invalidating, so the baked pointers are still good here
+		for (const BakedState& baked : baked_states)
+		{
+			if (IsUnchanged(baked)) { continue; }
+			baked.RDR->isDynamic = true;
+			Batch::InvalidateStatic();
+		}
+		if (!Batch::IsStaticDirty()) { return; }
+	}
+	static_objects.assign(objects.size(), 0);
+	baked_states.clear();
+	assets->ClearBaked();
+
+	Batch::BeginStatic();
+	Batch::SetLayer(RenderQueue::World);
+	for (size_t i = 1; i < objects.size(); ++i)
+	{
+		if (!IsStaticObject(objects[i])) { continue; }
+		Transform* go = dynamic_cast<Transform*>(objects[i]->GetComponent(ComponentType::Transform));
+		Renderer* RDR = dynamic_cast<Renderer*>(objects[i]->GetComponent(ComponentType::Renderer));
+		static_objects[i] = 1;
+		baked_states.push_back({ go, RDR, go->Position, go->Scale, go->Dimensions, RDR->Tex_UV_Min_COORD, RDR->Tex_UV_Max_COORD,
+			go->Depth, go->RotationAngle, RDR->Alpha_0to1, RDR->RGB_0to1, RDR->TexHandle });
+
+		if (RDR->GetTexHandle() == "" || RDR->GetTexHandle() == "-")
+		{
+			Batch::DrawQuad({ go->Position.x, go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
+				{ RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, go->RotationAngle);
+		}
+		else {
+			Assets::Sprite tex = assets->GetTexture(RDR->GetTexHandle());
+			Batch::DrawQuadWithPixelCoords({ go->Position.x, go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
+				tex.texid, { RDR->GetUVMin().x,  RDR->GetUVMin().y }, { RDR->GetUVMax().x,  RDR->GetUVMax().y },
+				tex.texsize, { RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, 0.f, tex.uvmin, tex.uvmax, tex.opaque);
+			assets->MarkBaked(RDR->GetTexHandle());
+		}
+	}
+	Batch::EndStatic();
 }
 
 /**************************************************************************/
@@ -184,6 +414,11 @@ void Graphics::Update(float dt) {
 	if (this->GetLevel()->GetAssets() == nullptr) {
 		this->GetLevel()->GetAssets() = &MasterObjectList->MasterAssets;
 	}
+	// The editor's panels load textures and draw ImGui inline, so the render thread only runs in game
+	if (editor_open) { RenderThread::Stop(); }
+	else { RenderThread::Start(); }
+	// Loads what the scene references and evicts unused textures over the budget
+	MasterObjectList->MasterAssets.Update();
 	//SetVSync(!editor_open);
 	if (keystateF11) {
 		GLFWmonitor* monitor = glfwGetPrimaryMonitor();
@@ -195,7 +430,8 @@ void Graphics::Update(float dt) {
 		GLSetup::current_width = CurrentWidth = fullscreen ? glfwGetVideoMode(monitor)->width : WindowWidth;
 		GLSetup::current_height = CurrentHeight = fullscreen ? glfwGetVideoMode(monitor)->height : WindowHeight;
 #endif	
-		mFrameBuffer = std::make_shared<FrameBuffer>(CurrentWidth, CurrentHeight);
+		RenderThread::Submit([this, w = CurrentWidth, h = CurrentHeight] { mFrameBuffer = std::make_shared<FrameBuffer>(w, h); });
+		MasterObjectList->MasterAssets.SetOutputSize(CurrentWidth, CurrentHeight);
 		glfwSetWindowMonitor(GLSetup::ptr_window, fullscreen ? glfwGetPrimaryMonitor() : NULL, 500, 200, CurrentWidth, CurrentHeight, glfwGetVideoMode(monitor)->refreshRate);
 		keystateF11 = false;
 	}
@@ -203,7 +439,10 @@ void Graphics::Update(float dt) {
 	//if(GW::Statics::GameWindowOpen)mFrameBuffer->BindFrameBuffer();
 	if (editor_open) {
 		//#ifdef RENDER_TO_IMGUI_GAMEWINDOW
-		mFrameBuffer->BindFrameBuffer();
+		RenderThread::Submit([this] {
+			mFrameBuffer->BindFrameBuffer();
+			RenderStats::Begin(RenderStats::EditorFBO);
+		});
 		//#endif
 	}
 	// Emulate functions
@@ -256,14 +495,23 @@ void Graphics::Update(float dt) {
 		}
 	}
 	Batch::camera.SetCameraPosition(glm::vec3(cam->Position.x - GLSetup::width * 0.5f, cam->Position.y - GLSetup::height * 0.5f, 0.f));
+	CullObjects(this->GetLevel()->GetGameObjectArray());
+	UpdateStaticBatches(this->GetLevel()->GetGameObjectArray(), this->GetLevel()->GetAssets());
 
 	// Draw functions
-	glfwSwapBuffers(GLSetup::ptr_window);
-	// clear color buffer | depth buffer
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	glClearColor(0.f, 0.f, 0.f, 0.f);
-	//glClearDepth(1.f);
+	// The last frame is closed before its swap, the editor's ImGui pass comes after Graphics
+	RenderThread::Submit([frame_ms = (float)(GLSetup::delta_time * 1000.0)] {
+		RenderStats::EndFrame(frame_ms);
+		glfwSwapBuffers(GLSetup::ptr_window);
+		TextureLoader::Update();
+		FlipbookStream::Update();
+		// clear color buffer | depth buffer
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		glClearColor(0.f, 0.f, 0.f, 0.f);
+		//glClearDepth(1.f);
+	});
 	Batch::SetLineWidth(5.f);
+	Batch::SetFrameTime(dt);
 	Batch::StartBatch();
 
 
@@ -288,26 +536,15 @@ void Graphics::Update(float dt) {
 			Lighting* Light = dynamic_cast<Lighting*>((this->GetLevel()->GetGameObjectArray())[i]->GetComponent(ComponentType::Lighting));
 			
 
-			if (GAMEUI != nullptr)
+			if (GAMEUI != nullptr && visible_objects[i] && !static_objects[i])
 			{	
-				//for simple culling
-				glm::vec2 Pos{ (go->Position.x + go->Dimensions.x) * go->Scale.x , (go->Position.y + go->Dimensions.y) * go->Scale.y };
-				if (Pos.x > cam->Position.x + GLSetup::current_width / 2
-					&& Pos.x < cam->Position.x - GLSetup::current_width / 2
-					&& Pos.y > cam->Position.y + GLSetup::current_height / 2
-					&& Pos.y < cam->Position.y - GLSetup::current_height / 2) continue;
+				Batch::SetLayer(this->GetLevel()->GetGameObjectArray()[i]->layer == "UI" ? RenderQueue::UI : RenderQueue::World);
 				if (Anim != nullptr && Anim->GetVisibility()) {
 					if (this->GetLevel()->GetGameObjectArray()[i]->layer == "UI") {
-						Batch::DrawSprite({ Batch::camera.GetCameraPosition().x + go->Position.x, Batch::camera.GetCameraPosition().y + go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texid,
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texcoords[this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).idx],
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texsize, { Anim->RGB_0to1.x, Anim->RGB_0to1.y, Anim->RGB_0to1.z, Anim->Alpha_0to1 }, go->RotationAngle);
+						DrawAnimation({ Batch::camera.GetCameraPosition().x + go->Position.x, Batch::camera.GetCameraPosition().y + go->Position.y, go->Depth }, go, Anim, this->GetLevel()->GetAssets());
 					}
 					else {
-						Batch::DrawSprite({ go->Position.x, go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texid,
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texcoords[this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).idx],
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texsize, { Anim->RGB_0to1.x, Anim->RGB_0to1.y, Anim->RGB_0to1.z, Anim->Alpha_0to1 }, go->RotationAngle);
+						DrawAnimation({ go->Position.x, go->Position.y, go->Depth }, go, Anim, this->GetLevel()->GetAssets());
 					}
 				}
 				else if (RDR != nullptr && RDR->GetVisibility()) // if active 
@@ -319,9 +556,10 @@ void Graphics::Update(float dt) {
 								{ RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, go->RotationAngle);
 
 						else {
+							Assets::Sprite tex = this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle());
 							Batch::DrawQuadWithPixelCoords({ Batch::camera.GetCameraPosition().x + go->Position.x,Batch::camera.GetCameraPosition().y + go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
-								this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle()).texid, { RDR->GetUVMin().x,  RDR->GetUVMin().y }, { RDR->GetUVMax().x,  RDR->GetUVMax().y },
-								this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle()).texsize, { RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 });
+								tex.texid, { RDR->GetUVMin().x,  RDR->GetUVMin().y }, { RDR->GetUVMax().x,  RDR->GetUVMax().y },
+								tex.texsize, { RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, 0.f, tex.uvmin, tex.uvmax);
 						}
 					}
 					else
@@ -332,9 +570,10 @@ void Graphics::Update(float dt) {
 								{ RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, go->RotationAngle);
 						}
 						else {
+							Assets::Sprite tex = this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle());
 							Batch::DrawQuadWithPixelCoords({ go->Position.x, go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
-								this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle()).texid, { RDR->GetUVMin().x,  RDR->GetUVMin().y }, { RDR->GetUVMax().x,  RDR->GetUVMax().y },
-								this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle()).texsize, { RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 });
+								tex.texid, { RDR->GetUVMin().x,  RDR->GetUVMin().y }, { RDR->GetUVMax().x,  RDR->GetUVMax().y },
+								tex.texsize, { RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, 0.f, tex.uvmin, tex.uvmax);
 						}
 					}
 				}
@@ -351,11 +590,8 @@ void Graphics::Update(float dt) {
 			{
 				if (col->showBox)
 				{
-
-					if (col->go_is_colliding == true)
-						Batch::DrawBox({ go->Position.x, go->Position.y, 1.0f }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y }, { 1,0,0,1 });
-					else
-						Batch::DrawBox({ go->Position.x, go->Position.y, 1.0f }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y }, { 0,1,0,1 });
+					DebugDraw::Rect({ go->Position.x, go->Position.y }, glm::vec2(go->Dimensions.x * go->Scale.x, go->Dimensions.y * go->Scale.y) * 0.01f,
+						col->go_is_colliding ? glm::vec4{ 1,0,0,1 } : glm::vec4{ 0,1,0,1 }, DebugDraw::DefaultThickness, 0.f, DebugDraw::Colliders);
 				}
 			}
 			//std::cout << this->GetLevel()->GetGameObjectArray()[i]->GetName() << std::endl;
@@ -368,8 +604,6 @@ void Graphics::Update(float dt) {
 		//GameUI::RenderButtonWImage({ 70,825,0.9999 }, { 25,25 }, { 200.f, 200.f }, AssetsManager.GetTexture("ExitBtn"));
 		if (pointlights.size() > 0)
 			Batch::SetLight(pointlights);
-		Batch::EndBatch();
-		Batch::Flush();
 
 		// THIS SPACE RESERVED FOR FONT 
 		for (int i = 0; i < this->GetLevel()->GetGameUILayer().size(); ++i)
@@ -397,14 +631,7 @@ void Graphics::Update(float dt) {
 						continue;
 
 
-					FontsRender::RenderText(this->GetLevel()->GetAssets()->GetFont(gui->GetTextFontFamily().c_str()),
-						gui->GetText(),
-						pos_x_vp + gui->x_offset,
-						pos_y_vp + gui->y_offset,
-						gui->GetFontDepth(),
-						gui->GetSize(),
-						glm::vec3(gui->GetFontColor_vec3().x, gui->GetFontColor_vec3().y, gui->GetFontColor_vec3().z),
-						gui->Alpha);
+					FontsRender::RenderText(this->GetLevel()->GetAssets()->GetFont(gui->GetTextFontFamily()), (this->GetLevel()->GetGameUILayer())[i], pos_x_vp, pos_y_vp);
 
 				}
 			}
@@ -418,6 +645,17 @@ void Graphics::Update(float dt) {
 			FontsRender::RenderDEBUG_Performance_Data(this->GetLevel()->GetAssets()->GetFont("Roboto"), 0.025f * WindowHeight, 0.1f * WindowWidth, 0.75f * WindowHeight, 0.5f, glm::vec3(0.0f, 0.0f, 0.0f));
 			
 		} // DEBUG
+
+		DebugDraw::DrawLabels();
+		// Baked level art is drawn under the batch
+		Batch::DrawStatic();
+		// Text is batched with the UI, so the batch is drawn after it is queued
+		Batch::EndBatch();
+		RenderThread::Submit([] { RenderStats::Begin(RenderStats::World); });
+		Batch::Flush();
+		// Gizmos and collider boxes go over the whole pass in one call
+		DebugDraw::Flush(dt);
+		RenderThread::Submit([] { RenderStats::End(RenderStats::World); });
 	}
 	else {
 		// Rendering game objects in the current scene
@@ -439,24 +677,15 @@ void Graphics::Update(float dt) {
 			
 			
 
-			if (GAMEUI != nullptr)
+			if (GAMEUI != nullptr && visible_objects[i] && !static_objects[i])
 			{
-				//for simple culling
-				glm::vec2 Pos{ (go->Position.x + go->Dimensions.x) * go->Scale.x , (go->Position.y + go->Dimensions.y) * go->Scale.y };
-				if (Pos.x > cam->Position.x + GLSetup::current_width / 2
-					&& Pos.x < cam->Position.x - GLSetup::current_width / 2
-					&& Pos.y > cam->Position.y + GLSetup::current_height / 2
-					&& Pos.y < cam->Position.y - GLSetup::current_height / 2) continue;
-
+				Batch::SetLayer(this->GetLevel()->GetGameObjectArray()[i]->layer == "UI" ? RenderQueue::UI : RenderQueue::World);
 				if (this->GetLevel()->GetGameObjectArray()[i]->layer == "UI")
 					continue;
 
 				if (Anim != nullptr && Anim->GetVisibility()) {
 					if (this->GetLevel()->GetGameObjectArray()[i]->layer != "UI") {
-						Batch::DrawSprite({ go->Position.x, go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texid,
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texcoords[this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).idx],
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texsize, { Anim->RGB_0to1.x, Anim->RGB_0to1.y, Anim->RGB_0to1.z, Anim->Alpha_0to1 }, go->RotationAngle);
+						DrawAnimation({ go->Position.x, go->Position.y, go->Depth }, go, Anim, this->GetLevel()->GetAssets());
 					}
 				}
 				else if (RDR != nullptr && RDR->GetVisibility()) // if active 
@@ -468,9 +697,10 @@ void Graphics::Update(float dt) {
 								{ RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, go->RotationAngle);
 						}
 						else {
+							Assets::Sprite tex = this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle());
 							Batch::DrawQuadWithPixelCoords({ go->Position.x, go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
-								this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle()).texid, { RDR->GetUVMin().x,  RDR->GetUVMin().y }, { RDR->GetUVMax().x,  RDR->GetUVMax().y },
-								this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle()).texsize, { RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 });
+								tex.texid, { RDR->GetUVMin().x,  RDR->GetUVMin().y }, { RDR->GetUVMax().x,  RDR->GetUVMax().y },
+								tex.texsize, { RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, 0.f, tex.uvmin, tex.uvmax);
 						}
 					}
 				}
@@ -480,11 +710,8 @@ void Graphics::Update(float dt) {
 			{
 				if (col->showBox)
 				{
-
-					if (col->go_is_colliding == true)
-						Batch::DrawBox({ go->Position.x, go->Position.y, 1.0f }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y }, { 1,0,0,1 });
-					else
-						Batch::DrawBox({ go->Position.x, go->Position.y, 1.0f }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y }, { 0,1,0,1 });
+					DebugDraw::Rect({ go->Position.x, go->Position.y }, glm::vec2(go->Dimensions.x * go->Scale.x, go->Dimensions.y * go->Scale.y) * 0.01f,
+						col->go_is_colliding ? glm::vec4{ 1,0,0,1 } : glm::vec4{ 0,1,0,1 }, DebugDraw::DefaultThickness, 0.f, DebugDraw::Colliders);
 				}
 			}
 			//std::cout << this->GetLevel()->GetGameObjectArray()[i]->GetName() << std::endl;
@@ -495,8 +722,6 @@ void Graphics::Update(float dt) {
 
 		//GAME UI
 		//GameUI::RenderButtonWImage({ 70,825,0.9999 }, { 25,25 }, { 200.f, 200.f }, AssetsManager.GetTexture("ExitBtn"));
-		Batch::EndBatch();
-		Batch::Flush();
 
 			// THIS SPACE RESERVED FOR FONT 
 		for (int i = 0; i < this->GetLevel()->GetGameUILayer().size(); ++i)
@@ -525,14 +750,7 @@ void Graphics::Update(float dt) {
 						continue;
 
 
-					FontsRender::RenderText(this->GetLevel()->GetAssets()->GetFont(gui->GetTextFontFamily().c_str()),
-						gui->GetText(),
-						pos_x_vp + gui->x_offset,
-						pos_y_vp + gui->y_offset,
-						gui->GetFontDepth(),
-						gui->GetSize(),
-						glm::vec3(gui->GetFontColor_vec3().x, gui->GetFontColor_vec3().y, gui->GetFontColor_vec3().z),
-						gui->Alpha);
+					FontsRender::RenderText(this->GetLevel()->GetAssets()->GetFont(gui->GetTextFontFamily()), (this->GetLevel()->GetGameUILayer())[i], pos_x_vp, pos_y_vp);
 
 				}
 			}
@@ -546,6 +764,17 @@ void Graphics::Update(float dt) {
 		//	FontsRender::RenderDEBUG_Performance_Data(this->GetLevel()->GetAssets()->GetFont("Roboto"), 0.025f * WindowHeight, 0.1f * WindowWidth, 0.75f * WindowHeight, 0.5f, glm::vec3(0.0f, 0.0f, 0.0f));
 		//	
 		//} // DEBUG
+
+		DebugDraw::DrawLabels();
+		// Baked level art is drawn under the batch
+		Batch::DrawStatic();
+		// Text is batched with the UI, so the batch is drawn after it is queued
+		Batch::EndBatch();
+		RenderThread::Submit([] { RenderStats::Begin(RenderStats::World); });
+		Batch::Flush();
+		// Gizmos and collider boxes go over the whole pass in one call
+		DebugDraw::Flush(dt);
+		RenderThread::Submit([] { RenderStats::End(RenderStats::World); });
 	}
 
 	GLSetup::frame_no++;
@@ -556,8 +785,11 @@ void Graphics::Update(float dt) {
 	if (editor_open)
 	{
 		//#ifdef RENDER_TO_IMGUI_GAMEWINDOW
-		mFrameBuffer->UnbindFrameBuffer();
-		GW::Statics::texID = mFrameBuffer->GetTextureID();
+		RenderThread::Submit([this] {
+			RenderStats::End(RenderStats::EditorFBO);
+			mFrameBuffer->UnbindFrameBuffer();
+			GW::Statics::texID = mFrameBuffer->GetTextureID();
+		});
 		//#endif
 	}
 
@@ -568,15 +800,18 @@ void Graphics::AdditionalUpdate(float dt) {
 	(void)dt;
 	if (editor_open) {
 		//#ifdef RENDER_TO_IMGUI_GAMEWINDOW
-		mFrameBuffer->BindFrameBuffer();
+		RenderThread::Submit([this] {
+			mFrameBuffer->BindFrameBuffer();
+			RenderStats::Begin(RenderStats::EditorFBO);
+		});
 		//#endif
 	}
 
 	if (!editor_open) {
-		Transform* cam = (GameObject::FindWithTag("Camera", this->GetLevel()->GetGameObjectArray())->GetComponent<Transform>());
 		// Lights
 		std::vector<Lighting::PointLight> pointlights{};
 
+		CullObjects(this->GetLevel()->GetGameObjectArray());
 		Batch::StartBatch();
 		for (size_t i = 1; i < this->GetLevel()->GetGameObjectArray().size(); ++i)
 		{
@@ -595,24 +830,15 @@ void Graphics::AdditionalUpdate(float dt) {
 
 			
 
-			if (GAMEUI != nullptr)
+			if (GAMEUI != nullptr && visible_objects[i])
 			{
-				//for simple culling
-				glm::vec2 Pos{ (go->Position.x + go->Dimensions.x) * go->Scale.x , (go->Position.y + go->Dimensions.y) * go->Scale.y };
-				if (Pos.x > cam->Position.x + GLSetup::current_width / 2
-					&& Pos.x < cam->Position.x - GLSetup::current_width / 2
-					&& Pos.y > cam->Position.y + GLSetup::current_height / 2
-					&& Pos.y < cam->Position.y - GLSetup::current_height / 2) continue;
-
+				Batch::SetLayer(this->GetLevel()->GetGameObjectArray()[i]->layer == "UI" ? RenderQueue::UI : RenderQueue::World);
 				if (this->GetLevel()->GetGameObjectArray()[i]->layer != "UI")
 					continue;
 
 				if (Anim != nullptr && Anim->GetVisibility()) {
 					if (this->GetLevel()->GetGameObjectArray()[i]->layer == "UI") {
-						Batch::DrawSprite({ Batch::camera.GetCameraPosition().x + go->Position.x, Batch::camera.GetCameraPosition().y + go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texid,
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texcoords[this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).idx],
-							this->GetLevel()->GetAssets()->GetSprite(Anim->GetTexHandle()).texsize, { Anim->RGB_0to1.x, Anim->RGB_0to1.y, Anim->RGB_0to1.z, Anim->Alpha_0to1 }, go->RotationAngle);
+						DrawAnimation({ Batch::camera.GetCameraPosition().x + go->Position.x, Batch::camera.GetCameraPosition().y + go->Position.y, go->Depth }, go, Anim, this->GetLevel()->GetAssets());
 					}
 				}
 				else if (RDR != nullptr && RDR->GetVisibility()) // if active 
@@ -624,9 +850,10 @@ void Graphics::AdditionalUpdate(float dt) {
 								{ RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, go->RotationAngle);
 
 						else {
+							Assets::Sprite tex = this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle());
 							Batch::DrawQuadWithPixelCoords({ Batch::camera.GetCameraPosition().x + go->Position.x,Batch::camera.GetCameraPosition().y + go->Position.y, go->Depth }, { go->Dimensions.x, go->Dimensions.y }, { go->Scale.x, go->Scale.y },
-								this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle()).texid, { RDR->GetUVMin().x,  RDR->GetUVMin().y }, { RDR->GetUVMax().x,  RDR->GetUVMax().y },
-								this->GetLevel()->GetAssets()->GetTexture(RDR->GetTexHandle()).texsize, { RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 });
+								tex.texid, { RDR->GetUVMin().x,  RDR->GetUVMin().y }, { RDR->GetUVMax().x,  RDR->GetUVMax().y },
+								tex.texsize, { RDR->RGB_0to1.x, RDR->RGB_0to1.y, RDR->RGB_0to1.z, RDR->Alpha_0to1 }, 0.f, tex.uvmin, tex.uvmax);
 						}
 					}
 				}
@@ -641,8 +868,6 @@ void Graphics::AdditionalUpdate(float dt) {
 		}
 		if (pointlights.size() > 0)
 			Batch::SetLight(pointlights);
-		Batch::EndBatch();
-		Batch::Flush();
 
 		// THIS SPACE RESERVED FOR FONT 
 		for (int i = 0; i < this->GetLevel()->GetGameUILayer().size(); ++i)
@@ -667,14 +892,23 @@ void Graphics::AdditionalUpdate(float dt) {
 			FontsRender::RenderDEBUG_Performance_Data(this->GetLevel()->GetAssets()->GetFont("Roboto"), 0.025f * WindowHeight, 0.1f * WindowWidth, 0.75f * WindowHeight, 0.5f, glm::vec3(0.0f, 0.0f, 0.0f));
 
 		} // DEBUG
+
+		// Text is batched with the UI, so the batch is drawn after it is queued
+		Batch::EndBatch();
+		RenderThread::Submit([] { RenderStats::Begin(RenderStats::Text); });
+		Batch::Flush();
+		RenderThread::Submit([] { RenderStats::End(RenderStats::Text); });
 	}
 	
 
 	if (editor_open)
 	{
 		//#ifdef RENDER_TO_IMGUI_GAMEWINDOW
-		mFrameBuffer->UnbindFrameBuffer();
-		GW::Statics::texID = mFrameBuffer->GetTextureID();
+		RenderThread::Submit([this] {
+			RenderStats::End(RenderStats::EditorFBO);
+			mFrameBuffer->UnbindFrameBuffer();
+			GW::Statics::texID = mFrameBuffer->GetTextureID();
+		});
 		//#endif
 	}
 }
@@ -686,9 +920,15 @@ void Graphics::AdditionalUpdate(float dt) {
 	*/
 	/**************************************************************************/
 void Graphics::Shutdown() {
+	RenderThread::Stop();
+	RenderStats::Shutdown();
+	FlipbookStream::Shutdown();
+	TextureLoader::Shutdown();
+	// GL objects go before the context does
+	DebugDraw::Cleanup();
+	Batch::Cleanup();
 	GLSetup::cleanup();
 	//Render::Object::cleanup();
-	Batch::Cleanup();
 }
 
 /**************************************************************************/
@@ -738,5 +978,5 @@ GLint Graphics::GetWindowHeight()
 
 void Graphics::SetVSync(const bool bool_param)
 {
-	glfwSwapInterval(bool_param ? 1 : 0);
+	RenderThread::Submit([bool_param] { glfwSwapInterval(bool_param ? 1 : 0); });
 }
\ No newline at end of file
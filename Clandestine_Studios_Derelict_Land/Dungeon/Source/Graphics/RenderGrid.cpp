@@ -0,0 +1,117 @@
+/******************************************************************************/
+/*!
+\file    RenderGrid.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Loose uniform grid of render bounds used to cull objects against the
+		 camera. Each object lives in the one cell holding its center, and
+		 queries grow by the largest half size seen so nothing is missed.
+		 Objects bigger than a cell are kept in a list tested on their own.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/RenderGrid.h>
+#include <cmath>
+
+/**************************************************************************/
+/*!
+  \brief
+	Creates an empty grid.
+*/
+/**************************************************************************/
+RenderGrid::RenderGrid(float cell_size) : cell_size{ cell_size } {}
+
+/**************************************************************************/
+/*!
+  \brief
+	Removes every object. Cell vectors are emptied, not freed, since the same
+	cells are usually filled again next frame.
+*/
+/**************************************************************************/
+void RenderGrid::Clear() {
+	for (auto& cell : cells)
+		cell.second.clear();
+	items.clear();
+	large.clear();
+	max_half = { 0.f, 0.f };
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Adds the render bounds of an object to the cell holding its center, or
+	to the large list if it is bigger than a cell.
+*/
+/**************************************************************************/
+void RenderGrid::Insert(size_t index, const glm::vec2& center, const glm::vec2& half_size) {
+	uint32_t id = (uint32_t)items.size();
+	items.push_back({ index, center - half_size, center + half_size });
+
+	if (half_size.x > cell_size || half_size.y > cell_size) {
+		large.push_back(id);
+		return;
+	}
+
+	max_half.x = half_size.x > max_half.x ? half_size.x : max_half.x;
+	max_half.y = half_size.y > max_half.y ? half_size.y : max_half.y;
+	int x = (int)std::floor(center.x / cell_size);
+	int y = (int)std::floor(center.y / cell_size);
+	cells[CellKey(x, y)].push_back(id);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Finds every object whose bounds overlap a rectangle. Cells are visited
+	over the rectangle grown by the largest half size, then each candidate's
+	own bounds are tested.
+*/
+/**************************************************************************/
+void RenderGrid::Query(const glm::vec2& min, const glm::vec2& max, std::vector<size_t>& out) const {
+	for (uint32_t id : large) {
+		if (Overlaps(items[id], min, max))
+			out.push_back(items[id].index);
+	}
+
+	int x0 = (int)std::floor((min.x - max_half.x) / cell_size);
+	int y0 = (int)std::floor((min.y - max_half.y) / cell_size);
+	int x1 = (int)std::floor((max.x + max_half.x) / cell_size);
+	int y1 = (int)std::floor((max.y + max_half.y) / cell_size);
+
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			auto cell = cells.find(CellKey(x, y));
+			if (cell == cells.end())
+				continue;
+
+			for (uint32_t id : cell->second) {
+				if (Overlaps(items[id], min, max))
+					out.push_back(items[id].index);
+			}
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Packs a cell coordinate into a map key.
+*/
+/**************************************************************************/
+uint64_t RenderGrid::CellKey(int x, int y) const {
+	return ((uint64_t)(uint32_t)x << 32) | (uint64_t)(uint32_t)y;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Checks if an item's bounds overlap a rectangle.
+*/
+/**************************************************************************/
+bool RenderGrid::Overlaps(const Item& item, const glm::vec2& min, const glm::vec2& max) {
+	return item.max.x >= min.x && item.min.x <= max.x && item.max.y >= min.y && item.min.y <= max.y;
+}
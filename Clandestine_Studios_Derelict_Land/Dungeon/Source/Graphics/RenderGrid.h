@@ -0,0 +1,95 @@
+/******************************************************************************/
+/*!
+\file    RenderGrid.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Loose uniform grid of render bounds used to cull objects against the
+		 camera. Each object lives in the one cell holding its center, and
+		 queries grow by the largest half size seen so nothing is missed.
+		 Objects bigger than a cell are kept in a list tested on their own.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef RENDERGRID_H
+#define RENDERGRID_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class RenderGrid {
+public:
+	/**************************************************************************/
+	/*!
+	  \brief
+		Creates an empty grid.
+
+	  \param cell_size
+		Width and height of a cell in world units.
+	*/
+	/**************************************************************************/
+	explicit RenderGrid(float cell_size = 512.f);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Removes every object, keeping the cells' memory.
+	*/
+	/**************************************************************************/
+	void Clear();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Adds the render bounds of an object.
+
+	  \param index
+		Index of the object, returned by Query.
+
+	  \param center
+		Center of the bounds.
+
+	  \param half_size
+		Half width and height of the bounds.
+	*/
+	/**************************************************************************/
+	void Insert(size_t index, const glm::vec2& center, const glm::vec2& half_size);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Finds every object whose bounds overlap a rectangle.
+
+	  \param min
+		Bottom left of the rectangle.
+
+	  \param max
+		Top right of the rectangle.
+
+	  \param out
+		Indices of the overlapping objects are appended here.
+	*/
+	/**************************************************************************/
+	void Query(const glm::vec2& min, const glm::vec2& max, std::vector<size_t>& out) const;
+
+private:
+	struct Item {
+		size_t index;
+		glm::vec2 min;
+		glm::vec2 max;
+	};
+
+	uint64_t CellKey(int x, int y) const;
+	static bool Overlaps(const Item& item, const glm::vec2& min, const glm::vec2& max);
+
+	float cell_size;
+	glm::vec2 max_half{ 0.f, 0.f };							// loose margin for queries
+	std::vector<Item> items;
+	std::vector<uint32_t> large;								// items bigger than a cell
+	std::unordered_map<uint64_t, std::vector<uint32_t>> cells;	// cell -> items
+};
+
+#endif
@@ -0,0 +1,158 @@
+/******************************************************************************/
+/*!
+\file    RenderQueue.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Queue of quads waiting to be batched. Every quad carries a 64-bit
+		 sort key (layer, translucency, depth, shader, texture) and is radix
+		 sorted once per batch, so opaque quads are grouped by texture and
+		 translucent quads are drawn back to front.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/RenderQueue.h>
+
+/**************************************************************************/
+/*!
+  \brief
+	Maps a depth of -1 to 1 onto an unsigned integer of the given width.
+
+  \param depth
+	Depth to map.
+
+  \param bits
+	Width of the result.
+
+  \return
+	0 for the furthest depth, all ones for the nearest.
+*/
+/**************************************************************************/
+static uint64_t QuantizeDepth(float depth, int bits) {
+	float t = (depth + 1.f) * 0.5f;
+	t = t < 0.f ? 0.f : (t > 1.f ? 1.f : t);
+	return (uint64_t)(t * (float)((1u << bits) - 1u));
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Builds the sort key of a quad, see RenderQueue.h for the layout.
+*/
+/**************************************************************************/
+uint64_t RenderQueue::MakeKey(uint8_t layer, float depth, bool translucent, uint8_t shader, GLuint texid) {
+	uint64_t key = (uint64_t)layer << 56;
+
+	if (translucent) {
+		key |= 1ull << 55;
+		key |= QuantizeDepth(depth, 24) << 31;
+		key |= (uint64_t)shader << 23;
+		key |= (uint64_t)(texid & 0x7FFFFFu);
+	}
+	else {
+		const uint64_t depth_mask = (1ull << 23) - 1;
+		key |= (uint64_t)shader << 47;
+		key |= (uint64_t)(texid & 0xFFFFFFu) << 23;
+		key |= depth_mask - QuantizeDepth(depth, 23);
+	}
+	return key;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Whether a sort key was made for a quad that needs blending.
+*/
+/**************************************************************************/
+bool RenderQueue::IsTranslucent(uint64_t key) {
+	return (key >> 55) & 1ull;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Adds a quad to the queue.
+*/
+/**************************************************************************/
+void RenderQueue::Submit(uint64_t key, const Quad& quad) {
+	entries.push_back({ key, (uint32_t)payloads.size() });
+	payloads.push_back(quad);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Stable LSD radix sort of the keys, 8 bits per pass.
+*/
+/**************************************************************************/
+void RenderQueue::Sort() {
+	size_t count = entries.size();
+	if (count < 2)
+		return;
+
+	scratch.resize(count);
+	for (int shift = 0; shift < 64; shift += 8) {
+		size_t histogram[256]{};
+		for (const Entry& e : entries)
+			++histogram[(e.key >> shift) & 0xFF];
+
+		// Every key has the same byte here, the order would not change
+		if (histogram[(entries[0].key >> shift) & 0xFF] == count)
+			continue;
+
+		size_t offset = 0;
+		for (size_t& bucket : histogram) {
+			size_t n = bucket;
+			bucket = offset;
+			offset += n;
+		}
+
+		for (const Entry& e : entries)
+			scratch[histogram[(e.key >> shift) & 0xFF]++] = e;
+		entries.swap(scratch);
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Empties the queue, keeping its memory for the next batch.
+*/
+/**************************************************************************/
+void RenderQueue::Clear() {
+	entries.clear();
+	payloads.clear();
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Number of quads in the queue.
+*/
+/**************************************************************************/
+size_t RenderQueue::Size() const {
+	return entries.size();
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Gets a quad in sorted order.
+*/
+/**************************************************************************/
+const RenderQueue::Quad& RenderQueue::operator[](size_t i) const {
+	return payloads[entries[i].index];
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Gets the sort key of a quad in sorted order.
+*/
+/**************************************************************************/
+uint64_t RenderQueue::GetKey(size_t i) const {
+	return entries[i].key;
+}
@@ -0,0 +1,173 @@
+/******************************************************************************/
+/*!
+\file    RenderQueue.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Queue of quads waiting to be batched. Every quad carries a 64-bit
+		 sort key (layer, translucency, depth, shader, texture) and is radix
+		 sorted once per batch, so opaque quads are grouped by texture and
+		 translucent quads are drawn back to front.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <glm/glm.hpp>
+#include <GL/glew.h>
+#include <cstdint>
+#include <vector>
+
+class RenderQueue {
+public:
+	// Render layers, drawn in this order
+	enum Layer : uint8_t {
+		World = 0,		// Scene objects
+		UI = 1,			// Screen space objects
+		Overlay = 2		// Editor gizmos
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Everything Batch needs to draw one quad.
+	*/
+	/**************************************************************************/
+	struct Quad {
+		glm::vec3 pos;
+		glm::vec2 size;			// scale already applied
+		float angle;
+		glm::vec2 uv_start;
+		glm::vec2 uv_end;
+		glm::vec4 clr;
+		GLuint texid;			// 0 for untextured quads
+		float edge;				// SDF edge of unlit text, 0 for other quads
+		glm::vec4 anim{};		// flipbook start, frame duration, frames, frames per row. Fewer than 2 frames is a still quad
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Builds the sort key of a quad.
+
+		Opaque:      layer(8) | 0 | shader(8) | texture(24) | depth(23, front to back)
+		Translucent: layer(8) | 1 | depth(24, back to front) | shader(8) | texture(23)
+
+		Opaque quads only need the depth buffer to come out right, so they are
+		grouped by texture. Translucent quads must blend in depth order, and
+		quads on the same depth are still grouped by texture.
+
+	  \param layer
+		Render layer of the quad.
+
+	  \param depth
+		Depth of the quad, -1 to 1 with bigger values in front.
+
+	  \param translucent
+		Whether the quad needs blending.
+
+	  \param shader
+		Shader used to draw the quad.
+
+	  \param texid
+		Texture of the quad.
+
+	  \return
+		Sort key, smaller keys are drawn first.
+	*/
+	/**************************************************************************/
+	static uint64_t MakeKey(uint8_t layer, float depth, bool translucent, uint8_t shader, GLuint texid);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Whether a sort key was made for a quad that needs blending.
+
+	  \param key
+		Sort key from MakeKey.
+
+	  \return
+		True if the quad is drawn back to front.
+	*/
+	/**************************************************************************/
+	static bool IsTranslucent(uint64_t key);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Adds a quad to the queue.
+
+	  \param key
+		Sort key from MakeKey.
+
+	  \param quad
+		Quad to draw.
+	*/
+	/**************************************************************************/
+	void Submit(uint64_t key, const Quad& quad);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Sorts the queue by key with an LSD radix sort, 8 bits per pass. Passes
+		where every key has the same byte are skipped. The sort is stable, so
+		quads with equal keys keep their submission order.
+	*/
+	/**************************************************************************/
+	void Sort();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Empties the queue, keeping its memory for the next batch.
+	*/
+	/**************************************************************************/
+	void Clear();
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Number of quads in the queue.
+	*/
+	/**************************************************************************/
+	size_t Size() const;
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets a quad in sorted order.
+
+	  \param i
+		Position in the sorted queue.
+
+	  \return
+		Quad at that position.
+	*/
+	/**************************************************************************/
+	const Quad& operator[](size_t i) const;
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the sort key of a quad in sorted order.
+
+	  \param i
+		Position in the sorted queue.
+
+	  \return
+		Sort key the quad was submitted with.
+	*/
+	/**************************************************************************/
+	uint64_t GetKey(size_t i) const;
+
+private:
+	struct Entry {
+		uint64_t key;
+		uint32_t index;		// into payloads
+	};
+
+	std::vector<Entry> entries;
+	std::vector<Entry> scratch;
+	std::vector<Quad> payloads;
+};
+
+#endif
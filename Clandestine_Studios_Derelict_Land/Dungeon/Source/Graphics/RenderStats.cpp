@@ -0,0 +1,270 @@
+/******************************************************************************/
+/*!
+\file    RenderStats.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   GPU timings and batch counters of each frame. Passes are timed with
+		 pairs of GL_TIMESTAMP queries, which are read back a few frames
+		 later so the CPU never waits on the GPU. Frames read back are kept
+		 in a short history and can be written out as CSV.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/RenderStats.h>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+
+static const size_t QueryFrames = 4;	// frames in flight before a read back
+static const size_t HistorySize = 300;
+
+static const char* PassNames[RenderStats::PassCount] = { "World", "Lights", "Text", "EditorFBO", "ImGui" };
+static const char* FlushNames[Batch::FlushReasonCount] = { "QuadsFull", "TexturesFull", "LinesFull", "EndOfPass" };
+
+// Queries of one frame. Begin/End take queries in order, so the same
+// queries are reused every QueryFrames frames.
+struct QueryFrame
+{
+	struct Interval {
+		RenderStats::Pass Pass;
+		size_t Begin;
+		size_t End;			// SIZE_MAX while the pass is open
+	};
+
+	std::vector<GLuint> Queries;
+	size_t Used = 0;
+	std::vector<Interval> Intervals;
+	RenderStats::Frame Stats;
+	bool Pending = false;		// ended, not read back yet
+};
+
+struct StatsData
+{
+	QueryFrame Frames[QueryFrames];
+	size_t Current = 0;
+	uint64_t Number = 0;
+
+	// Read on the simulation thread by the editor, so it is locked
+	std::mutex Mutex;
+	std::deque<RenderStats::Frame> History;
+	std::ofstream Capture;
+};
+
+static StatsData Stats_Data;
+
+/**************************************************************************/
+/*!
+  \brief
+	Writes the CSV column names.
+*/
+/**************************************************************************/
+void Write_Header(std::ostream& out) {
+	out << "Frame,FrameMs";
+	for (const char* name : PassNames)
+		out << "," << name << "Ms";
+	out << ",DrawCalls,Quads,TextureBinds,BytesUploaded";
+	for (const char* name : FlushNames)
+		out << ",Flush" << name;
+	out << "\n";
+}
+/**************************************************************************/
+/*!
+  \brief
+	Writes one frame as a CSV row.
+*/
+/**************************************************************************/
+void Write_Row(std::ostream& out, const RenderStats::Frame& frame) {
+	out << frame.Number << "," << frame.FrameMs;
+	for (float ms : frame.GpuMs)
+		out << "," << ms;
+	out << "," << frame.Counters.DrawCalls << "," << frame.Counters.Quads << "," << frame.Counters.TextureBinds << "," << frame.Counters.BytesUploaded;
+	for (uint32_t flushes : frame.Counters.Flushes)
+		out << "," << flushes;
+	out << "\n";
+}
+/**************************************************************************/
+/*!
+  \brief
+	Takes the next query of a frame, making one if they are all in use.
+*/
+/**************************************************************************/
+size_t Next_Query(QueryFrame& frame) {
+	if (frame.Used == frame.Queries.size()) {
+		GLuint query = 0;
+		glGenQueries(1, &query);
+		frame.Queries.push_back(query);
+	}
+	return frame.Used++;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Reads back the timestamps of a frame and adds it to the history. The
+	frame is QueryFrames - 1 frames old, so the results are normally there
+	and this does not wait.
+*/
+/**************************************************************************/
+void Read_Frame(QueryFrame& frame) {
+	for (const QueryFrame::Interval& interval : frame.Intervals) {
+		if (interval.End == SIZE_MAX)
+			continue;
+
+		GLuint64 begin = 0, end = 0;
+		glGetQueryObjectui64v(frame.Queries[interval.Begin], GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(frame.Queries[interval.End], GL_QUERY_RESULT, &end);
+		frame.Stats.GpuMs[interval.Pass] += (float)((double)(end - begin) / 1000000.0);
+	}
+
+	std::lock_guard<std::mutex> lock(Stats_Data.Mutex);
+	Stats_Data.History.push_back(frame.Stats);
+	if (Stats_Data.History.size() > HistorySize)
+		Stats_Data.History.pop_front();
+	if (Stats_Data.Capture.is_open())
+		Write_Row(Stats_Data.Capture, frame.Stats);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Deletes the queries and closes the capture file.
+*/
+/**************************************************************************/
+void RenderStats::Shutdown() {
+	for (QueryFrame& frame : Stats_Data.Frames) {
+		if (!frame.Queries.empty())
+			glDeleteQueries((GLsizei)frame.Queries.size(), frame.Queries.data());
+		frame = QueryFrame{};
+	}
+	StopCapture();
+}
+/**************************************************************************/
+/*!
+  \brief
+	Writes a timestamp where a pass starts.
+*/
+/**************************************************************************/
+void RenderStats::Begin(Pass pass) {
+	QueryFrame& frame = Stats_Data.Frames[Stats_Data.Current];
+	size_t query = Next_Query(frame);
+	glQueryCounter(frame.Queries[query], GL_TIMESTAMP);
+	frame.Intervals.push_back({ pass, query, SIZE_MAX });
+}
+/**************************************************************************/
+/*!
+  \brief
+	Writes a timestamp where a pass ends, closing its last Begin.
+*/
+/**************************************************************************/
+void RenderStats::End(Pass pass) {
+	QueryFrame& frame = Stats_Data.Frames[Stats_Data.Current];
+	for (auto it = frame.Intervals.rbegin(); it != frame.Intervals.rend(); ++it) {
+		if (it->Pass != pass || it->End != SIZE_MAX)
+			continue;
+
+		it->End = Next_Query(frame);
+		glQueryCounter(frame.Queries[it->End], GL_TIMESTAMP);
+		return;
+	}
+}
+/**************************************************************************/
+/*!
+  \brief
+	Closes the frame and moves on to the oldest set of queries, reading them
+	back first if they were used.
+*/
+/**************************************************************************/
+void RenderStats::EndFrame(float frame_ms) {
+	QueryFrame& ended = Stats_Data.Frames[Stats_Data.Current];
+	ended.Stats.Number = Stats_Data.Number++;
+	ended.Stats.FrameMs = frame_ms;
+	ended.Stats.Counters = Batch::TakeStats();
+	ended.Pending = true;
+
+	Stats_Data.Current = (Stats_Data.Current + 1) % QueryFrames;
+	QueryFrame& next = Stats_Data.Frames[Stats_Data.Current];
+	if (next.Pending)
+		Read_Frame(next);
+
+	next.Used = 0;
+	next.Intervals.clear();
+	next.Stats = Frame{};
+	next.Pending = false;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gets a copy of the frames read back so far, oldest first.
+*/
+/**************************************************************************/
+std::vector<RenderStats::Frame> RenderStats::GetHistory() {
+	std::lock_guard<std::mutex> lock(Stats_Data.Mutex);
+	return std::vector<Frame>(Stats_Data.History.begin(), Stats_Data.History.end());
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gets the name of a pass.
+*/
+/**************************************************************************/
+const char* RenderStats::GetPassName(uint8_t pass) {
+	return pass < PassCount ? PassNames[pass] : "";
+}
+/**************************************************************************/
+/*!
+  \brief
+	Writes the history to a CSV file.
+*/
+/**************************************************************************/
+bool RenderStats::ExportHistory(const std::string& path) {
+	std::ofstream file(path);
+	if (!file.is_open())
+		return false;
+
+	Write_Header(file);
+	for (const Frame& frame : GetHistory())
+		Write_Row(file, frame);
+	return true;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Opens a CSV file that every frame read back is written to.
+*/
+/**************************************************************************/
+bool RenderStats::StartCapture(const std::string& path) {
+	std::lock_guard<std::mutex> lock(Stats_Data.Mutex);
+	if (Stats_Data.Capture.is_open())
+		Stats_Data.Capture.close();
+
+	Stats_Data.Capture.open(path);
+	if (!Stats_Data.Capture.is_open())
+		return false;
+	Write_Header(Stats_Data.Capture);
+	return true;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Closes the capture file.
+*/
+/**************************************************************************/
+void RenderStats::StopCapture() {
+	std::lock_guard<std::mutex> lock(Stats_Data.Mutex);
+	if (Stats_Data.Capture.is_open())
+		Stats_Data.Capture.close();
+}
+/**************************************************************************/
+/*!
+  \brief
+	Whether frames are being written to a capture file.
+*/
+/**************************************************************************/
+bool RenderStats::IsCapturing() {
+	std::lock_guard<std::mutex> lock(Stats_Data.Mutex);
+	return Stats_Data.Capture.is_open();
+}
@@ -0,0 +1,151 @@
+/******************************************************************************/
+/*!
+\file    RenderStats.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   GPU timings and batch counters of each frame. Passes are timed with
+		 pairs of GL_TIMESTAMP queries, which are read back a few frames
+		 later so the CPU never waits on the GPU. Frames read back are kept
+		 in a short history and can be written out as CSV.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <Graphics/BatchRendering.h>
+#include <string>
+#include <vector>
+
+class RenderStats {
+public:
+	// Timed passes. They may nest, an inner pass is also counted in the outer one.
+	enum Pass : uint8_t {
+		World = 0,		// scene batch, and everything else while the editor is open
+		Lights,			// light culling upload
+		Text,			// UI and text batch in game
+		EditorFBO,		// everything drawn into the editor's game window
+		EditorUI,		// ImGui editor windows
+		PassCount
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Everything measured in one frame.
+	*/
+	/**************************************************************************/
+	struct Frame {
+		uint64_t Number = 0;
+		float FrameMs = 0.f;			// CPU frame time
+		float GpuMs[PassCount]{};		// 0 for passes not drawn
+		Batch::Stats Counters;			// batch renderer work
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Deletes the queries and closes the capture file. Call with the OpenGL
+		context current.
+	*/
+	/**************************************************************************/
+	static void Shutdown();
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Writes a timestamp where a pass starts. Call with the OpenGL context
+		current, from the simulation thread wrap it in RenderThread::Submit.
+
+	  \param pass
+		Pass being timed.
+	*/
+	/**************************************************************************/
+	static void Begin(Pass pass);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Writes a timestamp where a pass ends. A pass timed more than once in a
+		frame is summed.
+
+	  \param pass
+		Pass being timed.
+	*/
+	/**************************************************************************/
+	static void End(Pass pass);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Closes the frame, taking the batch counters, and reads back the frame
+		whose queries are about to be reused. Call with the OpenGL context
+		current, once per frame.
+
+	  \param frame_ms
+		CPU time of the frame.
+	*/
+	/**************************************************************************/
+	static void EndFrame(float frame_ms);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the frames read back so far, oldest first.
+	*/
+	/**************************************************************************/
+	static std::vector<Frame> GetHistory();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the name of a pass, as used in the CSV header.
+	*/
+	/**************************************************************************/
+	static const char* GetPassName(uint8_t pass);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Writes the history to a CSV file, one row per frame.
+
+	  \param path
+		File to write.
+
+	  \return
+		Whether the file could be written.
+	*/
+	/**************************************************************************/
+	static bool ExportHistory(const std::string& path);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Starts writing every frame to a CSV file as it is read back, until
+		StopCapture.
+
+	  \param path
+		File to write.
+
+	  \return
+		Whether the file could be opened.
+	*/
+	/**************************************************************************/
+	static bool StartCapture(const std::string& path);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Stops writing frames and closes the capture file.
+	*/
+	/**************************************************************************/
+	static void StopCapture();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Whether frames are being written to a capture file.
+	*/
+	/**************************************************************************/
+	static bool IsCapturing();
+};
+
+#endif
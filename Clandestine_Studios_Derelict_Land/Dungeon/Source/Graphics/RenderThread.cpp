@@ -0,0 +1,167 @@
+/******************************************************************************/
+/*!
+\file    RenderThread.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Thread that owns the OpenGL context and runs the render commands
+		 recorded by the simulation thread. Commands are recorded into one
+		 of two lists; at the end of a frame the lists swap, so the GPU work
+		 of frame N is submitted while frame N+1 is simulated. When the
+		 thread is not running commands run immediately on the caller.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/RenderThread.h>
+#include <Graphics/GLFWsetup.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct RenderThreadData
+{
+	std::thread Thread;
+	std::mutex Mutex;
+	std::condition_variable FrameReady;		// a list was handed over, or Stop was called
+	std::condition_variable FrameDone;		// the handed over list has run
+
+	// Lists[Recording] is filled by Submit, the other one belongs to the render thread while Pending
+	std::vector<RenderThread::Command> Lists[2];
+	int Recording = 0;
+	bool Pending = false;
+	bool Running = false;
+	bool Stopping = false;
+};
+
+static RenderThreadData Render_Data;
+
+/**************************************************************************/
+/*!
+  \brief
+	Starts the render thread, moving the OpenGL context to it.
+*/
+/**************************************************************************/
+void RenderThread::Start() {
+	if (Render_Data.Running)
+		return;
+
+	glfwMakeContextCurrent(nullptr);
+	Render_Data.Stopping = false;
+	Render_Data.Pending = false;
+	Render_Data.Running = true;
+	Render_Data.Thread = std::thread(&RenderThread::Run);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Hands over what was recorded, waits for it, then stops the render
+	thread and takes the OpenGL context back.
+*/
+/**************************************************************************/
+void RenderThread::Stop() {
+	if (!Render_Data.Running)
+		return;
+
+	EndFrame();
+	Wait();
+	{
+		std::lock_guard<std::mutex> lock(Render_Data.Mutex);
+		Render_Data.Stopping = true;
+	}
+	Render_Data.FrameReady.notify_one();
+	Render_Data.Thread.join();
+
+	Render_Data.Running = false;
+	glfwMakeContextCurrent(GLSetup::ptr_window);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Whether commands are being handed to the render thread.
+*/
+/**************************************************************************/
+bool RenderThread::IsRunning() {
+	return Render_Data.Running;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Records a command, or runs it if there is no render thread.
+*/
+/**************************************************************************/
+void RenderThread::Submit(Command command) {
+	if (!Render_Data.Running) {
+		command();
+		return;
+	}
+	Render_Data.Lists[Render_Data.Recording].push_back(std::move(command));
+}
+/**************************************************************************/
+/*!
+  \brief
+	Swaps the command lists once the render thread is done with the last
+	frame, and wakes it up to run the one just recorded.
+*/
+/**************************************************************************/
+void RenderThread::EndFrame() {
+	if (!Render_Data.Running)
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(Render_Data.Mutex);
+		Render_Data.FrameDone.wait(lock, [] { return !Render_Data.Pending; });
+		Render_Data.Recording = 1 - Render_Data.Recording;
+		Render_Data.Pending = true;
+	}
+	Render_Data.FrameReady.notify_one();
+}
+/**************************************************************************/
+/*!
+  \brief
+	Waits for the render thread to finish the frame it was handed.
+*/
+/**************************************************************************/
+void RenderThread::Wait() {
+	if (!Render_Data.Running)
+		return;
+
+	std::unique_lock<std::mutex> lock(Render_Data.Mutex);
+	Render_Data.FrameDone.wait(lock, [] { return !Render_Data.Pending; });
+}
+/**************************************************************************/
+/*!
+  \brief
+	Render thread loop. Runs each list handed over by EndFrame in the order
+	it was recorded, then clears it for reuse two frames later.
+*/
+/**************************************************************************/
+void RenderThread::Run() {
+	glfwMakeContextCurrent(GLSetup::ptr_window);
+
+	for (;;) {
+		std::vector<Command>* list = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(Render_Data.Mutex);
+			Render_Data.FrameReady.wait(lock, [] { return Render_Data.Pending || Render_Data.Stopping; });
+			if (!Render_Data.Pending)
+				break;
+			list = &Render_Data.Lists[1 - Render_Data.Recording];
+		}
+
+		for (Command& command : *list)
+			command();
+		list->clear();
+
+		{
+			std::lock_guard<std::mutex> lock(Render_Data.Mutex);
+			Render_Data.Pending = false;
+		}
+		Render_Data.FrameDone.notify_all();
+	}
+
+	glfwMakeContextCurrent(nullptr);
+}
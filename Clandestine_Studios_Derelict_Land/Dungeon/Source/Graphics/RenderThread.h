@@ -0,0 +1,84 @@
+/******************************************************************************/
+/*!
+\file    RenderThread.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Thread that owns the OpenGL context and runs the render commands
+		 recorded by the simulation thread. Commands are recorded into one
+		 of two lists; at the end of a frame the lists swap, so the GPU work
+		 of frame N is submitted while frame N+1 is simulated. When the
+		 thread is not running commands run immediately on the caller.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+#include <functional>
+
+class RenderThread {
+public:
+	using Command = std::function<void()>;
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Releases the OpenGL context from the calling thread and starts the
+		render thread, which makes it current. Does nothing if running.
+	*/
+	/**************************************************************************/
+	static void Start();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Runs every recorded command, stops the render thread and makes the
+		OpenGL context current on the calling thread again.
+	*/
+	/**************************************************************************/
+	static void Stop();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Whether commands are being handed to the render thread.
+	*/
+	/**************************************************************************/
+	static bool IsRunning();
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Records a command for the current frame. It runs on the render thread
+		after EndFrame, or right away if the thread is not running. Anything
+		it reads must not change until it has run.
+
+	  \param command
+		Command to run with the OpenGL context current.
+	*/
+	/**************************************************************************/
+	static void Submit(Command command);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Hands the commands recorded this frame to the render thread. Waits
+		for the previous frame first, so the render thread is never more than
+		one frame behind.
+	*/
+	/**************************************************************************/
+	static void EndFrame();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Waits until the render thread has run every frame handed to it.
+	*/
+	/**************************************************************************/
+	static void Wait();
+
+private:
+	static void Run();
+};
+
+#endif
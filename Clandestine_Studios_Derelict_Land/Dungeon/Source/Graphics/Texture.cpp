@@ -16,6 +16,33 @@
  /******************************************************************************/
 #define STB_IMAGE_IMPLEMENTATION
 #include "../3rdParty/stb_image.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+static const char* CookedDir = "./Images/Cooked";
+static const uint32_t DDSMagic = 0x20534444;		// "DDS "
+static const uint32_t FourCC_DXT1 = 0x31545844;		// "DXT1"
+static const uint32_t FourCC_DXT5 = 0x35545844;		// "DXT5"
+static const uint32_t DDSHeaderWords = 32;			// magic and the 124 byte header
+
+/**************************************************************************/
+/*!
+  \brief
+	Reads a .dds header and checks it holds DXT1 or DXT5 blocks.
+*/
+/**************************************************************************/
+static bool Read_DDS_Header(std::ifstream& file, uint32_t (&header)[DDSHeaderWords], GLenum& format) {
+	if (!file.read(reinterpret_cast<char*>(header), sizeof(header)))
+		return false;
+	// header[20] pixel format flags (DDPF_FOURCC), header[21] FourCC
+	if (header[0] != DDSMagic || header[1] != 124 || !(header[20] & 0x4))
+		return false;
+	if (header[21] == FourCC_DXT1) format = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	else if (header[21] == FourCC_DXT5) format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	else return false;
+	return header[3] > 0 && header[4] > 0;
+}
 
 void Texture::Init() {
 	stbi_set_flip_vertically_on_load(1);
@@ -30,6 +57,18 @@ void Texture::Init() {
 */
 /**************************************************************************/
 GLuint Texture::STBI_Load_Texture(char const* pathname, bool isRepeated) {
+	int width, height;
+	return STBI_Load_Texture_With_Size(pathname, width, height, isRepeated);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Loads a .png/.jpeg file and returns a GPU binded texure id. The cooked
+	.dds is uploaded instead when there is an up to date one.
+*/
+/**************************************************************************/
+GLuint Texture::STBI_Load_Texture_With_Size(char const* pathname, int& width, int& height, bool isRepeated) {
 	GLuint texture = 0;
 	glGenTextures(1, &texture);
 	glBindTexture(GL_TEXTURE_2D, texture);
@@ -45,8 +84,19 @@ GLuint Texture::STBI_Load_Texture(char const* pathname, bool isRepeated) {
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// cooked textures already hold their mips, compressed as the GPU stores them
+	std::string cooked = Find_Cooked(pathname);
+	Cooked image;
+	if (!cooked.empty() && Read_Cooked(cooked.c_str(), image)) {
+		width = image.Width;
+		height = image.Height;
+		Upload_Cooked(image);
+		return texture;
+	}
+
 	// load and generate the texture
-	int width, height, Channels;
+	int Channels;
 	unsigned char* data = stbi_load(pathname, &width, &height, &Channels, 0);
 	if (data)
 	{
@@ -60,47 +110,127 @@ GLuint Texture::STBI_Load_Texture(char const* pathname, bool isRepeated) {
 	}
 	else
 	{
-		std::cout << "Failed to load texture from "<<pathname << std::endl;
+		std::cout << "Failed to load texture from " << pathname << std::endl;
 	}
 	stbi_image_free(data);
 	return texture;
 }
 
-GLuint Texture::STBI_Load_Texture_With_Size(char const* pathname, int& width, int& height, bool isRepeated) {
-	
+/**************************************************************************/
+/*!
+  \brief
+	Where the cooked .dds of an image is written.
+*/
+/**************************************************************************/
+std::string Texture::Cooked_Path(char const* pathname) {
+	std::filesystem::path source = std::filesystem::path(pathname).lexically_normal();
+	std::filesystem::path relative = source.lexically_relative("Images");
+	if (relative.empty() || *relative.begin() == "..")
+		relative = source.relative_path();
+	relative.replace_extension(".dds");
+	return (std::filesystem::path(CookedDir) / relative).generic_string();
+}
 
-	GLuint texture = 0;
-	glGenTextures(1, &texture);
-	glBindTexture(GL_TEXTURE_2D, texture);
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	if (isRepeated) {
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	}
-	else {
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	}
+/**************************************************************************/
+/*!
+  \brief
+	Finds the cooked .dds of an image, empty if missing or stale.
+*/
+/**************************************************************************/
+std::string Texture::Find_Cooked(char const* pathname) {
+	std::string cooked = Cooked_Path(pathname);
+	std::error_code ec;
+	auto cooked_time = std::filesystem::last_write_time(cooked, ec);
+	if (ec)
+		return {};
+	auto source_time = std::filesystem::last_write_time(pathname, ec);
+	if (!ec && source_time > cooked_time)
+		return {};
+	return cooked;
+}
 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	// load and generate the texture
-	int Channels;
-	unsigned char* data = stbi_load(pathname, &width, &height, &Channels, 0);
-	if (data)
-	{
-		if (Channels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+/**************************************************************************/
+/*!
+  \brief
+	Reads the size of a cooked image from its header only.
+*/
+/**************************************************************************/
+bool Texture::Read_Cooked_Size(char const* cookedname, int& width, int& height) {
+	std::ifstream file(cookedname, std::ios::binary);
+	uint32_t header[DDSHeaderWords]{};
+	GLenum format{};
+	if (!Read_DDS_Header(file, header, format))
+		return false;
+	height = static_cast<int>(header[3]);
+	width = static_cast<int>(header[4]);
+	return true;
+}
 
-		else if (Channels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+/**************************************************************************/
+/*!
+  \brief
+	Reads a cooked image and all its mip levels, less the skipped ones.
+*/
+/**************************************************************************/
+bool Texture::Read_Cooked(char const* cookedname, Cooked& image, int skipLevels) {
+	std::ifstream file(cookedname, std::ios::binary);
+	uint32_t header[DDSHeaderWords]{};
+	if (!Read_DDS_Header(file, header, image.Format))
+		return false;
+	image.Height = static_cast<int>(header[3]);
+	image.Width = static_cast<int>(header[4]);
 
-		glGenerateMipmap(GL_TEXTURE_2D);
+	// 4x4 blocks, 8 bytes each for DXT1 and 16 for DXT5
+	size_t block_bytes = image.Format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? 8 : 16;
+	uint32_t levels = (header[2] & 0x20000) && header[7] > 0 ? header[7] : 1;
+	uint32_t skipped = skipLevels > 0 ? static_cast<uint32_t>(skipLevels) : 0;
+	skipped = skipped < levels ? skipped : levels - 1;
+	image.LevelOffsets.clear();
+	image.LevelSizes.clear();
+	size_t total = 0, skipped_bytes = 0;
+	int w = image.Width, h = image.Height;
+	for (uint32_t level = 0; level < levels; ++level) {
+		if (level == skipped) {
+			image.Width = w;
+			image.Height = h;
+		}
+		size_t size = static_cast<size_t>((w + 3) / 4) * ((h + 3) / 4) * block_bytes;
+		if (level < skipped) {
+			skipped_bytes += size;
+		}
+		else {
+			image.LevelOffsets.push_back(total);
+			image.LevelSizes.push_back(size);
+			total += size;
+		}
+		w = w > 1 ? w / 2 : 1;
+		h = h > 1 ? h / 2 : 1;
 	}
-	else
-	{
-		std::cout << "Failed to load texture from " << pathname << std::endl;
+
+	file.seekg(static_cast<std::streamoff>(skipped_bytes), std::ios::cur);
+	image.Data.resize(total);
+	if (!file.read(reinterpret_cast<char*>(image.Data.data()), static_cast<std::streamsize>(total))) {
+		std::cout << "Cooked texture " << cookedname << " is cut short" << std::endl;
+		image.Data.clear();
+		return false;
 	}
-	stbi_image_free(data);
-	return texture;
-}
\ No newline at end of file
+	return true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Uploads every level of a cooked image into the bound texture.
+*/
+/**************************************************************************/
+void Texture::Upload_Cooked(const Cooked& image, bool fromUnpackBuffer) {
+	const GLint levels = static_cast<GLint>(image.LevelSizes.size());
+	int w = image.Width, h = image.Height;
+	for (GLint level = 0; level < levels; ++level) {
+		const void* data = fromUnpackBuffer ? reinterpret_cast<const void*>(image.LevelOffsets[level]) : image.Data.data() + image.LevelOffsets[level];
+		glCompressedTexImage2D(GL_TEXTURE_2D, level, image.Format, w, h, 0, static_cast<GLsizei>(image.LevelSizes[level]), data);
+		w = w > 1 ? w / 2 : 1;
+		h = h > 1 ? h / 2 : 1;
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+}
@@ -15,9 +15,27 @@
 
 #include <glm/glm.hpp>
 #include <GL/glew.h>
+#include <string>
+#include <vector>
 
 class Texture {
 public:
+	/**************************************************************************/
+	/*!
+	  \brief
+		Block compressed image read from a cooked .dds file, every mip level
+		stored one after another, largest first.
+	*/
+	/**************************************************************************/
+	struct Cooked {
+		GLenum Format = 0;					// GL_COMPRESSED_RGB_S3TC_DXT1_EXT or GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+		int Width = 0;
+		int Height = 0;
+		std::vector<unsigned char> Data;
+		std::vector<size_t> LevelOffsets;	// into Data
+		std::vector<size_t> LevelSizes;
+	};
+
 	static void Init();
 	/**************************************************************************/
 	/*!
@@ -51,4 +69,84 @@ public:
 	*/
 	/**************************************************************************/
 	static GLuint STBI_Load_Texture_With_Size(char const* pathname, int& width, int& height, bool isRepeated = false);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Where the cooked .dds of an image is written, under ./Images/Cooked
+		with the folders below ./Images kept.
+
+	  \param pathname
+		Filename of .png/.jpeg file.
+	*/
+	/**************************************************************************/
+	static std::string Cooked_Path(char const* pathname);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Finds the cooked .dds of an image.
+
+	  \param pathname
+		Filename of .png/.jpeg file.
+
+	  \return
+		Path of the .dds, empty if it was not cooked or is older than the
+		image, in which case the image itself should be loaded.
+	*/
+	/**************************************************************************/
+	static std::string Find_Cooked(char const* pathname);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Reads the size of a cooked image from its header only.
+
+	  \param cookedname
+		Filename of .dds file.
+
+	  \param width
+		return width by reference.
+
+	  \param height
+		return height by reference.
+
+	  \return
+		False if the file is not a DXT1/DXT5 .dds.
+	*/
+	/**************************************************************************/
+	static bool Read_Cooked_Size(char const* cookedname, int& width, int& height);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Reads a cooked image and all its mip levels.
+
+	  \param cookedname
+		Filename of .dds file.
+
+	  \param image
+		Image to fill in.
+
+	  \param skipLevels
+		Top mip levels to leave out, each halving the size. They are seeked
+		over rather than read. The smallest level is always kept.
+
+	  \return
+		False if the file is not a DXT1/DXT5 .dds or is cut short.
+	*/
+	/**************************************************************************/
+	static bool Read_Cooked(char const* cookedname, Cooked& image, int skipLevels = 0);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Uploads every level of a cooked image into the bound texture with
+		glCompressedTexImage2D, no mips are generated.
+
+	  \param image
+		Image to upload.
+
+	  \param fromUnpackBuffer
+		Whether Data was copied into the bound pixel unpack buffer, the level
+		offsets are then passed instead of pointers.
+	*/
+	/**************************************************************************/
+	static void Upload_Cooked(const Cooked& image, bool fromUnpackBuffer = false);
 };
\ No newline at end of file
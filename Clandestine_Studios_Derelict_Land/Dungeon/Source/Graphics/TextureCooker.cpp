@@ -0,0 +1,439 @@
+/******************************************************************************/
+/*!
+\file    TextureCooker.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Offline texture cooker. Every image under ./Images is block
+		 compressed (DXT1 when opaque, DXT5 with alpha) with its whole mip
+		 chain into a .dds under ./Images/Cooked, which Texture and
+		 TextureLoader upload as is. The memory and load time saved are
+		 reported for each image. Run the game with --cook-textures, after
+		 --cook-atlases so the atlas pages are cooked too.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/TextureCooker.h>
+#include <CoreSys/CommandLine.h>
+#include <Graphics/Texture.h>
+#include "../3rdParty/stb_image.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+	typedef unsigned char Block[16][4];
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Converts between 8 bit and 5:6:5 colours, the endpoint format of DXT
+		colour blocks.
+	*/
+	/**************************************************************************/
+	uint16_t To565(const int (&rgb)[3]) {
+		return static_cast<uint16_t>(((rgb[0] * 31 + 127) / 255) << 11 | ((rgb[1] * 63 + 127) / 255) << 5 | ((rgb[2] * 31 + 127) / 255));
+	}
+	void From565(uint16_t c, int (&rgb)[3]) {
+		int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+		rgb[0] = (r << 3) | (r >> 2);
+		rgb[1] = (g << 2) | (g >> 4);
+		rgb[2] = (b << 3) | (b >> 2);
+	}
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Encodes the colour of a 4x4 block into 8 bytes. The endpoints are the
+		corners of the colours' bounding box, inset by a sixteenth so the
+		palette covers the block more evenly, and each pixel takes the
+		nearest of the 4 palette colours. Fully transparent pixels are left
+		out of the box when ignoreTransparent is set, as their colour is
+		never seen.
+	*/
+	/**************************************************************************/
+	void EncodeColorBlock(const Block& block, bool ignoreTransparent, unsigned char* out) {
+		int lo[3]{ 255, 255, 255 }, hi[3]{ 0, 0, 0 };
+		bool any = false;
+		for (int pass = 0; pass < 2 && !any; ++pass) {
+			for (int i = 0; i < 16; ++i) {
+				if (pass == 0 && ignoreTransparent && block[i][3] == 0) continue;
+				for (int c = 0; c < 3; ++c) {
+					lo[c] = block[i][c] < lo[c] ? block[i][c] : lo[c];
+					hi[c] = block[i][c] > hi[c] ? block[i][c] : hi[c];
+				}
+				any = true;
+			}
+		}
+		for (int c = 0; c < 3; ++c) {
+			int inset = (hi[c] - lo[c]) >> 4;
+			lo[c] += inset;
+			hi[c] -= inset;
+		}
+
+		// c0 > c1 selects the 4 colour mode
+		uint16_t c0 = To565(hi), c1 = To565(lo);
+		if (c0 < c1) std::swap(c0, c1);
+		uint32_t indices = 0;
+		if (c0 != c1) {
+			int palette[4][3];
+			From565(c0, palette[0]);
+			From565(c1, palette[1]);
+			for (int c = 0; c < 3; ++c) {
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			for (int i = 0; i < 16; ++i) {
+				int best = 0, best_dist = INT32_MAX;
+				for (int p = 0; p < 4; ++p) {
+					int dist = 0;
+					for (int c = 0; c < 3; ++c) dist += (block[i][c] - palette[p][c]) * (block[i][c] - palette[p][c]);
+					if (dist < best_dist) { best = p; best_dist = dist; }
+				}
+				indices |= static_cast<uint32_t>(best) << (2 * i);
+			}
+		}
+
+		out[0] = c0 & 0xFF; out[1] = c0 >> 8;
+		out[2] = c1 & 0xFF; out[3] = c1 >> 8;
+		for (int b = 0; b < 4; ++b) out[4 + b] = (indices >> (8 * b)) & 0xFF;
+	}
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Encodes the alpha of a 4x4 block into 8 bytes, between the block's
+		highest and lowest alpha in 8 steps so fully opaque and fully
+		transparent pixels stay exact.
+	*/
+	/**************************************************************************/
+	void EncodeAlphaBlock(const Block& block, unsigned char* out) {
+		int lo = 255, hi = 0;
+		for (int i = 0; i < 16; ++i) {
+			lo = block[i][3] < lo ? block[i][3] : lo;
+			hi = block[i][3] > hi ? block[i][3] : hi;
+		}
+
+		uint64_t indices = 0;
+		if (hi != lo) {
+			int palette[8]{ hi, lo };
+			for (int p = 1; p < 7; ++p) palette[p + 1] = ((7 - p) * hi + p * lo) / 7;
+			for (int i = 0; i < 16; ++i) {
+				int best = 0, best_dist = INT32_MAX;
+				for (int p = 0; p < 8; ++p) {
+					int dist = block[i][3] > palette[p] ? block[i][3] - palette[p] : palette[p] - block[i][3];
+					if (dist < best_dist) { best = p; best_dist = dist; }
+				}
+				indices |= static_cast<uint64_t>(best) << (3 * i);
+			}
+		}
+
+		out[0] = static_cast<unsigned char>(hi);
+		out[1] = static_cast<unsigned char>(lo);
+		for (int b = 0; b < 6; ++b) out[2 + b] = (indices >> (8 * b)) & 0xFF;
+	}
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Compresses one mip level and appends its blocks. Blocks past the
+		right or bottom edge repeat the edge pixels.
+	*/
+	/**************************************************************************/
+	void CompressLevel(const std::vector<unsigned char>& rgba, int w, int h, bool alpha, std::vector<unsigned char>& out) {
+		for (int by = 0; by < h; by += 4) {
+			for (int bx = 0; bx < w; bx += 4) {
+				Block block;
+				for (int i = 0; i < 16; ++i) {
+					int x = bx + (i & 3), y = by + (i >> 2);
+					x = x < w ? x : w - 1;
+					y = y < h ? y : h - 1;
+					const unsigned char* src = &rgba[(static_cast<size_t>(y) * w + x) * 4];
+					block[i][0] = src[0]; block[i][1] = src[1]; block[i][2] = src[2]; block[i][3] = src[3];
+				}
+
+				// DXT5 keeps the alpha block before the colour block
+				unsigned char encoded[16];
+				if (alpha) EncodeAlphaBlock(block, encoded);
+				EncodeColorBlock(block, alpha, alpha ? encoded + 8 : encoded);
+				out.insert(out.end(), encoded, encoded + (alpha ? 16 : 8));
+			}
+		}
+	}
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Halves an image with a 2x2 box filter, like glGenerateMipmap. Odd
+		sizes repeat the last row or column.
+	*/
+	/**************************************************************************/
+	std::vector<unsigned char> Downsample(const std::vector<unsigned char>& src, int w, int h, int& nw, int& nh) {
+		nw = w > 1 ? w / 2 : 1;
+		nh = h > 1 ? h / 2 : 1;
+		std::vector<unsigned char> dst(static_cast<size_t>(nw) * nh * 4);
+		for (int y = 0; y < nh; ++y) {
+			int y0 = 2 * y, y1 = 2 * y + 1 < h ? 2 * y + 1 : 2 * y;
+			for (int x = 0; x < nw; ++x) {
+				int x0 = 2 * x, x1 = 2 * x + 1 < w ? 2 * x + 1 : 2 * x;
+				for (int c = 0; c < 4; ++c) {
+					int sum = src[(static_cast<size_t>(y0) * w + x0) * 4 + c] + src[(static_cast<size_t>(y0) * w + x1) * 4 + c]
+						+ src[(static_cast<size_t>(y1) * w + x0) * 4 + c] + src[(static_cast<size_t>(y1) * w + x1) * 4 + c];
+					dst[(static_cast<size_t>(y) * nw + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+				}
+			}
+		}
+		return dst;
+	}
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Writes a DXT1/DXT5 .dds holding every mip level. Rows are stored as
+		loaded, bottom row first, so they upload the same way as the image.
+	*/
+	/**************************************************************************/
+	bool WriteDDS(const std::string& filename, int w, int h, bool alpha, uint32_t levels, const std::vector<unsigned char>& blocks) {
+		std::ofstream file(filename, std::ios::binary);
+		if (!file.is_open()) return false;
+
+		uint32_t header[32]{};
+		header[0] = 0x20534444;								// "DDS "
+		header[1] = 124;									// header size
+		header[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000;	// caps, height, width, pixel format, mip count, linear size
+		header[3] = static_cast<uint32_t>(h);
+		header[4] = static_cast<uint32_t>(w);
+		header[5] = static_cast<uint32_t>(((w + 3) / 4) * ((h + 3) / 4) * (alpha ? 16 : 8));
+		header[7] = levels;
+		header[19] = 32;									// pixel format size
+		header[20] = 0x4;									// DDPF_FOURCC
+		header[21] = alpha ? 0x35545844 : 0x31545844;		// "DXT5" or "DXT1"
+		header[27] = 0x1000 | 0x400000 | 0x8;				// texture, mipmap, complex
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(blocks.data()), static_cast<std::streamsize>(blocks.size()));
+		return file.good();
+	}
+
+	bool IsImage(const std::filesystem::path& path) {
+		std::string ext = path.extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga";
+	}
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Reads cooker settings from the command line.
+
+  \param argc
+	Number of arguments.
+
+  \param argv
+	Arguments.
+
+  \param settings
+	Settings to fill in.
+
+  \return
+	True if all arguments were valid.
+*/
+/**************************************************************************/
+bool TextureCooker::ParseArguments(int argc, char** argv, Settings& settings) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--cook-textures") continue;
+		if (arg == "--force") { settings.Force = true; continue; }
+		std::string value;
+		if (!CommandLine::NextArgument(argc, argv, i, value)) return false;
+
+		if (arg == "--source-dir") settings.SourceDir = value;
+		else if (arg == "--report") settings.Report = value;
+		else { std::cout << "Unknown argument " << arg << "\n"; return false; }
+	}
+
+	if (!std::filesystem::is_directory(settings.SourceDir)) {
+		std::cout << "Invalid source directory " << settings.SourceDir << "\n";
+		return false;
+	}
+	return true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Cooks one image into its .dds. The image is loaded flipped, as the game
+	loads it, and the .dds is read back afterwards to time loading it.
+
+  \param path
+	Filename of .png/.jpeg file.
+
+  \param result
+	Savings of the image.
+
+  \return
+	False if the image could not be read or the .dds written.
+*/
+/**************************************************************************/
+bool TextureCooker::CookImage(const std::string& path, Result& result) {
+	result = { path, 0, 0, false, 0, 0, 0.0, 0.0 };
+
+	auto start = std::chrono::steady_clock::now();
+	int channels{};
+	unsigned char* data = stbi_load(path.c_str(), &result.w, &result.h, &channels, 4);
+	result.decode_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	if (!data) { std::cout << "[TextureCooker] Failed to load " << path << "\n"; return false; }
+
+	std::vector<unsigned char> level(data, data + static_cast<size_t>(result.w) * result.h * 4);
+	stbi_image_free(data);
+
+	// DXT5 only where some pixel is not opaque, it is twice the size of DXT1
+	if (channels == 2 || channels == 4) {
+		for (size_t i = 3; i < level.size() && !result.alpha; i += 4) result.alpha = level[i] != 255;
+	}
+
+	std::vector<unsigned char> blocks;
+	uint32_t levels = 0;
+	int w = result.w, h = result.h;
+	for (;;) {
+		CompressLevel(level, w, h, result.alpha, blocks);
+		result.rgba_bytes += static_cast<size_t>(w) * h * 4;
+		++levels;
+		if (w == 1 && h == 1) break;
+		int nw{}, nh{};
+		level = Downsample(level, w, h, nw, nh);
+		w = nw;
+		h = nh;
+	}
+	result.cooked_bytes = blocks.size();
+
+	std::string cooked = Texture::Cooked_Path(path.c_str());
+	std::error_code ec;
+	std::filesystem::create_directories(std::filesystem::path(cooked).parent_path(), ec);
+	if (!WriteDDS(cooked, result.w, result.h, result.alpha, levels, blocks)) { std::cout << "[TextureCooker] Could not write " << cooked << "\n"; return false; }
+
+	start = std::chrono::steady_clock::now();
+	Texture::Cooked image;
+	if (!Texture::Read_Cooked(cooked.c_str(), image)) { std::cout << "[TextureCooker] Could not read back " << cooked << "\n"; return false; }
+	result.read_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return true;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Block compresses one level of an image.
+
+  \param rgba
+	Pixels of the image, 4 bytes each.
+
+  \param w
+	Width of the image.
+
+  \param h
+	Height of the image.
+
+  \param alpha
+	DXT5 if true, DXT1 otherwise.
+
+  \param out
+	Blocks are appended to it.
+*/
+/**************************************************************************/
+void TextureCooker::CompressImage(const std::vector<unsigned char>& rgba, int w, int h, bool alpha, std::vector<unsigned char>& out) {
+	CompressLevel(rgba, w, h, alpha, out);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Cooks every image that has no up to date .dds and writes the report.
+	The RGBA8 size counts the mips glGenerateMipmap would have made, so
+	both sizes are what the texture takes in video memory.
+
+  \param settings
+	Cooker settings.
+
+  \return
+	True if every image was cooked.
+*/
+/**************************************************************************/
+bool TextureCooker::Cook(const Settings& settings) {
+	std::vector<std::string> paths;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(settings.SourceDir)) {
+		if (entry.is_regular_file() && IsImage(entry.path())) paths.push_back(entry.path().generic_string());
+	}
+	std::sort(paths.begin(), paths.end());
+
+	stbi_set_flip_vertically_on_load(1);
+
+	std::vector<Result> results;
+	size_t up_to_date = 0, failed = 0;
+	std::cout << std::fixed << std::setprecision(2);
+	for (const std::string& path : paths) {
+		if (!settings.Force && !Texture::Find_Cooked(path.c_str()).empty()) { ++up_to_date; continue; }
+
+		Result result;
+		if (!CookImage(path, result)) { ++failed; continue; }
+		results.push_back(result);
+		std::cout << "[TextureCooker] " << path << " " << result.w << "x" << result.h << (result.alpha ? " DXT5 " : " DXT1 ")
+			<< result.rgba_bytes / 1048576.0 << " MB -> " << result.cooked_bytes / 1048576.0 << " MB, "
+			<< result.decode_ms << " ms -> " << result.read_ms << " ms\n";
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(std::filesystem::path(settings.Report).parent_path(), ec);
+	std::ofstream report(settings.Report);
+	if (!report.is_open()) { std::cout << "[TextureCooker] Could not open " << settings.Report << "\n"; return false; }
+	report << std::fixed << std::setprecision(3);
+	report << "Image,Width,Height,Format,RGBA8Bytes,CookedBytes,DecodeMs,ReadMs\n";
+
+	size_t rgba_total = 0, cooked_total = 0;
+	double decode_total = 0.0, read_total = 0.0;
+	for (const Result& r : results) {
+		report << r.path << "," << r.w << "," << r.h << "," << (r.alpha ? "DXT5" : "DXT1") << "," << r.rgba_bytes << "," << r.cooked_bytes
+			<< "," << r.decode_ms << "," << r.read_ms << "\n";
+		rgba_total += r.rgba_bytes;
+		cooked_total += r.cooked_bytes;
+		decode_total += r.decode_ms;
+		read_total += r.read_ms;
+	}
+
+	std::cout << "[TextureCooker] Cooked " << results.size() << " images (" << up_to_date << " up to date, " << failed << " failed): "
+		<< rgba_total / 1048576.0 << " MB -> " << cooked_total / 1048576.0 << " MB, "
+		<< decode_total << " ms -> " << read_total << " ms\n";
+	return failed == 0;
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Runs the cooker from the command line.
+
+  \param argc
+	Number of arguments.
+
+  \param argv
+	Arguments.
+
+  \return
+	0 on success.
+*/
+/**************************************************************************/
+int TextureCooker::Run(int argc, char** argv) {
+	Settings settings;
+	if (!ParseArguments(argc, argv, settings)) {
+		std::cout << "Usage: --cook-textures [--force] [--source-dir ./Images] [--report ./Images/Cooked/CookReport.csv]\n";
+		return 1;
+	}
+	return Cook(settings) ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+/******************************************************************************/
+/*!
+\file    TextureCooker.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Offline texture cooker. Every image under ./Images is block
+		 compressed (DXT1 when opaque, DXT5 with alpha) with its whole mip
+		 chain into a .dds under ./Images/Cooked, which Texture and
+		 TextureLoader upload as is. The first two mips double as the half
+		 and quarter size tiers, loaded by skipping the levels above them
+		 on lower resolution outputs. The memory and load time saved are
+		 reported for each image. Run the game with --cook-textures, after
+		 --cook-atlases so the atlas pages are cooked too.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace TextureCooker {
+	/**************************************************************************/
+	/*!
+	  \brief
+		Cooker settings, all can be changed from the command line.
+	*/
+	/**************************************************************************/
+	struct Settings {
+		std::string SourceDir{ "./Images" };						// --source-dir, searched recursively
+		std::string Report{ "./Images/Cooked/CookReport.csv" };	// --report, one row per cooked image
+		bool Force{ false };										// --force, cook images whose .dds is up to date
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		What cooking one image saved.
+	*/
+	/**************************************************************************/
+	struct Result {
+		std::string path;
+		int w, h;
+		bool alpha;				// DXT5 if true, DXT1 otherwise
+		size_t rgba_bytes;		// RGBA8 with mips, as uploaded from the image
+		size_t cooked_bytes;	// compressed with mips
+		double decode_ms;		// stbi_load of the image
+		double read_ms;			// reading the .dds back
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Reads cooker settings from the command line.
+
+	  \param argc
+		Number of arguments.
+
+	  \param argv
+		Arguments.
+
+	  \param settings
+		Settings to fill in.
+
+	  \return
+		True if all arguments were valid.
+	*/
+	/**************************************************************************/
+	bool ParseArguments(int argc, char** argv, Settings& settings);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Cooks one image into its .dds.
+
+	  \param path
+		Filename of .png/.jpeg file.
+
+	  \param result
+		Savings of the image.
+
+	  \return
+		False if the image could not be read or the .dds written.
+	*/
+	/**************************************************************************/
+	bool CookImage(const std::string& path, Result& result);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Block compresses one level of an image, as CookImage does for each
+		of its mips.
+
+	  \param rgba
+		Pixels of the image, 4 bytes each.
+
+	  \param w
+		Width of the image.
+
+	  \param h
+		Height of the image.
+
+	  \param alpha
+		DXT5 if true, DXT1 otherwise.
+
+	  \param out
+		Blocks are appended to it.
+	*/
+	/**************************************************************************/
+	void CompressImage(const std::vector<unsigned char>& rgba, int w, int h, bool alpha, std::vector<unsigned char>& out);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Cooks every image that has no up to date .dds and writes the report.
+
+	  \param settings
+		Cooker settings.
+
+	  \return
+		True if every image was cooked.
+	*/
+	/**************************************************************************/
+	bool Cook(const Settings& settings);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Runs the cooker from the command line.
+
+	  \param argc
+		Number of arguments.
+
+	  \param argv
+		Arguments.
+
+	  \return
+		0 on success.
+	*/
+	/**************************************************************************/
+	int Run(int argc, char** argv);
+}
@@ -0,0 +1,498 @@
+/******************************************************************************/
+/*!
+\file    TextureLoader.cpp
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Loads textures in the background. Images are decoded on worker
+		 threads, and the thread owning the OpenGL context uploads them
+		 through a pixel unpack buffer within a time budget each frame.
+		 The texture name is handed out right away with a 1x1 placeholder,
+		 and its storage is replaced once the image is uploaded, so every
+		 copy of the name shows the image without being updated.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <Graphics/TextureLoader.h>
+#include <Graphics/Texture.h>
+#include "../3rdParty/stb_image.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+static const unsigned MaxDecodeThreads = 4;
+static const int DiscardAlpha = 25;		// quad.frag discards texels under 0.1 alpha
+
+struct DecodeJob
+{
+	GLuint Texture;
+	uint64_t Ticket;
+	std::string Path;
+	std::string Cooked;		// .dds to read instead, empty if none
+	int Tier;				// times the image is halved
+	std::atomic<bool>* Opaque;	// told on upload whether the image is opaque, may be null
+};
+
+struct DecodedImage
+{
+	GLuint Texture = 0;
+	uint64_t Ticket = 0;
+	int Width = 0;
+	int Height = 0;
+	int Channels = 0;
+	std::unique_ptr<unsigned char, void(*)(void*)> Pixels{ nullptr, stbi_image_free };
+	Texture::Cooked Compressed;		// filled instead of Pixels for cooked textures
+	std::atomic<bool>* OpaqueOut = nullptr;
+	bool Opaque = false;			// no texel is blended, each is either discarded or solid
+};
+
+struct LoaderData
+{
+	std::vector<std::thread> Threads;
+	std::mutex Mutex;
+	std::condition_variable JobReady;
+	std::deque<DecodeJob> Jobs;
+	std::deque<DecodedImage> Decoded;
+	bool Stopping = false;
+
+	// Only used by the thread owning the OpenGL context
+	GLuint PBO = 0;
+	GLuint Placeholder = 0;
+	uint64_t NextTicket = 0;
+	std::unordered_map<GLuint, uint64_t> Pending;	// ticket of the job each texture waits on
+
+	std::atomic<size_t> Requested{ 0 };
+	std::atomic<size_t> Uploaded{ 0 };
+	std::atomic<size_t> Failed{ 0 };
+};
+
+static LoaderData Loader_Data;
+
+/**************************************************************************/
+/*!
+  \brief
+	Halves a decoded image with a box filter. The smaller image is
+	allocated with malloc, which is what stbi_image_free releases.
+*/
+/**************************************************************************/
+void Halve_Image(DecodedImage& image) {
+	if (image.Width < 2 && image.Height < 2)
+		return;
+	const int w = image.Width > 1 ? image.Width / 2 : 1;
+	const int h = image.Height > 1 ? image.Height / 2 : 1;
+	const int c = image.Channels;
+	unsigned char* half = static_cast<unsigned char*>(malloc((size_t)w * h * c));
+	if (!half)
+		return;
+
+	const unsigned char* source = image.Pixels.get();
+	for (int y = 0; y < h; ++y) {
+		const int y0 = y * 2, y1 = y0 + 1 < image.Height ? y0 + 1 : y0;
+		for (int x = 0; x < w; ++x) {
+			const int x0 = x * 2, x1 = x0 + 1 < image.Width ? x0 + 1 : x0;
+			for (int i = 0; i < c; ++i) {
+				int sum = source[((size_t)y0 * image.Width + x0) * c + i] + source[((size_t)y0 * image.Width + x1) * c + i]
+					+ source[((size_t)y1 * image.Width + x0) * c + i] + source[((size_t)y1 * image.Width + x1) * c + i];
+				half[((size_t)y * w + x) * c + i] = (unsigned char)((sum + 2) / 4);
+			}
+		}
+	}
+	image.Pixels.reset(half);
+	image.Width = w;
+	image.Height = h;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Checks that every texel of a decoded image is either solid or discarded
+	by quad.frag, so it can be drawn without blending.
+*/
+/**************************************************************************/
+bool Is_Opaque(const DecodedImage& image) {
+	if (image.Channels < 4)
+		return true;
+	const unsigned char* pixels = image.Pixels.get();
+	const size_t count = (size_t)image.Width * image.Height;
+	for (size_t i = 0; i < count; ++i) {
+		int alpha = pixels[i * 4 + 3];
+		if (alpha > DiscardAlpha && alpha < 255)
+			return false;
+	}
+	return true;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Checks a cooked image the same way, from the alpha blocks of its largest
+	level read. DXT1 alpha is only ever on or off.
+*/
+/**************************************************************************/
+bool Is_Opaque(const Texture::Cooked& image) {
+	if (image.Format != GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+		return true;
+	if (image.LevelOffsets.empty())
+		return false;
+
+	// 16 byte blocks, the first 8 hold two alpha endpoints and 16 3-bit indices
+	const unsigned char* block = image.Data.data() + image.LevelOffsets[0];
+	const unsigned char* end = block + image.LevelSizes[0];
+	for (; block + 16 <= end; block += 16) {
+		int a0 = block[0], a1 = block[1];
+		int palette[8] = { a0, a1 };
+		for (int i = 2; i < 8; ++i) {
+			if (a0 > a1) palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+			else palette[i] = i < 6 ? ((6 - i) * a0 + (i - 1) * a1) / 5 : (i == 6 ? 0 : 255);
+		}
+		uint64_t indices = 0;
+		for (int i = 0; i < 6; ++i)
+			indices |= (uint64_t)block[2 + i] << (8 * i);
+		for (int i = 0; i < 16; ++i) {
+			int alpha = palette[(indices >> (3 * i)) & 7];
+			if (alpha > DiscardAlpha && alpha < 255)
+				return false;
+		}
+	}
+	return true;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Decodes the image of a job. Cooked textures are read as they are, less
+	the mips above the tier. Other images are decoded into 3 or 4 channels
+	as Texture::STBI_Load_Texture would upload them and halved down to the
+	tier. Whether the image is opaque is checked before it is halved, as
+	halving softens edges that mipmapping softens anyway.
+*/
+/**************************************************************************/
+void Decode_Job(const DecodeJob& job, DecodedImage& image) {
+	image.Texture = job.Texture;
+	image.Ticket = job.Ticket;
+	image.OpaqueOut = job.Opaque;
+	if (!job.Cooked.empty() && Texture::Read_Cooked(job.Cooked.c_str(), image.Compressed, job.Tier)) {
+		image.Opaque = Is_Opaque(image.Compressed);
+		return;
+	}
+	image.Pixels.reset(stbi_load(job.Path.c_str(), &image.Width, &image.Height, &image.Channels, 0));
+	// Grey images are expanded rather than uploaded as red
+	if (image.Pixels && image.Channels < 3) {
+		image.Pixels.reset(stbi_load(job.Path.c_str(), &image.Width, &image.Height, &image.Channels, 4));
+		image.Channels = 4;
+	}
+	if (!image.Pixels) {
+		std::cout << "Failed to load texture from " << job.Path << std::endl;
+		return;
+	}
+	image.Opaque = Is_Opaque(image);
+	for (int tier = 0; tier < job.Tier; ++tier)
+		Halve_Image(image);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Decode thread loop. Takes jobs until Shutdown.
+*/
+/**************************************************************************/
+void Decode_Images() {
+	for (;;) {
+		DecodeJob job;
+		{
+			std::unique_lock<std::mutex> lock(Loader_Data.Mutex);
+			Loader_Data.JobReady.wait(lock, [] { return Loader_Data.Stopping || !Loader_Data.Jobs.empty(); });
+			if (Loader_Data.Stopping)
+				return;
+			job = std::move(Loader_Data.Jobs.front());
+			Loader_Data.Jobs.pop_front();
+		}
+
+		// Failed images are still handed back, so the texture stops waiting on them
+		DecodedImage image;
+		Decode_Job(job, image);
+
+		std::lock_guard<std::mutex> lock(Loader_Data.Mutex);
+		Loader_Data.Decoded.push_back(std::move(image));
+	}
+}
+/**************************************************************************/
+/*!
+  \brief
+	Replaces a texture's placeholder with a decoded image. The pixels are
+	copied into the orphaned unpack buffer, so glTexImage2D returns without
+	waiting for the transfer and the buffer is never written while the GPU
+	still reads it. Cooked textures go through the same buffer with all
+	their mip levels, so nothing is generated.
+*/
+/**************************************************************************/
+void Upload_Image(const DecodedImage& image) {
+	if (image.OpaqueOut)
+		image.OpaqueOut->store(image.Opaque);
+	const bool cooked = !image.Compressed.Data.empty();
+	const unsigned char* source = cooked ? image.Compressed.Data.data() : image.Pixels.get();
+	GLsizeiptr size = cooked ? (GLsizeiptr)image.Compressed.Data.size() : (GLsizeiptr)image.Width * image.Height * image.Channels;
+	glNamedBufferData(Loader_Data.PBO, size, nullptr, GL_STREAM_DRAW);
+	void* mapped = glMapNamedBufferRange(Loader_Data.PBO, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+	const void* pixels = source;
+	if (mapped) {
+		memcpy(mapped, source, (size_t)size);
+		glUnmapNamedBuffer(Loader_Data.PBO);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, Loader_Data.PBO);
+		pixels = nullptr;	// offset into the unpack buffer
+	}
+
+	if (cooked) {
+		glBindTexture(GL_TEXTURE_2D, image.Texture);
+		Texture::Upload_Cooked(image.Compressed, mapped != nullptr);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return;
+	}
+
+	GLenum format = image.Channels == 4 ? GL_RGBA : GL_RGB;
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glBindTexture(GL_TEXTURE_2D, image.Texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);	// a cooked upload before may have lowered it
+	glTexImage2D(GL_TEXTURE_2D, 0, format, image.Width, image.Height, 0, format, GL_UNSIGNED_BYTE, pixels);
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Hands a job to the decode threads. A job queued before for the same
+	texture is dropped once decoded, since its ticket no longer matches.
+	Without workers the image is decoded and uploaded here.
+*/
+/**************************************************************************/
+void Queue_Image(DecodeJob job) {
+	if (!Loader_Data.PBO)
+		glCreateBuffers(1, &Loader_Data.PBO);
+
+	if (Loader_Data.Threads.empty()) {
+		DecodedImage image;
+		Decode_Job(job, image);
+		if (image.Pixels || !image.Compressed.Data.empty())
+			Upload_Image(image);
+		return;
+	}
+
+	if (!Loader_Data.Pending.count(job.Texture))
+		++Loader_Data.Requested;
+	job.Ticket = ++Loader_Data.NextTicket;
+	Loader_Data.Pending[job.Texture] = job.Ticket;
+	{
+		std::lock_guard<std::mutex> lock(Loader_Data.Mutex);
+		Loader_Data.Jobs.push_back(std::move(job));
+	}
+	Loader_Data.JobReady.notify_one();
+}
+
+/**************************************************************************/
+/*!
+  \brief
+	Starts the decode threads.
+*/
+/**************************************************************************/
+void TextureLoader::Init() {
+	unsigned threads = std::thread::hardware_concurrency();
+	threads = threads > 1 ? threads - 1 : 1;
+	threads = threads < MaxDecodeThreads ? threads : MaxDecodeThreads;
+
+	Loader_Data.Stopping = false;
+	for (unsigned i = 0; i < threads; ++i)
+		Loader_Data.Threads.emplace_back(Decode_Images);
+
+	GLuint transparent = 0;
+	glCreateTextures(GL_TEXTURE_2D, 1, &Loader_Data.Placeholder);
+	glTextureStorage2D(Loader_Data.Placeholder, 1, GL_RGBA8, 1, 1);
+	glTextureSubImage2D(Loader_Data.Placeholder, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, &transparent);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Stops the decode threads and frees what was not uploaded.
+*/
+/**************************************************************************/
+void TextureLoader::Shutdown() {
+	{
+		std::lock_guard<std::mutex> lock(Loader_Data.Mutex);
+		Loader_Data.Stopping = true;
+	}
+	Loader_Data.JobReady.notify_all();
+	for (std::thread& thread : Loader_Data.Threads)
+		thread.join();
+	Loader_Data.Threads.clear();
+
+	Loader_Data.Jobs.clear();
+	Loader_Data.Decoded.clear();
+	Loader_Data.Pending.clear();
+	glDeleteBuffers(1, &Loader_Data.PBO);
+	Loader_Data.PBO = 0;
+	glDeleteTextures(1, &Loader_Data.Placeholder);
+	Loader_Data.Placeholder = 0;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Creates a placeholder texture and queues the image to be decoded.
+*/
+/**************************************************************************/
+GLuint TextureLoader::Load(char const* pathname, int& width, int& height, bool isRepeated, int tier, std::atomic<bool>* opaque) {
+	GLuint texture = 0;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	GLint wrap = isRepeated ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	GLuint placeholder = 0;
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &placeholder);
+
+	// Only the header is read here, the pixels are decoded on a worker
+	std::string cooked = Texture::Find_Cooked(pathname);
+	if (!cooked.empty() && !Texture::Read_Cooked_Size(cooked.c_str(), width, height))
+		cooked.clear();
+	int channels = 0;
+	if (cooked.empty() && !stbi_info(pathname, &width, &height, &channels)) {
+		std::cout << "Failed to load texture from " << pathname << std::endl;
+		width = height = 0;
+		return texture;
+	}
+
+	Queue_Image({ texture, 0, pathname, cooked, tier, opaque });
+	return texture;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Queues the image of a texture made by Load to be decoded again at
+	another tier.
+*/
+/**************************************************************************/
+void TextureLoader::Reload(GLuint texture, char const* pathname, int tier, std::atomic<bool>* opaque) {
+	Queue_Image({ texture, 0, pathname, Texture::Find_Cooked(pathname), tier, opaque });
+}
+/**************************************************************************/
+/*!
+  \brief
+	Deletes a texture, dropping its image if it is still being decoded.
+*/
+/**************************************************************************/
+void TextureLoader::Unload(GLuint texture) {
+	if (Loader_Data.Pending.erase(texture)) {
+		--Loader_Data.Requested;
+		std::lock_guard<std::mutex> lock(Loader_Data.Mutex);
+		for (auto it = Loader_Data.Jobs.begin(); it != Loader_Data.Jobs.end();) {
+			it = it->Texture == texture ? Loader_Data.Jobs.erase(it) : it + 1;
+		}
+	}
+	glDeleteTextures(1, &texture);
+}
+/**************************************************************************/
+/*!
+  \brief
+	Reads the size of an image, or of its cooked .dds, from the header only.
+*/
+/**************************************************************************/
+bool TextureLoader::ReadHeader(char const* pathname, int& width, int& height, size_t& bytes) {
+	std::string cooked = Texture::Find_Cooked(pathname);
+	if (!cooked.empty() && Texture::Read_Cooked_Size(cooked.c_str(), width, height)) {
+		std::error_code ec;
+		uintmax_t size = std::filesystem::file_size(cooked, ec);
+		bytes = ec || size < 128 ? 0 : (size_t)size - 128;	// less the header
+		return true;
+	}
+
+	int channels = 0;
+	if (!stbi_info(pathname, &width, &height, &channels)) {
+		width = height = 0;
+		bytes = 0;
+		return false;
+	}
+	// RGBA8, the mips add a third
+	bytes = (size_t)width * height * 4 * 4 / 3;
+	return true;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gets the transparent 1x1 texture shown in place of textures that are
+	not loaded.
+*/
+/**************************************************************************/
+GLuint TextureLoader::GetPlaceholder() {
+	return Loader_Data.Placeholder;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Uploads decoded images until the budget is spent.
+*/
+/**************************************************************************/
+void TextureLoader::Update(double budget_ms) {
+	auto start = std::chrono::steady_clock::now();
+	for (;;) {
+		DecodedImage image;
+		{
+			std::lock_guard<std::mutex> lock(Loader_Data.Mutex);
+			if (Loader_Data.Decoded.empty())
+				return;
+			image = std::move(Loader_Data.Decoded.front());
+			Loader_Data.Decoded.pop_front();
+		}
+
+		// The texture was unloaded while its image was decoded
+		auto pending = Loader_Data.Pending.find(image.Texture);
+		if (pending == Loader_Data.Pending.end() || pending->second != image.Ticket)
+			continue;
+		Loader_Data.Pending.erase(pending);
+		if (!image.Pixels && image.Compressed.Data.empty()) {
+			++Loader_Data.Failed;
+			continue;
+		}
+
+		Upload_Image(image);
+		++Loader_Data.Uploaded;
+
+		std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - start;
+		if (spent.count() >= budget_ms)
+			return;
+	}
+}
+/**************************************************************************/
+/*!
+  \brief
+	Gets how many textures were requested and how many are done.
+*/
+/**************************************************************************/
+TextureLoader::Progress TextureLoader::GetProgress() {
+	Progress progress;
+	progress.Requested = Loader_Data.Requested;
+	progress.Uploaded = Loader_Data.Uploaded;
+	progress.Failed = Loader_Data.Failed;
+	return progress;
+}
+/**************************************************************************/
+/*!
+  \brief
+	Whether every texture requested so far is done.
+*/
+/**************************************************************************/
+bool TextureLoader::IsIdle() {
+	Progress progress = GetProgress();
+	return progress.Uploaded + progress.Failed >= progress.Requested;
+}
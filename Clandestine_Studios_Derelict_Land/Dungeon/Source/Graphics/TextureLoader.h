@@ -0,0 +1,188 @@
+/******************************************************************************/
+/*!
+\file    TextureLoader.h
+\author  Warren Ang Jun Xuan
+\par     email: a.warrenjunxuan@digipen.edu
+\date    March 22, 2023
+\brief   Loads textures in the background. Images are decoded on worker
+		 threads, and the thread owning the OpenGL context uploads them
+		 through a pixel unpack buffer within a time budget each frame.
+		 The texture name is handed out right away with a 1x1 placeholder,
+		 and its storage is replaced once the image is uploaded, so every
+		 copy of the name shows the image without being updated.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include <GL/glew.h>
+#include <atomic>
+#include <cstddef>
+
+class TextureLoader {
+public:
+	/**************************************************************************/
+	/*!
+	  \brief
+		Counts of textures handed to the loader, for a loading screen.
+	*/
+	/**************************************************************************/
+	struct Progress {
+		size_t Requested = 0;
+		size_t Uploaded = 0;
+		size_t Failed = 0;		// could not be decoded, left as the placeholder
+	};
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Starts the decode threads, one less than the hardware threads and at
+		most four, and creates the placeholder texture. Call with the OpenGL
+		context current.
+	*/
+	/**************************************************************************/
+	static void Init();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Stops the decode threads, dropping anything not uploaded yet, and
+		frees the unpack buffer and placeholder. Call with the OpenGL context
+		current.
+	*/
+	/**************************************************************************/
+	static void Shutdown();
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Creates a texture holding a transparent 1x1 placeholder and queues the
+		image to be decoded into it. The size is read from the image header,
+		so it is known right away. An up to date cooked .dds is read instead
+		of the image and uploaded compressed. Call with the OpenGL context
+		current.
+
+	  \param pathname
+		Filename of .png/.jpeg file.
+
+	  \param width
+		Width of the image, 0 if it can not be read.
+
+	  \param height
+		Height of the image, 0 if it can not be read.
+
+	  \param isRepeated
+		Texture isRepeated flag.
+
+	  \param tier
+		Times the image is halved before it is uploaded, 0 for full size.
+		Cooked textures leave out their top mips instead, so less is read.
+		The size returned is always the full size.
+
+	  \param opaque
+		Set when the image is uploaded, true if every texel is either solid
+		or discarded by quad.frag so it can be drawn without blending. May
+		be null.
+
+	  \return
+		Texture name, valid at once.
+	*/
+	/**************************************************************************/
+	static GLuint Load(char const* pathname, int& width, int& height, bool isRepeated = false, int tier = 0, std::atomic<bool>* opaque = nullptr);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Decodes the image of a texture made by Load again at another tier.
+		The texture keeps showing its current image until the new one is
+		uploaded into the same name. Call with the OpenGL context current.
+
+	  \param texture
+		Texture name returned by Load.
+
+	  \param pathname
+		Filename of .png/.jpeg file.
+
+	  \param tier
+		Times the image is halved, 0 for full size.
+
+	  \param opaque
+		Set when the image is uploaded, as for Load. May be null.
+	*/
+	/**************************************************************************/
+	static void Reload(GLuint texture, char const* pathname, int tier, std::atomic<bool>* opaque = nullptr);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Deletes a texture made by Load. If its image is still being decoded
+		it is dropped, so the texture name can be reused safely. Call with
+		the OpenGL context current.
+
+	  \param texture
+		Texture name returned by Load.
+	*/
+	/**************************************************************************/
+	static void Unload(GLuint texture);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Reads the size of an image, or of its cooked .dds, from the header
+		only. Needs no OpenGL context.
+
+	  \param pathname
+		Filename of .png/.jpeg file.
+
+	  \param width
+		Width of the image.
+
+	  \param height
+		Height of the image.
+
+	  \param bytes
+		Video memory the texture will take with its mips.
+
+	  \return
+		False if the image can not be read.
+	*/
+	/**************************************************************************/
+	static bool ReadHeader(char const* pathname, int& width, int& height, size_t& bytes);
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets the transparent 1x1 texture shown in place of textures that are
+		not loaded, 0 before Init.
+	*/
+	/**************************************************************************/
+	static GLuint GetPlaceholder();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Uploads decoded images until the budget is spent. At least one image
+		is uploaded per call so loading always moves on. Call once per frame
+		with the OpenGL context current.
+
+	  \param budget_ms
+		Time the uploads may take.
+	*/
+	/**************************************************************************/
+	static void Update(double budget_ms = 2.0);
+
+	/**************************************************************************/
+	/*!
+	  \brief
+		Gets how many textures were requested and how many are done.
+	*/
+	/**************************************************************************/
+	static Progress GetProgress();
+	/**************************************************************************/
+	/*!
+	  \brief
+		Whether every texture requested so far is done.
+	*/
+	/**************************************************************************/
+	static bool IsIdle();
+};
+
+#endif
@@ -23,13 +23,58 @@ Program to draw certain meshes or data from VBO.
     name of the variable
 \return
     intger value of the location of the variable in buffer
-    - GL_INVALID_VALUE if the program is not a value generated by opengl
-    - GL_INVALID_OPERATION if the program is not valid or not successfully linked.
+    - -1 if the program has no active uniform of that name
 *******************************************************************************/
 GLint
-GLSLShader::GetUniformLocation(GLchar const* name) 
+GLSLShader::GetUniformLocation(GLchar const* name) const
 { 
-    return glGetUniformLocation(pgm_handle, name);
+    auto it = uniform_locations.find(std::string_view(name));
+    return it != uniform_locations.end() ? it->second : -1;
+}
+
+/*!*****************************************************************************
+\brief
+    ReflectUniforms() reads every active uniform of the linked program once
+    and stores its location, so SetUniform never asks the driver by name
+*******************************************************************************/
+void
+GLSLShader::ReflectUniforms()
+{
+    uniform_locations.clear();
+
+    GLint max_length, num_uniforms;
+    glGetProgramiv(pgm_handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+    glGetProgramiv(pgm_handle, GL_ACTIVE_UNIFORMS, &num_uniforms);
+    std::vector<GLchar> pname(max_length > 0 ? max_length : 1);
+
+    for (GLint i = 0; i < num_uniforms; ++i)
+    {
+        GLsizei written;
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(pgm_handle, i, max_length, &written, &size, &type, pname.data());
+        std::string name(pname.data(), written);
+
+        GLint loc = glGetUniformLocation(pgm_handle, name.c_str());
+        if (loc < 0)
+        {
+            continue; // member of a uniform block
+        }
+        uniform_locations[name] = loc;
+
+        // arrays are reported as "name[0]", also store "name" and each element
+        size_t bracket = name.find('[');
+        if (bracket != std::string::npos)
+        {
+            std::string base = name.substr(0, bracket);
+            uniform_locations[base] = loc;
+            for (GLint e = 1; e < size; ++e)
+            {
+                std::string element = base + "[" + std::to_string(e) + "]";
+                uniform_locations[element] = glGetUniformLocation(pgm_handle, element.c_str());
+            }
+        }
+    }
 }
 
 /*!*****************************************************************************
@@ -344,6 +389,7 @@ GLboolean GLSLShader::Link()
         return GL_FALSE;
     }
     
+    ReflectUniforms();
     return is_linked = GL_TRUE;
 }
 
@@ -503,7 +549,7 @@ void GLSLShader::BindFragDataLocation(GLuint color_number, GLchar const* name)
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, GLboolean val) 
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniform1i(loc, val);
@@ -525,7 +571,7 @@ void GLSLShader::SetUniform(GLchar const* name, GLboolean val)
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, GLint val)
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniform1i(loc, val);
@@ -547,7 +593,7 @@ void GLSLShader::SetUniform(GLchar const* name, GLint val)
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, GLfloat val) 
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniform1f(loc, val);
@@ -571,7 +617,7 @@ void GLSLShader::SetUniform(GLchar const* name, GLfloat val)
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, GLfloat x, GLfloat y) 
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniform2f(loc, x, y);
@@ -598,7 +644,7 @@ void GLSLShader::SetUniform(GLchar const* name, GLfloat x, GLfloat y)
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, GLfloat x, GLfloat y, GLfloat z)
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniform3f(loc, x, y, z);
@@ -629,7 +675,7 @@ void GLSLShader::SetUniform(GLchar const* name, GLfloat x, GLfloat y, GLfloat z)
 void
 GLSLShader::SetUniform(GLchar const* name, GLfloat x, GLfloat y, GLfloat z, GLfloat w) 
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniform4f(loc, x, y, z, w);
@@ -652,7 +698,7 @@ GLSLShader::SetUniform(GLchar const* name, GLfloat x, GLfloat y, GLfloat z, GLfl
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, glm::vec2 const& val) 
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniform2f(loc, val.x, val.y);
@@ -674,7 +720,7 @@ void GLSLShader::SetUniform(GLchar const* name, glm::vec2 const& val)
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, glm::vec3 const& val)
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniform3f(loc, val.x, val.y, val.z);
@@ -696,7 +742,7 @@ void GLSLShader::SetUniform(GLchar const* name, glm::vec3 const& val)
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, glm::vec4 const& val) 
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniform4f(loc, val.x, val.y, val.z, val.w);
@@ -718,7 +764,7 @@ void GLSLShader::SetUniform(GLchar const* name, glm::vec4 const& val)
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, glm::mat3 const& val)
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniformMatrix3fv(loc, 1, GL_FALSE, &val[0][0]);
@@ -740,7 +786,7 @@ void GLSLShader::SetUniform(GLchar const* name, glm::mat3 const& val)
 *******************************************************************************/
 void GLSLShader::SetUniform(GLchar const* name, glm::mat4 const& val) 
 {
-    GLint loc = glGetUniformLocation(pgm_handle, name);
+    GLint loc = GetUniformLocation(name);
     if (loc >= 0) 
     {
         glUniformMatrix4fv(loc, 1, GL_FALSE, &val[0][0]);
@@ -31,6 +31,8 @@ Program to draw certain meshes or data from VBO.
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <string_view>
 
 /*  _________________________________________________________________________ */
 class GLSLShader
@@ -412,6 +414,17 @@ return
     void PrintActiveAttribs() const;
 
 /*!*****************************************************************************
+\brief
+    GetUniformLocation() is a getter function that returns the location of the
+    uniform variable, looked up in the table built when the program linked
+\param name
+    name of the variable
+\return
+    intger value of the location of the variable in buffer
+    - -1 if the program has no active uniform of that name
+*******************************************************************************/
+    GLint GetUniformLocation(GLchar const* name) const;
+/*!*****************************************************************************
 \brief
     PrintActiveUniforms prints the active uniform variables
 *******************************************************************************/
@@ -433,19 +446,22 @@ private:
     GLboolean is_linked = GL_FALSE; // has the program successfully linked?
     std::string log_string; // log for OpenGL compiler and linker messages
 
+    // lets the table be searched with a string_view, no std::string per lookup
+    struct UniformNameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+    std::unordered_map<std::string, GLint, UniformNameHash, std::equal_to<>> uniform_locations;
+
 private:
 /*!*****************************************************************************
 \brief
-    GetUniformLocation() is a getter function that returns the location of the
-    uniform variable
-\param name
-    name of the variable
-\return
-    intger value of the location of the variable in buffer
-    - GL_INVALID_VALUE if the program is not a value generated by opengl
-    - GL_INVALID_OPERATION if the program is not valid or not successfully linked.
+    ReflectUniforms() reads every active uniform of the linked program once
+    with glGetActiveUniform and stores its location in uniform_locations.
+    Arrays are stored under "name", "name[0]" and every "name[i]". Uniforms
+    inside uniform blocks have no location and are skipped.
 *******************************************************************************/
-    GLint GetUniformLocation(GLchar const* name);
+    void ReflectUniforms();
 
 /*!*****************************************************************************
 \brief
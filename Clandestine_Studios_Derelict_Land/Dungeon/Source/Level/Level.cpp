@@ -19,6 +19,7 @@
 #include "Logic/Logic.h"
 #include "GameUI/GameUI.h"
 #include "Renderer/Renderer.h"
+#include "Graphics/BatchRendering.h"
 
 
 /**************************************************************************/
@@ -33,6 +34,8 @@
 
 void Level::AddGOsPtrsToRespectiveLayers(GameObject* GO)
 {
+	// The static batches are indexed by object and may need to bake it
+	Batch::InvalidateStatic();
 
 	//std::cout << "BEFORE:" << std::endl;
 	//PrintLayerSizes();
@@ -93,6 +96,8 @@ void Level::RemoveGOsPtrsFromSpecificLayers(GameObject* item, ComponentType  com
 	std::cout << "======================" << std::endl;
 	*/
 	std::vector<GameObject*>::iterator it;
+	// Removing the object or one of its components changes what is baked
+	Batch::InvalidateStatic();
 
 	switch (comp_type)
 	{
@@ -176,6 +181,8 @@ void Level::RemoveGOsPtrsFromSpecificLayers(GameObject* item, ComponentType  com
 /**************************************************************************/
 void Level::AddGOsPtrToSpecificLayer(GameObject* item, ComponentType comp_type)
 {
+	// A new component can make the object static or stop it from being so
+	Batch::InvalidateStatic();
 	//std::cout << "BEFORE:" << std::endl;
 	//PrintLayerSizes();
 	//std::cout << "======================" << std::endl;
@@ -22,15 +22,28 @@ initialize an OpenGL context and implement a game loop.
 #include "Factory/Factory.h"
 #include "Scripts/AllScripts.h"
 #include "Animation/Animation.h"
+#include "Physics/PhysicsBenchmark.h"
+#include "Graphics/AtlasCooker.h"
+#include "Graphics/FlipbookCooker.h"
+#include "Graphics/TextureCooker.h"
 
 #include <filesystem>
 
 bool is_paused = false; // if game is paused
 
-int main(){
+int main(int argc, char** argv){
 #if defined(DEBUG) | defined(_DEBUG)
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 #endif
+	// Headless physics benchmark, no window or assets are loaded
+	if (argc > 1 && std::string(argv[1]) == "--physics-bench") { return PhysicsBenchmark::Run(argc, argv); }
+	// Offline texture atlas cooking, run from the Dungeon directory
+	if (argc > 1 && std::string(argv[1]) == "--cook-atlases") { return AtlasCooker::Run(argc, argv); }
+	// Offline block compression of every image, run from the Dungeon directory after --cook-atlases
+	if (argc > 1 && std::string(argv[1]) == "--cook-textures") { return TextureCooker::Run(argc, argv); }
+	// Offline frame by frame compression of the streamed flipbooks, run from the Dungeon directory
+	if (argc > 1 && std::string(argv[1]) == "--cook-flipbooks") { return FlipbookCooker::Run(argc, argv); }
+
 	SetConsoleTitle(L"Ohmega Engine"); // rename debug console
 	
 	const std::string projectDir = std::filesystem::current_path().string();
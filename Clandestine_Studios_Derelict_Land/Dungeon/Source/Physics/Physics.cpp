@@ -15,6 +15,16 @@
 		 Shut down the Physics system
 		 - Update
 		 Updates all game objects
+		 - NarrowPhase
+		 Tests one worker's share of the collider pairs
+		 - WorkerLoop
+		 Runs one pooled worker's share of every parallel step
+		 - GatherBodies
+		 Packs rigid bodies into arrays for integration
+		 - IntegrateBodies
+		 Integrates packed rigid bodies by one step
+		 - ScatterBodies
+		 Writes packed rigid bodies back to their components
 
 		Copyright (C) 2022 DigiPen Institute of Technology.
 		Reproduction or disclosure of this file or its contents without the
@@ -23,6 +33,7 @@
  /******************************************************************************/
 
 #include "Physics.h"
+#include "Editor/UI/Editor.h"
 
 /*!*************************************************************************
 ****
@@ -38,73 +49,333 @@ Physics::Physics()
 /*!*************************************************************************
 ****
 \brief
-	Initialize the Physics system
+	Initialize the Physics system. Narrow phase workers are started once
+	here and kept for every step, the main thread taking a share too.
 ****************************************************************************
 ***/
 void Physics::Init()
 {
-	// Empty
+	if (!Workers.empty()) return;
+
+	size_t workers = static_cast<size_t>(std::thread::hardware_concurrency());
+	if (workers > MAX_WORKERS) workers = MAX_WORKERS;
+	if (workers < 1) workers = 1;
+	WorkerContacts.resize(workers);
+	WorkerPairsTested.resize(workers);
+
+	WorkersStopping = false;
+	WorkStep = 0;
+	for (size_t w = 1; w < workers; ++w)
+		Workers.emplace_back(&Physics::WorkerLoop, this, w);
 }
 
 /*!*************************************************************************
 ****
 \brief
-	Shut down the Physics system
+	Shut down the Physics system. Stops and joins the narrow phase workers.
 ****************************************************************************
 ***/
 void Physics::Shutdown()
 {
-	// Empty
+	{
+		std::lock_guard<std::mutex> lock(WorkerMutex);
+		WorkersStopping = true;
+	}
+	WorkReady.notify_all();
+	for (std::thread& th : Workers) th.join();
+	Workers.clear();
 }
 
 extern int currentNumberOfSteps;
+extern bool editor_open;
+extern bool is_paused;
 const float fixedDeltaTime = 1.0f / 60.0f;
 /*!*************************************************************************
 ****
 \brief
-	Updates all game objects
+	Updates all game objects. Rigid bodies are integrated first, then
+	collisions are detected. Bounding boxes are only rebuilt for bodies
+	that moved, static-static and settled pairs are not tested, and dynamic
+	bodies at rest are put to sleep until moved or touched.
 \param[in] dt
 	delta time
 ****************************************************************************
 ***/
 void Physics::Update(float dt)
 {
+	// The editor may move any selected object, so rebuild its bounds
+	GameObject* selected = editor_open ? editor->GetPropertyEditor().GetSelectedGameObject() : nullptr;
+
+	GatherBodies();
+
 	for (int step = 0; step < currentNumberOfSteps; ++step)
 	{
-		for (int i = 1; i < this->GetLevel()->GetGOASize(); ++i)
+		// Nothing moves while the game is paused
+		if (!is_paused)
 		{
-			Collision* c = dynamic_cast<Collision*>(this->GetLevel()->GetGameObjectArray()[i]->GetComponent(ComponentType::Collision));
-			if (c != nullptr) c->go_is_colliding = false;
+			IntegrateBodies(fixedDeltaTime);
+			ScatterBodies();
 		}
 
-		for (int i = 1; i < this->GetLevel()->GetGOASize(); ++i) {
+		Bodies.clear(); BodyIDs.clear();
+		for (GameObject* go : this->GetLevel()->GetCollisionLayer())
+		{
+			if (!go->GetActive()) continue; // Skip inactive game objects
+
+			Collision* c = dynamic_cast<Collision*>(go->GetComponent(ComponentType::Collision));
+			Transform* t = dynamic_cast<Transform*>(go->GetComponent(ComponentType::Transform));
+			if (c == nullptr || t == nullptr) continue;
 
-			if (!this->GetLevel()->GetGameObjectArray()[i]->GetActive()) continue; // Skip inactive game objects
+			if (go == selected) c->MarkBoundsDirty();
+			bool moved = c->UpdateBoundingBox(t->Position, t->Scale, t->Dimensions);
 
-			if (this->GetLevel()->GetGameObjectArray()[i]->GetComponent(ComponentType::Transform) != nullptr)
+			if (c->Body == BodyType::Dynamic)
 			{
-				Transform* t = dynamic_cast<Transform*>(this->GetLevel()->GetGameObjectArray()[i]->GetComponent(ComponentType::Transform));
-				Collision* c = dynamic_cast<Collision*>(this->GetLevel()->GetGameObjectArray()[i]->GetComponent(ComponentType::Collision));
-				if (c != nullptr) c->SetBoundingBox(t->Position, t->Scale, t->Dimensions);
-				for (int j = 1; j < this->GetLevel()->GetGOASize(); ++j)
+				RigidBody* r = dynamic_cast<RigidBody*>(go->GetComponent(ComponentType::RigidBody));
+				bool at_rest = !moved && (r == nullptr || (r->Velocity.x == 0.f && r->Velocity.y == 0.f));
+				if (!at_rest) c->Wake();
+				else if (!c->isAsleep && ++c->restSteps >= Collision::STEPS_TO_SLEEP)
 				{
-					if (i == j || !this->GetLevel()->GetGameObjectArray()[j]->GetActive()) continue; // Skip inactive game objects
-
-					Collision* c1 = dynamic_cast<Collision*>(this->GetLevel()->GetGameObjectArray()[j]->GetComponent(ComponentType::Collision));
-					if (c1 != nullptr)
-					{
-						Transform* t1 = dynamic_cast<Transform*>(this->GetLevel()->GetGameObjectArray()[j]->GetComponent(ComponentType::Transform));
-						c1->SetBoundingBox(t1->Position, t1->Scale, t1->Dimensions);
-						if (c != nullptr) {
-							if (CollisionIntersection_RectRect(c->BoundingBox, c->Vel, c1->BoundingBox, c1->Vel, dt))
-							{
-								if (!c->go_is_colliding)c->go_is_colliding = true;
-								if (!c1->go_is_colliding)c1->go_is_colliding = true;
-							}
-						}
-					}
+					// Remember if it fell asleep touching something so that contact is kept
+					c->isAsleep = true;
+					c->restingContact = c->go_is_colliding;
 				}
 			}
+			else if (c->Body == BodyType::Kinematic) c->Wake();
+
+			c->go_is_colliding = false;
+			Bodies.push_back(c);
+			BodyIDs.push_back(go->GetObjectId());
+		}
+
+		// Narrow phase, handed to the pooled workers once there are enough bodies
+		size_t workers = Bodies.size() >= PARALLEL_BODY_THRESHOLD ? Workers.size() + 1 : 1;
+		if (WorkerContacts.empty()) { WorkerContacts.resize(1); WorkerPairsTested.resize(1); }
+
+		if (workers > 1)
+		{
+			{
+				std::lock_guard<std::mutex> lock(WorkerMutex);
+				WorkDt = dt;
+				WorkersBusy = workers - 1;
+				++WorkStep;
+			}
+			WorkReady.notify_all();
+		}
+		NarrowPhase(0, workers, dt); // main thread takes a share too
+		if (workers > 1)
+		{
+			std::unique_lock<std::mutex> lock(WorkerMutex);
+			WorkDone.wait(lock, [this] { return WorkersBusy == 0; });
+		}
+
+		// Merge and sort so the result does not depend on the number of workers
+		Contacts.clear();
+		for (size_t w = 0; w < workers; ++w)
+		{
+			Contacts.insert(Contacts.end(), WorkerContacts[w].begin(), WorkerContacts[w].end());
+			PairsTested += WorkerPairsTested[w];
+		}
+		std::sort(Contacts.begin(), Contacts.end(), [](const Contact& lhs, const Contact& rhs)
+			{
+				if (lhs.minID != rhs.minID) return lhs.minID < rhs.minID;
+				if (lhs.maxID != rhs.maxID) return lhs.maxID < rhs.maxID;
+				if (lhs.a != rhs.a) return lhs.a < rhs.a;
+				return lhs.b < rhs.b;
+			});
+		ContactsFound += Contacts.size();
+
+		for (const Contact& contact : Contacts)
+		{
+			Collision* c = Bodies[contact.a];
+			Collision* c1 = Bodies[contact.b];
+			if (!c->go_is_colliding)c->go_is_colliding = true;
+			if (!c1->go_is_colliding)c1->go_is_colliding = true;
+			// Wake sleepers that are hit by a moving body
+			if (c->isAsleep && !c1->IsSettled()) c->Wake();
+			if (c1->isAsleep && !c->IsSettled()) c1->Wake();
 		}
 	}
-}
\ No newline at end of file
+}
+
+/*!*************************************************************************
+****
+\brief
+	Tests one worker's share of the collider pairs. Rows of the pair
+	triangle are interleaved between workers so the work is balanced.
+	Bodies are only read here; contacts go to the worker's own buffer.
+\param[in] worker
+	Index of this worker
+\param[in] workerCount
+	Total number of workers
+\param[in] dt
+	delta time
+****************************************************************************
+***/
+void Physics::NarrowPhase(size_t worker, size_t workerCount, float dt)
+{
+	std::vector<Contact>& out = WorkerContacts[worker];
+	size_t tested = 0;
+	out.clear();
+
+	for (size_t i = worker; i < Bodies.size(); i += workerCount)
+	{
+		Collision* c = Bodies[i];
+		for (size_t j = i + 1; j < Bodies.size(); ++j)
+		{
+			Collision* c1 = Bodies[j];
+			if (c->Body == BodyType::Static && c1->Body == BodyType::Static) continue;
+			// Neither body moved; only re-test if a sleeper is holding a contact
+			if (c->IsSettled() && c1->IsSettled() &&
+				!(c->isAsleep && c->restingContact) && !(c1->isAsleep && c1->restingContact)) continue;
+
+			++tested;
+			if (CollisionIntersection_RectRect(c->BoundingBox, c->Vel, c1->BoundingBox, c1->Vel, dt))
+			{
+				int id = BodyIDs[i], id1 = BodyIDs[j];
+				out.push_back({ id < id1 ? id : id1, id < id1 ? id1 : id, i, j });
+			}
+		}
+	}
+	WorkerPairsTested[worker] = tested;
+}
+
+/*!*************************************************************************
+****
+\brief
+	Runs on a pooled worker thread. Every step handed out is split between
+	the main thread and all the pooled workers.
+\param[in] worker
+	Index of this worker, the main thread is worker 0
+****************************************************************************
+***/
+void Physics::WorkerLoop(size_t worker)
+{
+	size_t step = 0;
+	for (;;)
+	{
+		float dt;
+		{
+			std::unique_lock<std::mutex> lock(WorkerMutex);
+			WorkReady.wait(lock, [this, step] { return WorkersStopping || WorkStep != step; });
+			if (WorkersStopping) return;
+			step = WorkStep;
+			dt = WorkDt;
+		}
+
+		NarrowPhase(worker, Workers.size() + 1, dt);
+
+		bool last;
+		{
+			std::lock_guard<std::mutex> lock(WorkerMutex);
+			last = --WorkersBusy == 0;
+		}
+		if (last) WorkDone.notify_one();
+	}
+}
+
+/*!*************************************************************************
+****
+\brief
+	Packs position, velocity, force and mass of every active rigid body
+	into contiguous arrays for integration. Forces added since the last
+	integrated step act for all steps of this update.
+****************************************************************************
+***/
+void Physics::GatherBodies()
+{
+	RBOwners.clear(); RBTransforms.clear(); Steered.clear();
+	PosX.clear(); PosY.clear(); VelX.clear(); VelY.clear();
+	ForceX.clear(); ForceY.clear(); InvMass.clear(); Damping.clear(); Gravity.clear();
+
+	for (GameObject* go : this->GetLevel()->GetRigidBodyLayer())
+	{
+		if (!go->GetActive()) continue; // Skip inactive game objects
+
+		RigidBody* r = dynamic_cast<RigidBody*>(go->GetComponent(ComponentType::RigidBody));
+		Transform* t = dynamic_cast<Transform*>(go->GetComponent(ComponentType::Transform));
+		if (r == nullptr || t == nullptr) continue;
+
+		if (r->Steering) Steered.push_back(RBOwners.size());
+		RBOwners.push_back(r);
+		RBTransforms.push_back(t);
+		PosX.push_back(t->Position.x);
+		PosY.push_back(t->Position.y);
+		VelX.push_back(r->Velocity.x);
+		VelY.push_back(r->Velocity.y);
+		ForceX.push_back(r->AccumulatedForce.x);
+		ForceY.push_back(r->AccumulatedForce.y);
+		InvMass.push_back(r->InverseMass);
+		Damping.push_back(r->Damping);
+		Gravity.push_back(r->GravityScale);
+	}
+}
+
+/*!*************************************************************************
+****
+\brief
+	Integrates packed rigid bodies by one step using semi-implicit Euler.
+	Steered bodies have their velocity pointed at their destination first.
+\param[in] dt
+	fixed delta time
+****************************************************************************
+***/
+void Physics::IntegrateBodies(float dt)
+{
+	// Steering, only for the few bodies with a destination
+	for (size_t k = 0; k < Steered.size(); ++k)
+	{
+		size_t i = Steered[k];
+		RigidBody* r = RBOwners[i];
+		if (!r->Steering) continue;
+
+		float dx = r->Destination.x - PosX[i], dy = r->Destination.y - PosY[i];
+		float dist = sqrtf(dx * dx + dy * dy);
+		float speed = r->Force * InvMass[i] * dt; // same speed as the old per frame MoveTo
+		if (dist <= speed * dt || dist == 0.f)
+		{
+			// Arrived, snap to the destination and stop
+			PosX[i] = r->Destination.x; PosY[i] = r->Destination.y;
+			VelX[i] = VelY[i] = 0.f;
+			r->Steering = false;
+			continue;
+		}
+		VelX[i] = dx / dist * speed;
+		VelY[i] = dy / dist * speed;
+	}
+
+	// Branch free pass over packed arrays so it can be vectorised
+	const size_t count = PosX.size();
+	float* px = PosX.data(); float* py = PosY.data();
+	float* vx = VelX.data(); float* vy = VelY.data();
+	float* fx = ForceX.data(); float* fy = ForceY.data();
+	const float* im = InvMass.data(); const float* damp = Damping.data(); const float* grav = Gravity.data();
+	for (size_t i = 0; i < count; ++i)
+	{
+		float drag = 1.f / (1.f + damp[i] * dt);
+		vx[i] = (vx[i] + fx[i] * im[i] * dt) * drag;
+		vy[i] = (vy[i] + (fy[i] * im[i] - GRAVITY * grav[i]) * dt) * drag;
+		px[i] += vx[i] * dt;
+		py[i] += vy[i] * dt;
+	}
+}
+
+/*!*************************************************************************
+****
+\brief
+	Writes packed positions and velocities back to the components. Forces
+	were integrated, so the accumulators are cleared; frames with no step
+	or paused keep them for the next step.
+****************************************************************************
+***/
+void Physics::ScatterBodies()
+{
+	for (size_t i = 0; i < RBOwners.size(); ++i)
+	{
+		RBTransforms[i]->Position.x = PosX[i];
+		RBTransforms[i]->Position.y = PosY[i];
+		RBOwners[i]->Velocity.x = VelX[i];
+		RBOwners[i]->Velocity.y = VelY[i];
+		RBOwners[i]->AccumulatedForce = { 0.0f, 0.0f };
+	}
+}
@@ -15,6 +15,16 @@
 		 Shut down the Physics system
 		 - Update
 		 Updates all game objects
+		 - NarrowPhase
+		 Tests one worker's share of the collider pairs
+		 - WorkerLoop
+		 Runs one pooled worker's share of every parallel step
+		 - GatherBodies
+		 Packs rigid bodies into arrays for integration
+		 - IntegrateBodies
+		 Integrates packed rigid bodies by one step
+		 - ScatterBodies
+		 Writes packed rigid bodies back to their components
 
 		Copyright (C) 2022 DigiPen Institute of Technology.
 		Reproduction or disclosure of this file or its contents without the
@@ -31,6 +41,9 @@
 #include "Collision/Collision.h"
 
 #include "Input/MouseCodes.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 class Collision;
 
@@ -47,14 +60,14 @@ public:
 	/*!*************************************************************************
 	****
 	\brief
-		Initialize the Physics system
+		Initialize the Physics system, starting the narrow phase workers
 	****************************************************************************
 	***/
 	virtual void Init();
 	/*!*************************************************************************
 	****
 	\brief
-		Shut down the Physics system
+		Shut down the Physics system, stopping the narrow phase workers
 	****************************************************************************
 	***/
 	virtual void Shutdown();
@@ -69,4 +82,94 @@ public:
 	virtual void Update(float dt);
 
 	constexpr static float GRAVITY = 9.81f;
+	constexpr static size_t PARALLEL_BODY_THRESHOLD = 256; // fewer colliders than this stay on the main thread
+	constexpr static size_t MAX_WORKERS = 8;
+
+	// Running totals, for profiling
+	size_t PairsTested{ 0 }, ContactsFound{ 0 };
+private:
+	/*!*************************************************************************
+	****
+	\brief
+		A pair of overlapping colliders. IDs are the owners' object IDs and
+		a, b are indices into Bodies.
+	****************************************************************************
+	***/
+	struct Contact {
+		int minID, maxID;
+		size_t a, b;
+	};
+
+	/*!*************************************************************************
+	****
+	\brief
+		Tests one worker's share of the collider pairs, writing contacts to
+		the worker's own buffer.
+	\param[in] worker
+		Index of this worker
+	\param[in] workerCount
+		Total number of workers
+	\param[in] dt
+		delta time
+	****************************************************************************
+	***/
+	void NarrowPhase(size_t worker, size_t workerCount, float dt);
+	/*!*************************************************************************
+	****
+	\brief
+		Runs on a pooled worker thread. Waits for a step to be handed out,
+		tests its share of the pairs and reports back, until shut down.
+	\param[in] worker
+		Index of this worker, the main thread is worker 0
+	****************************************************************************
+	***/
+	void WorkerLoop(size_t worker);
+
+	/*!*************************************************************************
+	****
+	\brief
+		Packs position, velocity, force and mass of every active rigid body
+		into contiguous arrays for integration.
+	****************************************************************************
+	***/
+	void GatherBodies();
+	/*!*************************************************************************
+	****
+	\brief
+		Integrates packed rigid bodies by one step using semi-implicit Euler.
+	\param[in] dt
+		fixed delta time
+	****************************************************************************
+	***/
+	void IntegrateBodies(float dt);
+	/*!*************************************************************************
+	****
+	\brief
+		Writes packed positions and velocities back to the components and
+		clears the forces that were integrated.
+	****************************************************************************
+	***/
+	void ScatterBodies();
+
+	std::vector<Collision*> Bodies; // active colliders gathered each step
+	std::vector<int> BodyIDs;
+	std::vector<std::vector<Contact>> WorkerContacts;
+	std::vector<size_t> WorkerPairsTested;
+	std::vector<Contact> Contacts;
+
+	// Narrow phase workers, started in Init. The main thread is worker 0.
+	std::vector<std::thread> Workers;
+	std::mutex WorkerMutex;
+	std::condition_variable WorkReady;	// a step was handed out, or Shutdown was called
+	std::condition_variable WorkDone;	// every worker finished its share
+	size_t WorkStep{ 0 };				// bumped for every step handed out
+	size_t WorkersBusy{ 0 };
+	float WorkDt{ 0.f };
+	bool WorkersStopping{ false };
+
+	// Rigid bodies packed as structure of arrays, one entry per body
+	std::vector<RigidBody*> RBOwners;
+	std::vector<Transform*> RBTransforms;
+	std::vector<float> PosX, PosY, VelX, VelY, ForceX, ForceY, InvMass, Damping, Gravity;
+	std::vector<size_t> Steered; // indices of bodies moving to a destination
 };
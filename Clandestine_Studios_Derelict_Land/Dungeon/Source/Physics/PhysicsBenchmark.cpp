@@ -0,0 +1,289 @@
+/******************************************************************************/
+/*!
+\file    PhysicsBenchmark.cpp
+\author  Lim Hui Ching, l.huiching, 620004221
+\par     email: l.huiching\@digipen.edu
+\date    March 20, 2023
+\brief   Function definitions for the headless physics benchmark. Synthetic
+		 levels are built through the Factory and Level, and Physics::Update
+		 is stepped without a window. Run the game with --physics-bench.
+		 The functions include:
+		 - ParseArguments
+		 Reads benchmark settings from the command line.
+		 - BuildLevel
+		 Builds a synthetic level of colliders.
+		 - RunScene
+		 Steps physics on one synthetic level and measures it.
+		 - WriteResults
+		 Writes benchmark results to a JSON file.
+		 - Run
+		 Runs the whole benchmark.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "PhysicsBenchmark.h"
+#include "Physics/Physics.h"
+#include "Factory/Factory.h"
+#include "CoreSys/CommandLine.h"
+#include <random>
+#include <Windows.h>
+#include <Psapi.h>
+#pragma comment(lib, "psapi.lib")
+
+extern int currentNumberOfSteps;
+
+namespace
+{
+	const float BENCH_DT = 1.0f / 60.0f;
+	const float COLLIDER_SIZE = 50.f;
+
+	/*!*************************************************************************
+	****
+	\brief
+		Gets the working set of the process.
+	\return
+		Bytes in use by the process.
+	****************************************************************************
+	***/
+	size_t WorkingSetBytes()
+	{
+		PROCESS_MEMORY_COUNTERS counters{};
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+		return static_cast<size_t>(counters.WorkingSetSize);
+	}
+}
+
+/*!*************************************************************************
+****
+\brief
+	Reads benchmark settings from the command line.
+\param[in] argc
+	Number of arguments.
+\param[in] argv
+	Arguments.
+\param[out] settings
+	Settings to fill in.
+\return
+	True if all arguments were valid.
+****************************************************************************
+***/
+bool PhysicsBenchmark::ParseArguments(int argc, char** argv, Settings& settings)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--physics-bench") continue;
+		std::string value;
+		if (!CommandLine::NextArgument(argc, argv, i, value)) return false;
+
+		if (arg == "--colliders")
+		{
+			settings.ColliderCounts.clear();
+			std::stringstream ss(value);
+			std::string count;
+			while (std::getline(ss, count, ','))
+			{
+				int n = std::atoi(count.c_str());
+				if (n <= 0) { std::cout << "Invalid collider count " << count << "\n"; return false; }
+				settings.ColliderCounts.push_back(n);
+			}
+		}
+		else if (arg == "--steps") settings.Steps = std::atoi(value.c_str());
+		else if (arg == "--density") settings.Density = static_cast<float>(std::atof(value.c_str()));
+		else if (arg == "--velocity") settings.VelocitySpread = static_cast<float>(std::atof(value.c_str()));
+		else if (arg == "--static-ratio") settings.StaticRatio = static_cast<float>(std::atof(value.c_str()));
+		else if (arg == "--seed") settings.Seed = static_cast<unsigned>(std::atoi(value.c_str()));
+		else if (arg == "--out") settings.Output = value;
+		else { std::cout << "Unknown argument " << arg << "\n"; return false; }
+	}
+
+	if (settings.Steps <= 0 || settings.Density <= 0.f || settings.StaticRatio < 0.f || settings.StaticRatio > 1.f
+		|| settings.ColliderCounts.empty())
+	{
+		std::cout << "Invalid benchmark settings\n";
+		return false;
+	}
+	return true;
+}
+
+/*!*************************************************************************
+****
+\brief
+	Builds a synthetic level of colliders through the Factory. Colliders are
+	spread over a square sized so that there are Density colliders per
+	1000x1000 area. Dynamic colliders get a random velocity.
+\param[in] settings
+	Benchmark settings.
+\param[in] colliders
+	Number of colliders.
+\return
+	Pointer to the new level.
+****************************************************************************
+***/
+Level* PhysicsBenchmark::BuildLevel(const Settings& settings, int colliders)
+{
+	Level* level = new Level("PhysicsBenchmark");
+	std::mt19937 rng(settings.Seed);
+
+	float side = sqrtf(static_cast<float>(colliders) / settings.Density) * 1000.f;
+	std::uniform_real_distribution<float> position(-side * 0.5f, side * 0.5f);
+	std::uniform_real_distribution<float> velocity(-settings.VelocitySpread, settings.VelocitySpread);
+	std::uniform_real_distribution<float> chance(0.f, 1.f);
+
+	// Every collider is a clone of this one
+	GameObject* prototype = new GameObject;
+	prototype->SetName("BenchCollider");
+	Transform* pt = new Transform;
+	pt->Dimensions = { COLLIDER_SIZE, COLLIDER_SIZE };
+	prototype->AddComponent(ComponentType::Transform, pt);
+	prototype->AddComponent(ComponentType::Collision, new Collision);
+	prototype->AddComponent(ComponentType::RigidBody, new RigidBody);
+
+	for (int i = 0; i < colliders; ++i)
+	{
+		GameObject* go = factory->Clone(prototype);
+		Transform* t = go->GetComponent<Transform>();
+		Collision* c = go->GetComponent<Collision>();
+		RigidBody* r = go->GetComponent<RigidBody>();
+
+		t->Position = { position(rng), position(rng) };
+		if (chance(rng) < settings.StaticRatio)
+		{
+			c->Body = BodyType::Static;
+		}
+		else
+		{
+			c->Body = BodyType::Dynamic;
+			r->SetVelocity({ velocity(rng), velocity(rng) });
+		}
+		level->AddGameObject(go);
+	}
+
+	factory->Destroy(prototype);
+	return level;
+}
+
+/*!*************************************************************************
+****
+\brief
+	Steps physics on one synthetic level and measures it.
+\param[in] settings
+	Benchmark settings.
+\param[in] colliders
+	Number of colliders.
+\return
+	Measurements for the level.
+****************************************************************************
+***/
+PhysicsBenchmark::Result PhysicsBenchmark::RunScene(const Settings& settings, int colliders)
+{
+	Result result;
+	result.Colliders = colliders;
+	result.Steps = settings.Steps;
+
+	size_t memory_before = WorkingSetBytes();
+	Level* level = BuildLevel(settings, colliders);
+
+	Physics physics;
+	physics.SetLevel(level);
+	physics.Init();
+	physics.PairsTested = physics.ContactsFound = 0;
+
+	// One fixed step per update, as if the game ran at exactly 60 fps
+	currentNumberOfSteps = 1;
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	for (int step = 0; step < settings.Steps; ++step)
+	{
+		physics.Update(BENCH_DT);
+	}
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+	result.Seconds = std::chrono::duration<double>(end - start).count();
+	result.StepsPerSecond = result.Seconds > 0.0 ? settings.Steps / result.Seconds : 0.0;
+	result.PairsTested = physics.PairsTested;
+	result.ContactsFound = physics.ContactsFound;
+	size_t memory_after = WorkingSetBytes();
+	result.MemoryBytes = memory_after > memory_before ? memory_after - memory_before : 0;
+
+	physics.Shutdown();
+	for (GameObject*& go : level->GetGameObjectArray()) { factory->Destroy(go); }
+	delete level;
+	currentNumberOfSteps = 0;
+	return result;
+}
+
+/*!*************************************************************************
+****
+\brief
+	Writes benchmark results to a JSON file.
+\param[in] settings
+	Benchmark settings.
+\param[in] results
+	Measurements for every level.
+\return
+	True if file was written.
+****************************************************************************
+***/
+bool PhysicsBenchmark::WriteResults(const Settings& settings, const std::vector<Result>& results)
+{
+	FILE* fp = fopen(settings.Output.c_str(), "w");
+	if (!fp) { std::cout << "Could not open " << settings.Output << "\n"; return false; }
+
+	fprintf(fp, "{\n");
+	fprintf(fp, "  \"steps\": %d,\n", settings.Steps);
+	fprintf(fp, "  \"density\": %f,\n", settings.Density);
+	fprintf(fp, "  \"velocity_spread\": %f,\n", settings.VelocitySpread);
+	fprintf(fp, "  \"static_ratio\": %f,\n", settings.StaticRatio);
+	fprintf(fp, "  \"seed\": %u,\n", settings.Seed);
+	fprintf(fp, "  \"results\": [\n");
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const Result& r = results[i];
+		fprintf(fp, "    { \"colliders\": %d, \"steps\": %d, \"seconds\": %f, \"steps_per_second\": %f, "
+			"\"pairs_tested\": %zu, \"contacts_found\": %zu, \"memory_bytes\": %zu }%s\n",
+			r.Colliders, r.Steps, r.Seconds, r.StepsPerSecond, r.PairsTested, r.ContactsFound, r.MemoryBytes,
+			i + 1 < results.size() ? "," : "");
+	}
+	fprintf(fp, "  ]\n");
+	fprintf(fp, "}\n");
+	fclose(fp);
+	return true;
+}
+
+/*!*************************************************************************
+****
+\brief
+	Runs the whole benchmark. Each collider count gets its own level.
+\param[in] argc
+	Number of arguments.
+\param[in] argv
+	Arguments.
+\return
+	0 on success.
+****************************************************************************
+***/
+int PhysicsBenchmark::Run(int argc, char** argv)
+{
+	Settings settings;
+	if (!ParseArguments(argc, argv, settings))
+	{
+		std::cout << "Usage: --physics-bench [--colliders 100,1000,10000] [--steps 300] [--density 50] "
+			"[--velocity 200] [--static-ratio 0.5] [--seed 1] [--out ./PhysicsBenchmark.json]\n";
+		return 1;
+	}
+
+	std::vector<Result> results;
+	for (int colliders : settings.ColliderCounts)
+	{
+		Result r = RunScene(settings, colliders);
+		std::cout << "[PhysicsBenchmark] " << r.Colliders << " colliders: " << r.StepsPerSecond << " steps/s, "
+			<< r.PairsTested << " pairs, " << r.ContactsFound << " contacts, " << r.MemoryBytes << " bytes\n";
+		results.push_back(r);
+	}
+
+	return WriteResults(settings, results) ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/******************************************************************************/
+/*!
+\file    PhysicsBenchmark.h
+\author  Lim Hui Ching, l.huiching, 620004221
+\par     email: l.huiching\@digipen.edu
+\date    March 20, 2023
+\brief   Function declarations for the headless physics benchmark. Synthetic
+		 levels are built through the Factory and Level, and Physics::Update
+		 is stepped without a window. Run the game with --physics-bench.
+		 The functions include:
+		 - ParseArguments
+		 Reads benchmark settings from the command line.
+		 - BuildLevel
+		 Builds a synthetic level of colliders.
+		 - RunScene
+		 Steps physics on one synthetic level and measures it.
+		 - WriteResults
+		 Writes benchmark results to a JSON file.
+		 - Run
+		 Runs the whole benchmark.
+
+		Copyright (C) 2023 DigiPen Institute of Technology.
+		Reproduction or disclosure of this file or its contents without the
+		prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#pragma once
+#include "Essential.h"
+#include "Level/Level.h"
+
+namespace PhysicsBenchmark
+{
+	/*!*************************************************************************
+	****
+	\brief
+		Benchmark settings, all can be changed from the command line.
+	****************************************************************************
+	***/
+	struct Settings {
+		std::vector<int> ColliderCounts{ 100, 1000, 10000 };	// --colliders 100,1000,100000
+		int Steps{ 300 };										// --steps
+		float Density{ 50.f };									// --density, colliders per 1000x1000 area
+		float VelocitySpread{ 200.f };							// --velocity, max speed of dynamic bodies
+		float StaticRatio{ 0.5f };								// --static-ratio, 0 to 1
+		unsigned Seed{ 1 };										// --seed
+		std::string Output{ "./PhysicsBenchmark.json" };		// --out
+	};
+
+	/*!*************************************************************************
+	****
+	\brief
+		Measurements for one synthetic level.
+	****************************************************************************
+	***/
+	struct Result {
+		int Colliders{ 0 };
+		int Steps{ 0 };
+		double Seconds{ 0.0 };
+		double StepsPerSecond{ 0.0 };
+		size_t PairsTested{ 0 };
+		size_t ContactsFound{ 0 };
+		size_t MemoryBytes{ 0 };
+	};
+
+	/*!*************************************************************************
+	****
+	\brief
+		Reads benchmark settings from the command line.
+	\param[in] argc
+		Number of arguments.
+	\param[in] argv
+		Arguments.
+	\param[out] settings
+		Settings to fill in.
+	\return
+		True if all arguments were valid.
+	****************************************************************************
+	***/
+	bool ParseArguments(int argc, char** argv, Settings& settings);
+
+	/*!*************************************************************************
+	****
+	\brief
+		Builds a synthetic level of colliders through the Factory.
+	\param[in] settings
+		Benchmark settings.
+	\param[in] colliders
+		Number of colliders.
+	\return
+		Pointer to the new level.
+	****************************************************************************
+	***/
+	Level* BuildLevel(const Settings& settings, int colliders);
+
+	/*!*************************************************************************
+	****
+	\brief
+		Steps physics on one synthetic level and measures it.
+	\param[in] settings
+		Benchmark settings.
+	\param[in] colliders
+		Number of colliders.
+	\return
+		Measurements for the level.
+	****************************************************************************
+	***/
+	Result RunScene(const Settings& settings, int colliders);
+
+	/*!*************************************************************************
+	****
+	\brief
+		Writes benchmark results to a JSON file.
+	\param[in] settings
+		Benchmark settings.
+	\param[in] results
+		Measurements for every level.
+	\return
+		True if file was written.
+	****************************************************************************
+	***/
+	bool WriteResults(const Settings& settings, const std::vector<Result>& results);
+
+	/*!*************************************************************************
+	****
+	\brief
+		Runs the whole benchmark.
+	\param[in] argc
+		Number of arguments.
+	\param[in] argv
+		Arguments.
+	\return
+		0 on success.
+	****************************************************************************
+	***/
+	int Run(int argc, char** argv);
+}
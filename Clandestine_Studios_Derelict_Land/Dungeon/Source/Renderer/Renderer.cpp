@@ -12,6 +12,7 @@
  */
  /******************************************************************************/
 #include "Renderer/Renderer.h"
+#include "Graphics/BatchRendering.h"
 
 /**************************************************************************/
 	/*!
@@ -28,7 +29,8 @@ Renderer::Renderer() :
 	Tex_UV_Min_COORD(0.f, 0.f),
 	Tex_UV_Max_COORD(1.f, 1.f),
 	RGB_0to1(0.f, 0.f, 0.f),
-	Alpha_0to1(1.f)
+	Alpha_0to1(1.f),
+	isDynamic(false)
 {
 	SetType(ComponentType::Renderer);
 }
@@ -215,6 +217,8 @@ bool Renderer::GetVisibility()
 /**************************************************************************/
 void Renderer::SetVisibility(bool vis_param)
 {
+	// Only visible objects are baked, so showing or hiding one changes the static batches
+	if (this->isVisible != vis_param) { Batch::InvalidateStatic(); }
 	this->isVisible = vis_param;
 }
 /**************************************************************************/
@@ -28,6 +28,7 @@ public:
 	Vec2 Tex_UV_Max_COORD;
 	Vec3 RGB_0to1;
 	float Alpha_0to1;
+	bool isDynamic;	// set once a script changes a baked object, which keeps it out of the static batches
 
 	/**************************************************************************/
 		/*!
@@ -11,8 +11,14 @@
 		 Default constructor.
 		 - Move
 		 Moves game object.
-		 - Accelerate
-		 Accelerates game object.
+		 - AddForce
+		 Accumulates a force to be integrated on the next physics step.
+		 - SetDestination
+		 Steers game object to a location during physics integration.
+		 - ClearDestination
+		 Stops steering game object.
+		 - HasDestination
+		 Checks if game object is being steered.
 		 - operator=
 		 Assignment operator overload.
 		 - CopyData
@@ -41,7 +47,8 @@
 	Default constructor.
 ****************************************************************************
 ***/
-RigidBody::RigidBody() :Velocity(0.0f, 0.0f), Solid(false), Acceleration(0.0f, 0.0f), Force(0.0f), InverseMass(0.0f) {
+RigidBody::RigidBody() :Velocity(0.0f, 0.0f), Solid(false), Acceleration(0.0f, 0.0f), Force(0.0f), InverseMass(0.0f),
+	AccumulatedForce(0.0f, 0.0f), Damping(0.0f), GravityScale(0.0f), Destination(0.0f, 0.0f), Steering(false) {
 	SetType(ComponentType::RigidBody);
 }
 
@@ -60,33 +67,53 @@ void RigidBody::Move(Vec2& Position, const float fixedDeltaTime) {
 	Position.y += Velocity.y * fixedDeltaTime;
 }
 
+/*!*************************************************************************
+****
+\brief
+	Accumulates a force to be integrated on the next physics step.
+\param[in] ForceVector
+	Force to add.
+****************************************************************************
+***/
+void RigidBody::AddForce(Vec2 ForceVector) {
+	AccumulatedForce += ForceVector;
+}
 
-
-void RigidBody::MoveTo(Vec2& source_pos, Vec2 dest_pos, const float fixeddt)
-{
-	Vec2 NDV;
-	Vec2 DV = BuildDistanceVector(source_pos, dest_pos);
-	Vec2Normalize(NDV, DV);
-	Accelerate(NDV, fixeddt);
-	source_pos.x += Velocity.x * fixeddt;
-	source_pos.y += Velocity.y * fixeddt;
+/*!*************************************************************************
+****
+\brief
+	Steers game object to a location during physics integration. Only
+	needs to be called once; velocity is cleared on arrival.
+\param[in] dest_pos
+	Target location
+****************************************************************************
+***/
+void RigidBody::SetDestination(Vec2 dest_pos) {
+	Destination = dest_pos;
+	Steering = true;
 }
 
 /*!*************************************************************************
 ****
 \brief
-	Accelerates game object.
-\param[in] UnitDirectionVector
-	Normalized distance vector.
-\param[in] fixedDeltaTime
-	User-defined fixed delta time. (1/60)
+	Stops steering game object and clears its velocity.
 ****************************************************************************
 ***/
-void RigidBody::Accelerate(Vec2 UnitDirectionVector, const float fixedDeltaTime) {
+void RigidBody::ClearDestination() {
+	Steering = false;
 	Velocity = { 0.0f,0.0f };
-	Vec2 ForceVector = UnitDirectionVector * Force;
-	Acceleration = ForceVector * InverseMass;
-	Velocity = Acceleration * fixedDeltaTime + Velocity;
+}
+
+/*!*************************************************************************
+****
+\brief
+	Checks if game object is being steered.
+\return
+	True if game object has not arrived at its destination.
+****************************************************************************
+***/
+bool RigidBody::HasDestination() const {
+	return Steering;
 }
 
 /*!*************************************************************************
@@ -103,6 +130,8 @@ RigidBody& RigidBody::operator=(RigidBody& rhs) {
 	this->Velocity = rhs.Velocity;
 	this->InverseMass = rhs.InverseMass;
 	this->Acceleration = rhs.Acceleration;
+	this->Damping = rhs.Damping;
+	this->GravityScale = rhs.GravityScale;
 	return *this;
 }
 
@@ -122,6 +151,8 @@ void RigidBody::CopyData(Component* Target) {
 		this->Velocity = t->Velocity;
 		this->InverseMass = t->InverseMass;
 		this->Acceleration = t->Acceleration;
+		this->Damping = t->Damping;
+		this->GravityScale = t->GravityScale;
 	}
 }
 
@@ -188,6 +219,8 @@ void RigidBody::Serialize(FILE* fp)
 	fprintf(fp, "Solid: %d\n", Solid);
 	fprintf(fp, "Inverse Mass: %f\n", InverseMass);
 	fprintf(fp, "Force: %f\n", Force);
+	fprintf(fp, "Damping: %f\n", Damping);
+	fprintf(fp, "Gravity Scale: %f\n", GravityScale);
 }
 
 /*!*************************************************************************
@@ -213,4 +246,7 @@ void RigidBody::Deserialize(FILE* fp)
 		return;
 	}
 	SetRigidBody(State, F, IM);
+	// Optional, older scenes have no damping or gravity
+	(void)fscanf(fp, "Damping: %f\n", &Damping);
+	(void)fscanf(fp, "Gravity Scale: %f\n", &GravityScale);
 }
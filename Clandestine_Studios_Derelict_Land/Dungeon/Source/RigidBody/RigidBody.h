@@ -11,8 +11,14 @@
 		 Default constructor.
 		 - Move
 		 Moves game object.
-		 - Accelerate
-		 Accelerates game object.
+		 - AddForce
+		 Accumulates a force to be integrated on the next physics step.
+		 - SetDestination
+		 Steers game object to a location during physics integration.
+		 - ClearDestination
+		 Stops steering game object.
+		 - HasDestination
+		 Checks if game object is being steered.
 		 - operator=
 		 Assignment operator overload.
 		 - CopyData
@@ -43,6 +49,10 @@ public:
 	bool Solid;
 	float InverseMass, Force;
 	Vec2 Velocity, Acceleration;
+	Vec2 AccumulatedForce;		// cleared once a physics step has integrated it
+	float Damping, GravityScale;
+	Vec2 Destination;
+	bool Steering;				// moving to Destination at Force * InverseMass * fixed dt
 	/*!*************************************************************************
 	****
 	\brief
@@ -61,31 +71,41 @@ public:
 	****************************************************************************
 	***/
 	void Move(Vec2& Position, const float fixedDeltaTime);
-
 	/*!*************************************************************************
 	****
 	\brief
-		Moves game object to specified location
-	\param[in] source_pos
-		Object's transform's position
+		Accumulates a force to be integrated on the next physics step.
+	\param[in] ForceVector
+		Force to add.
+	****************************************************************************
+	***/
+	void AddForce(Vec2 ForceVector);
+	/*!*************************************************************************
+	****
+	\brief
+		Steers game object to a location during physics integration. Only
+		needs to be called once; velocity is cleared on arrival.
 	\param[in] dest_pos
 		Target location
-	\param[in] fixeddt
-		delta time
 	****************************************************************************
 	***/
-	void MoveTo(Vec2& source_pos, Vec2 dest_pos, const float fixeddt);
+	void SetDestination(Vec2 dest_pos);
 	/*!*************************************************************************
 	****
 	\brief
-		Accelerates game object.
-	\param[in] TransformPtr
-		Transform pointer that provides position
-	\param[in] dt
-		delta time
+		Stops steering game object and clears its velocity.
+	****************************************************************************
+	***/
+	void ClearDestination();
+	/*!*************************************************************************
+	****
+	\brief
+		Checks if game object is being steered.
+	\return
+		True if game object has not arrived at its destination.
 	****************************************************************************
 	***/
-	void Accelerate(Vec2 UnitDirectionVector, const float fixedDeltaTime);
+	bool HasDestination() const;
 
 	/*!*************************************************************************
 	****
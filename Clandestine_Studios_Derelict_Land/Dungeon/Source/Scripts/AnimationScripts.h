@@ -17,6 +17,7 @@
 namespace PlayerAnimation{
 #define Speed 1350.f
 	bool sfx = false, btns = false, playonce = false, fadetrigger = false;
+	bool attackdone = false;	// Yu_Attack reached its last frame, held until Yu is back in place
 float prevPos{};
 int teamlogoCounter{}, gamelogoCounter{};
 /**************************************************************************/
@@ -30,7 +31,7 @@ int teamlogoCounter{}, gamelogoCounter{};
 /**************************************************************************/
 	bool PlayAnimation(Animate* animation) {		
 
-		if (MasterObjectList->MasterAssets.GetSprite(animation->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(animation->GetTexHandle()).frames_per_row - 1) {
+		if (animation->CheckLastFrame()) {
 			animation->SetVisibility(false);
 			animation->SetIsPlaying(false);
 			return false;
@@ -53,10 +54,10 @@ int teamlogoCounter{}, gamelogoCounter{};
 */
 /**************************************************************************/
 	void CheckStopAnimation(Animate* animation) {
-		if (MasterObjectList->MasterAssets.GetSprite(animation->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(animation->GetTexHandle()).frames_per_row - 1) {
+		if (animation->CheckLastFrame()) {
 			animation->SetVisibility(false);
 			animation->SetIsPlaying(false);
-			MasterObjectList->MasterAssets.GetSprite(animation->GetTexHandle()).idx = 0;
+			animation->Restart();
 		}
 	}
 /**************************************************************************/
@@ -97,8 +98,7 @@ int teamlogoCounter{}, gamelogoCounter{};
 		Animate* BlockVFX = dynamic_cast<Animate*>(Engine->GetGameObject("BlockVFX")->GetComponent(ComponentType::Animate));
 		Animate* BlockEffect = dynamic_cast<Animate*>(Engine->GetGameObject("BlockEffect")->GetComponent(ComponentType::Animate));
 
-		if (MasterObjectList->MasterAssets.GetSprite(ecb->Name + "_Damage").idx == MasterObjectList->MasterAssets.GetSprite(ecb->Name + "_Damage").frames_per_row - 1
-			|| MasterObjectList->MasterAssets.GetSprite(ecb->Name + "_Block").idx == MasterObjectList->MasterAssets.GetSprite(ecb->Name + "_Block").frames_per_row - 1)
+		if ((ea->GetTexHandle() == ecb->Name + "_Damage" || ea->GetTexHandle() == ecb->Name + "_Block") && ea->CheckLastFrame())
 			ea->SetTexHandle(ecb->Name + "_Idle");
 
 		CheckStopAnimation(VFXa);
@@ -106,33 +106,29 @@ int teamlogoCounter{}, gamelogoCounter{};
 		CheckStopAnimation(BlockEffect);
 
 		
-		if (MasterObjectList->MasterAssets.GetSprite("Yu_Attack").idx == MasterObjectList->MasterAssets.GetSprite("Yu_Attack").frames_per_row - 1) {
+		attackdone = attackdone || (pa->GetTexHandle() == "Yu_Attack" && pa->CheckLastFrame());
+		if (attackdone) {
 			if (pa->GetTexHandle() != "Yu_Run")
 				pa->SetTexHandle("Yu_Run");			
 
-			Vec2 DV, NDV;
+			Vec2 DV;
 			DV = pr->BuildDistanceVector(pt->Position, { prevPos - 200.f, pt->Position.y });
-			Vec2Normalize(NDV, DV);
-			pr->Accelerate(NDV, dt);
 			pr->SetVelocity({ -Speed, 0.f });
 
 			if ((DV.x < 0 && pt->Dimensions.x > 0) || (DV.x > 0 && pt->Dimensions.x < 0))
 				pt->Dimensions.x = -pt->Dimensions.x;
 
-			pr->Move(pt->Position, dt);
-
 			if (pt->Position.x <= prevPos - 200.f) {
-				MasterObjectList->MasterAssets.GetSprite(BlockVFX->GetTexHandle()).idx = MasterObjectList->MasterAssets.GetSprite(BlockVFX->GetTexHandle()).frames_per_row - 1;
-				MasterObjectList->MasterAssets.GetSprite(BlockEffect->GetTexHandle()).idx = MasterObjectList->MasterAssets.GetSprite(BlockEffect->GetTexHandle()).frames_per_row - 1;
+				pr->SetVelocity({ 0.f, 0.f });
+				BlockVFX->SetCurrentFrame(MasterObjectList->MasterAssets.GetSprite(BlockVFX->GetTexHandle()).frames_per_row - 1);
+				BlockEffect->SetCurrentFrame(MasterObjectList->MasterAssets.GetSprite(BlockEffect->GetTexHandle()).frames_per_row - 1);
 				CheckStopAnimation(VFXa);
 				VFXa->SetVisibility(false);
 				CheckStopAnimation(BlockVFX);
 				CheckStopAnimation(BlockEffect);
-				MasterObjectList->MasterAssets.GetSprite("Yu_Attack").idx = 0;
+				attackdone = false;
 				if (ea->GetTexHandle() != ecb->Name + "_Idle")
 					ea->SetTexHandle(ecb->Name + "_Idle");
-				MasterObjectList->MasterAssets.GetSprite(ecb->Name + "_Damage").idx = 0;
-				MasterObjectList->MasterAssets.GetSprite(ecb->Name + "_Block").idx = 0;				
 				pt->Dimensions.x = -pt->Dimensions.x;
 				pt->SetPosition({ prevPos, pt->Position.y });
 				pa->SetTexHandle("Yu_Idle");
@@ -144,30 +140,26 @@ int teamlogoCounter{}, gamelogoCounter{};
 		else if (pt->Position.x <= et->Position.x - 200.f) {
 			if (!prevPos) 
 				prevPos = pt->Position.x;
-			Vec2 DV, NDV;
+			Vec2 DV;
 			DV = pr->BuildDistanceVector(pt->Position, { et->Position.x - 200.f, pt->Position.y });
-			Vec2Normalize(NDV, DV);
-			pr->Accelerate(NDV, dt);
 			pr->SetVelocity({ Speed, 0.f });
 
 			if (pa->GetTexHandle() != "Yu_Run")
 				pa->SetTexHandle("Yu_Run");
 			if ((DV.x < 0 && pt->Dimensions.x > 0) || (DV.x > 0 && pt->Dimensions.x < 0))
 				pt->Dimensions.x = -pt->Dimensions.x;
-
-			pr->Move(pt->Position, dt);			
 		}
 		else {
 			pr->SetVelocity({ 0.f, 0.f });
 			pa->SetTexHandle("Yu_Attack");
 			if (Miss) {
-				MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+				VFXa->Restart();
 				VFXa->SetTexHandle("Miss");
 				PlayerAnimation::PlayAnimation(VFXa);
 			}
 			if (Crit) {
 				Shake = true;
-				MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+				VFXa->Restart();
 				VFXa->SetTexHandle("CriticalHit");
 				PlayAnimation(VFXa);
 			}				
@@ -231,18 +223,15 @@ int teamlogoCounter{}, gamelogoCounter{};
 		CheckStopAnimation(BlockVFX);
 		CheckStopAnimation(BlockEffect);
 
-		if (MasterObjectList->MasterAssets.GetSprite("Yu_Attack").idx == MasterObjectList->MasterAssets.GetSprite("Yu_Attack").frames_per_row - 1) {
-			MasterObjectList->MasterAssets.GetSprite(BlockVFX->GetTexHandle()).idx = MasterObjectList->MasterAssets.GetSprite(BlockVFX->GetTexHandle()).frames_per_row - 1;
-			MasterObjectList->MasterAssets.GetSprite(BlockEffect->GetTexHandle()).idx = MasterObjectList->MasterAssets.GetSprite(BlockEffect->GetTexHandle()).frames_per_row - 1;
+		if (pa->GetTexHandle() == "Yu_Attack" && pa->CheckLastFrame()) {
+			BlockVFX->SetCurrentFrame(MasterObjectList->MasterAssets.GetSprite(BlockVFX->GetTexHandle()).frames_per_row - 1);
+			BlockEffect->SetCurrentFrame(MasterObjectList->MasterAssets.GetSprite(BlockEffect->GetTexHandle()).frames_per_row - 1);
 			CheckStopAnimation(VFXa);
 			VFXa->SetVisibility(false);
 			CheckStopAnimation(BlockVFX);
 			CheckStopAnimation(BlockEffect);
-			MasterObjectList->MasterAssets.GetSprite("Yu_Attack").idx = 0;
 			if (ea->GetTexHandle() != ecb->Name + "_Idle")
 				ea->SetTexHandle(ecb->Name + "_Idle");
-			MasterObjectList->MasterAssets.GetSprite(ecb->Name + "_Damage").idx = 0;
-			MasterObjectList->MasterAssets.GetSprite(ecb->Name + "_Block").idx = 0;
 			pa->SetTexHandle("Yu_Idle");
 			prevPos = 0;
 			sfx = false;
@@ -251,13 +240,13 @@ int teamlogoCounter{}, gamelogoCounter{};
 		else {
 			pa->SetTexHandle("Yu_Attack");
 			if (Miss) {
-				MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+				VFXa->Restart();
 				VFXa->SetTexHandle("Miss");
 				PlayerAnimation::PlayAnimation(VFXa);
 			}
 			if (Crit) {
 				Shake = true;
-				MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+				VFXa->Restart();
 				VFXa->SetTexHandle("CriticalHit");
 				PlayAnimation(VFXa);
 			}
@@ -295,7 +284,7 @@ int teamlogoCounter{}, gamelogoCounter{};
 		if (Yu->GetTexHandle() != "Yu_Death")
 			Yu->SetTexHandle("Yu_Death");
 
-		if (MasterObjectList->MasterAssets.GetSprite("Yu_Death").idx == MasterObjectList->MasterAssets.GetSprite("Yu_Death").frames_per_row - 1) {
+		if (Yu->CheckLastFrame()) {
 			Yu->SetVisibility(false);
 			return false;
 		}
@@ -323,7 +312,7 @@ int teamlogoCounter{}, gamelogoCounter{};
 		if (Ghoul->GetTexHandle() != (EnemyName + "_Death"))
 			Ghoul->SetTexHandle((EnemyName + "_Death"));
 
-		if (MasterObjectList->MasterAssets.GetSprite((EnemyName + "_Death")).idx == MasterObjectList->MasterAssets.GetSprite((EnemyName + "_Death")).frames_per_row - 1) {			
+		if (Ghoul->CheckLastFrame()) {
 			Ghoul->SetVisibility(false);
 			return false;
 		}
@@ -431,14 +420,14 @@ int teamlogoCounter{}, gamelogoCounter{};
 				}
 			}			
 
-			if (MasterObjectList->MasterAssets.GetSprite(TeamLogoa->GetTexHandle()).idx > 10 && TeamLogoa->GetIsPlaying()) {
+			if (TeamLogoa->GetCurrentFrame() > 10 && TeamLogoa->GetIsPlaying()) {
 				GameLogoa->SetVisibility(true);
 				if (teamlogoCounter <= 750) {
 					TeamLogoa->SetIsPlaying(false);
 					++teamlogoCounter;
 				}
 			}
-			else if (MasterObjectList->MasterAssets.GetSprite(GameLogoa->GetTexHandle()).idx < 2 && GameLogoa->GetIsPlaying()) {
+			else if (GameLogoa->GetCurrentFrame() < 2 && GameLogoa->GetIsPlaying()) {
 				if (gamelogoCounter <= 750) {
 					GameLogoa->SetIsPlaying(false);
 					++gamelogoCounter;
@@ -73,25 +73,25 @@ namespace CombatScript {
 		Animate* VFXa = dynamic_cast<Animate*>(VFX->GetComponent(ComponentType::Animate));
 		VFXa->SetVisibility(false);
 		VFXa->SetIsPlaying(false);
-		MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+		VFXa->Restart();
 
 		VFX = Engine->GetGameObject("PlayerVFX");
 		VFXa = dynamic_cast<Animate*>(VFX->GetComponent(ComponentType::Animate));
 		VFXa->SetVisibility(false);
 		VFXa->SetIsPlaying(false);
-		MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+		VFXa->Restart();
 
 		VFX = Engine->GetGameObject("PlayerBlockEffect");
 		VFXa = dynamic_cast<Animate*>(VFX->GetComponent(ComponentType::Animate));
 		VFXa->SetVisibility(false);
 		VFXa->SetIsPlaying(false);
-		MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+		VFXa->Restart();
 
 		VFX = Engine->GetGameObject("PlayerBlockVFX");
 		VFXa = dynamic_cast<Animate*>(VFX->GetComponent(ComponentType::Animate));
 		VFXa->SetVisibility(false);
 		VFXa->SetIsPlaying(false);
-		MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+		VFXa->Restart();
 
 		Animate* Bleeda = dynamic_cast<Animate*>(Engine->GetGameObject("BleedVFX")->GetComponent(ComponentType::Animate));
 		Bleeda->SetVisibility(false);
@@ -176,13 +176,13 @@ namespace CombatScript {
 			PCB->ShockRES = false;
 			Bleed.On = false;
 			Bleed.Timer = 0.f;
-			MasterObjectList->MasterAssets.GetSprite(Bleeda->GetTexHandle()).idx = 0;
+			Bleeda->Restart();
 			Bleeda->SetVisibility(false);
 			Bleeda->SetIsPlaying(false);
 		}
 		if (ImmuneStatus.On) {
 			ImmuneStatus.Timer += dt;
-			MasterObjectList->MasterAssets.GetSprite(Bleeda->GetTexHandle()).idx = 0;
+			Bleeda->Restart();
 			Bleeda->SetVisibility(false);
 			Bleeda->SetIsPlaying(false);
 		}
@@ -415,7 +415,7 @@ namespace CombatScript {
 									PCB->bleedRES = false;
 									Bleed.On = false;
 									Bleed.Timer = 0.f;
-									MasterObjectList->MasterAssets.GetSprite(Bleeda->GetTexHandle()).idx = 0;
+									Bleeda->Restart();
 									Bleeda->SetVisibility(false);
 									Bleeda->SetIsPlaying(false);
 									break;
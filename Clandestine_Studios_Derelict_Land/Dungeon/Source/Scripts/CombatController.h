@@ -70,11 +70,11 @@ namespace CombatController {
 		Animate* FadeIn = dynamic_cast<Animate*>(Engine->GetGameObject("FadeIn")->GetComponent(ComponentType::Animate));
 		FadeIn->SetVisibility(false);
 		FadeIn->SetIsPlaying(false);
-		MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx = 0;
+		FadeIn->Restart();
 		Animate* FadeOut = dynamic_cast<Animate*>(Engine->GetGameObject("FadeOut")->GetComponent(ComponentType::Animate));
 		FadeOut->SetVisibility(true);
 		FadeOut->SetIsPlaying(true);
-		MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).idx = 0;
+		FadeOut->Restart();
 
 		if (MasterObjectList->StoredEnemyFilepath.size() > 2) {
 			MasterObjectList->ImportEnemyFilepath(EnemyAI::enemyfp);
@@ -102,7 +102,7 @@ namespace CombatController {
 				if (!FadeIn->GetVisibility())
 					FadeIn->SetVisibility(true);
 
-				if (MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).frames_per_row - 1) {
+				if (FadeIn->CheckLastFrame()) {
 					FadeIn->SetIsPlaying(false);
 					PCB->FleeSuccess = false;
 					CombatScript::ToMainMenu = false;
@@ -106,7 +106,6 @@ namespace DefeatScript {
 				for (Renderer* DefeatRenderer : DefeatRendererVector) { DefeatRenderer->SetVisibility(false); }
 				for (int i = 1; i < DefeatGameUIVector.size(); ++i) { DefeatGameUIVector[i]->SetText(""); }
 
-				MasterObjectList->MasterAssets.GetSprite("Yu_Death").idx = 0;
 				Player_Anim->SetTexHandle("Yu_Idle");
 				Player_Anim->SetVisibility(true);
 				Player_Anim->SetIsPlaying(true);
@@ -54,13 +54,14 @@ namespace EndingController {
 			Animate* FadeIn = dynamic_cast<Animate*>(Engine->GetGameObject("FadeIn")->GetComponent(ComponentType::Animate));
 			FadeIn->SetVisibility(false);
 			FadeIn->SetIsPlaying(false);			
-			MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx = 0;
+			FadeIn->Restart();
 			Animate* FadeOut = dynamic_cast<Animate*>(Engine->GetGameObject("FadeOut")->GetComponent(ComponentType::Animate));
 			FadeOut->SetVisibility(true);
 			FadeOut->SetIsPlaying(true);
-			MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).idx = 0;
+			FadeOut->Restart();
 			//Disable player movement until fade animation plays
 			Engine->GetObjectByPrefix("Player")->GetComponent<LogicComponent>()->SetEnabled("MMovement", false);
+			Engine->GetObjectByPrefix("Player")->GetComponent<RigidBody>()->ClearDestination();
 			Engine->GetObjectByPrefix("Bag Icon")->GetComponent<Renderer>()->SetVisibility(false);
 			Engine->GetObjectByPrefix("Bag Icon")->SetActive(false);
 			Engine->GetObjectByPrefix("Play/")->GetComponent<Renderer>()->SetVisibility(false);
@@ -81,7 +82,7 @@ namespace EndingController {
 		Animate* PAnim = P->GetComponent<Animate>();
 		//Transform* CamT = Engine->GetObjectByPrefix("Camera")->GetComponent<Transform>();
 
-		if (FadeOut->GetVisibility() && MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).frames_per_row - 1) {
+		if (FadeOut->GetVisibility() && FadeOut->CheckLastFrame()) {
 			FadeOut->SetVisibility(false);
 			if (CT->LevelFlags[0]) {
 				can_move = true;
@@ -94,11 +95,11 @@ namespace EndingController {
 				//Yu walks into scene
 				//Stops at 8500
 				PAnim->SetTexHandle("Yu_Run");
-				P->GetComponent<RigidBody>()->MoveTo(PT->Position, { 8300.f, 410.f }, dt);
+				P->GetComponent<RigidBody>()->SetDestination({ 8300.f, 410.f });
 				P->GetComponent<LogicComponent>()->SetEnabled("Inventory", false);
 				if (Engine->GetObjectInProximityByPrefix({ 8300.f, 410.f }, "Player", 10.f)) {
 					PAnim->SetTexHandle("Yu_Idle");
-					P->GetComponent<RigidBody>()->SetVelocity({ 0.f, 0.f });
+					P->GetComponent<RigidBody>()->ClearDestination();
 					CT->LevelFlags[0] = true;
 					can_move = true;
 				}
@@ -181,7 +182,7 @@ namespace EndingController {
 					P->GetComponent<LogicComponent>()->SetEnabled("Camfollow", false);
 					can_move = false;
 					PAnim->SetTexHandle("Yu_Run");
-					P->GetComponent<RigidBody>()->MoveTo(PT->Position, { 10500.f, 410.f }, dt);
+					P->GetComponent<RigidBody>()->SetDestination({ 10500.f, 410.f });
 					Engine->GetObjectByPrefix("ScreenTint")->GetComponent<Renderer>()->SetVisibility(true);
 					Engine->GetObjectByPrefix("ScreenTint")->GetComponent<Renderer>()->Alpha_0to1 += dt / 2.f;
 					if (Engine->GetObjectByPrefix("ScreenTint")->GetComponent<Renderer>()->Alpha_0to1 > 1.f) {
@@ -386,6 +387,7 @@ namespace EndingController {
 
 				if (!hit_wall && CollisionIntersection_RectRect(PCol->BoundingBox, PCol->Vel, ECol->BoundingBox, ECol->Vel, dt)) {
 					can_move = false;
+					P->GetComponent<RigidBody>()->ClearDestination();
 					PAnim->SetTexHandle("Yu_Idle");
 					hit_wall = true;
 					CT->LevelFlags[1] = true;
@@ -68,7 +68,7 @@ namespace EnemyAI {
 		Animate* VFXa = dynamic_cast<Animate*>(VFX->GetComponent(ComponentType::Animate));
 		VFXa->SetVisibility(false);
 		VFXa->SetIsPlaying(false);
-		MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+		VFXa->Restart();
 
 		if (PHP != nullptr && PCB != nullptr) {
 			ECB->LoadEnemy(enemyfp, bgR->TexHandle, bgR->Tex_UV_Min_COORD, bgR->Tex_UV_Max_COORD, gR, epR, gT, bgT);
@@ -177,7 +177,7 @@ namespace EnemyAI {
 							float totalRes = 1.f - PCB->physicalRES;
 							if (ECB->CheckIfCrit()) {
 								newEnemyDamage = ECB->ATK * ECB->Crit_Multiplier;
-								MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+								VFXa->Restart();
 								VFXa->SetTexHandle("CriticalHit");
 								PlayerAnimation::PlayAnimation(VFXa);
 								Shake = true;
@@ -199,7 +199,7 @@ namespace EnemyAI {
 						}
 					}
 					else {
-						MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+						VFXa->Restart();
 						VFXa->SetTexHandle("Miss");
 						PlayerAnimation::PlayAnimation(VFXa);
 					}
@@ -214,7 +214,7 @@ namespace EnemyAI {
 							float totalRes = 1.f - PCB->physicalRES;
 							if (ECB->CheckIfCrit()) {
 								newEnemyDamage = 2.0f * static_cast<float>(ECB->ATK) * ECB->Crit_Multiplier;
-								MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+								VFXa->Restart();
 								VFXa->SetTexHandle("CriticalHit");
 								PlayerAnimation::PlayAnimation(VFXa);
 								Shake = true;
@@ -236,7 +236,7 @@ namespace EnemyAI {
 						}
 					}
 					else {
-						MasterObjectList->MasterAssets.GetSprite(VFXa->GetTexHandle()).idx = 0;
+						VFXa->Restart();
 						VFXa->SetTexHandle("Miss");
 						PlayerAnimation::PlayAnimation(VFXa);
 					}
@@ -274,12 +274,12 @@ namespace EnemyAI {
 				ECB->EnemyATKTimer = 0.0f;
 
 			}
-			if (MasterObjectList->MasterAssets.GetSprite(PA->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(PA->GetTexHandle()).frames_per_row - 1) {
-				MasterObjectList->MasterAssets.GetSprite(PA->GetTexHandle()).idx = 0;
+			if (PA->CheckLastFrame()) {
+				PA->Restart();
 				PA->SetTexHandle("Yu_Idle");
 			}
-			if (MasterObjectList->MasterAssets.GetSprite(EA->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(EA->GetTexHandle()).frames_per_row - 1) {
-				MasterObjectList->MasterAssets.GetSprite(EA->GetTexHandle()).idx = 0;
+			if (EA->CheckLastFrame()) {
+				EA->Restart();
 				EA->SetTexHandle((ECB->Name + "_Idle"));
 			}
 
@@ -269,6 +269,7 @@ namespace HubController {
 			dynamic_cast<GameUI*>(Engine->GetGameObject(GO)->GetComponent(ComponentType::GameUI))->SetFontVisibility(true);
 		}
 		can_move = false;
+		Engine->GetObjectByPrefix("Player")->GetComponent<RigidBody>()->ClearDestination();
 
 		// show the close btn
 		Engine->GetGameObject("CraftCookQuest CloseBtn")->GetComponent<Renderer>()->SetVisibility(true);
@@ -315,6 +316,7 @@ namespace HubController {
 		}
 
 		can_move = false;
+		Engine->GetObjectByPrefix("Player")->GetComponent<RigidBody>()->ClearDestination();
 
 		// show the close btn
 		Engine->GetGameObject("CraftCookQuest CloseBtn")->GetComponent<Renderer>()->SetVisibility(true);
@@ -365,13 +367,14 @@ namespace HubController {
 			Animate* FadeIn = dynamic_cast<Animate*>(Engine->GetGameObject("FadeIn")->GetComponent(ComponentType::Animate));
 			FadeIn->SetVisibility(false);
 			FadeIn->SetIsPlaying(false);
-			MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx = 0;
+			FadeIn->Restart();
 			Animate* FadeOut = dynamic_cast<Animate*>(Engine->GetGameObject("FadeOut")->GetComponent(ComponentType::Animate));
 			FadeOut->SetVisibility(true);
 			FadeOut->SetIsPlaying(true);
-			MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).idx = 0;
+			FadeOut->Restart();
 			//Disable player movement until fade animation plays
 			Player->GetComponent<LogicComponent>()->SetEnabled("MMovement", false);
+			Player->GetComponent<RigidBody>()->ClearDestination();
 			if (CT->LevelFlags[0]) {
 				Player->GetComponent<Transform>()->Position.x = Engine->GetObjectByPrefix("QuestBoard")->GetComponent<Transform>()->Position.x;
 				Engine->GetObjectByPrefix("Camera")->GetComponent<Transform>()->Position.x = Player->GetComponent<Transform>()->Position.x;
@@ -415,7 +418,7 @@ namespace HubController {
 		Animate* PAnim = P->GetComponent<Animate>();
 		Transform* CamT = Engine->GetGameObject("Camera")->GetComponent<Transform>();
 
-		if (FadeOut->GetVisibility() && MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).frames_per_row - 1) {
+		if (FadeOut->GetVisibility() && FadeOut->CheckLastFrame()) {
 			FadeOut->SetVisibility(false);
 			if (CT->LevelFlags[0]) {
 				can_move = true;
@@ -430,12 +433,12 @@ namespace HubController {
 					//Yu walks into scene
 					//Stops at -2000
 					PAnim->SetTexHandle("Yu_Run");
-					P->GetComponent<RigidBody>()->MoveTo(PT->Position, { -2000.f, PT->Position.y }, dt);
+					P->GetComponent<RigidBody>()->SetDestination({ -2000.f, PT->Position.y });
 					P->GetComponent<LogicComponent>()->SetEnabled("Camfollow", false);
 					P->GetComponent<LogicComponent>()->SetEnabled("Inventory", false);
 					if (Engine->GetObjectInProximityByPrefix({ -2000.f, PT->Position.y }, "Player", 10.f)) {
 						PAnim->SetTexHandle("Yu_Idle");
-						P->GetComponent<RigidBody>()->SetVelocity({ 0.f, 0.f });
+						P->GetComponent<RigidBody>()->ClearDestination();
 						event_counter++;
 					}
 					break;
@@ -739,8 +742,9 @@ namespace HubController {
 					FadeIn->SetVisibility(true);
 					FadeIn->SetIsPlaying(true);
 					can_move = false;
+					P->GetComponent<RigidBody>()->ClearDestination();
 
-					if (MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).frames_per_row - 1) {
+					if (FadeIn->CheckLastFrame()) {
 						MasterObjectList->SetHubController(CT);
 						MasterObjectList->ExportInventory(P->GetComponent<Inventory>());
 						GO->GetComponent<LogicComponent>()->RemoveScriptKey(SKey);
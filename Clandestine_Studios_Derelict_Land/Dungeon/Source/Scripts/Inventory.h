@@ -78,7 +78,7 @@ namespace InvScript {
 				LogicComponent* L = Engine->GetObjectComponent<LogicComponent>(GO);
 				L->SetEnabled("MMovement", !IC->Visible);
 				if (IC->Visible) {
-					GO->GetComponent<RigidBody>()->SetVelocity({ 0.0f,0.0f });
+					GO->GetComponent<RigidBody>()->ClearDestination();
 					GO->GetComponent<Animate>()->SetTexHandle("Yu_Idle");
 					Engine->GetObjectComponent<Renderer>(Engine->GetGameObject("Bag Icon"))->SetUVMin({ 0.f, 4367.f });
 					Engine->GetObjectComponent<Renderer>(Engine->GetGameObject("Bag Icon"))->SetUVMax({ 87.f, 4454.f });
@@ -102,7 +102,7 @@ namespace InvScript {
 					LogicComponent* L = Engine->GetObjectComponent<LogicComponent>(GO);
 					L->SetEnabled("MMovement", !IC->Visible);
 					if (IC->Visible) {
-						GO->GetComponent<RigidBody>()->SetVelocity({ 0.0f,0.0f });
+						GO->GetComponent<RigidBody>()->ClearDestination();
 						GO->GetComponent<Animate>()->SetTexHandle("Yu_Idle");
 						Engine->GetObjectComponent<Renderer>(Engine->GetGameObject("Bag Icon"))->SetUVMin({ 0.f, 4367.f });
 						Engine->GetObjectComponent<Renderer>(Engine->GetGameObject("Bag Icon"))->SetUVMax({ 87.f, 4454.f });
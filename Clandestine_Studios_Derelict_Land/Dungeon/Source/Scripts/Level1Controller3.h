@@ -97,11 +97,11 @@ namespace Level1Controller3 {
 		Animate* FadeIn = dynamic_cast<Animate*>(Engine->GetGameObject("FadeIn")->GetComponent(ComponentType::Animate));
 		FadeIn->SetVisibility(false);
 		FadeIn->SetIsPlaying(false);
-		MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx = 0;
+		FadeIn->Restart();
 		Animate* FadeOut = dynamic_cast<Animate*>(Engine->GetGameObject("FadeOut")->GetComponent(ComponentType::Animate));
 		FadeOut->SetVisibility(true);
 		FadeOut->SetIsPlaying(true);
-		MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).idx = 0;
+		FadeOut->Restart();
 		P->GetComponent<LogicComponent>()->SetEnabled("MMovement", can_move);
 		P->GetComponent<LogicComponent>()->SetEnabled("Inventory", can_move);
 	}
@@ -111,7 +111,7 @@ namespace Level1Controller3 {
 		Animate* FadeOut = dynamic_cast<Animate*>(Engine->GetGameObject("FadeOut")->GetComponent(ComponentType::Animate));
 		Controller* CT = GO->GetComponent<Controller>();
 		GameObject* P = Engine->GetObjectByPrefix("Player");
-		if (FadeOut->GetVisibility() && MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).frames_per_row - 1) {
+		if (FadeOut->GetVisibility() && FadeOut->CheckLastFrame()) {
 			// DO ONCE: Remove fadeout and allow movement
 			FadeOut->SetVisibility(false);
 			can_move = true;
@@ -210,7 +210,7 @@ namespace Level1Controller3 {
 				FadeIn->SetVisibility(true);
 				FadeIn->SetIsPlaying(true);
 
-				if (MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).frames_per_row - 1) {
+				if (FadeIn->CheckLastFrame()) {
 					if (triggered_combat) {
 						audio->PlaySfx(16);
 						MasterObjectList->ExportPlayerPosition(P->GetComponent<Transform>());
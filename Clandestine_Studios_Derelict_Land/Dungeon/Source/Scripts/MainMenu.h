@@ -440,7 +440,7 @@ namespace MainMenu
 		Animate* FadeIn = dynamic_cast<Animate*>(Engine->GetGameObject("FadeIn")->GetComponent(ComponentType::Animate));
 		FadeIn->SetVisibility(false);
 		FadeIn->SetIsPlaying(false);
-		MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx = 0;
+		FadeIn->Restart();
 	}
 	/**************************************************************************/
 	/*!
@@ -458,11 +458,11 @@ namespace MainMenu
 
 		if (Input::GetKeyTriggered(Key::E)) {
 			Animate* TeamLogoa = dynamic_cast<Animate*>(Engine->GetGameObject("TeamLogo")->GetComponent(ComponentType::Animate));
-			MasterObjectList->MasterAssets.GetSprite(TeamLogoa->GetTexHandle()).idx = MasterObjectList->MasterAssets.GetSprite(TeamLogoa->GetTexHandle()).frames_per_row - 1;
+			TeamLogoa->SetCurrentFrame(MasterObjectList->MasterAssets.GetSprite(TeamLogoa->GetTexHandle()).frames_per_row - 1);
 			Animate* GameLogoa = dynamic_cast<Animate*>(Engine->GetGameObject("GameLogo")->GetComponent(ComponentType::Animate));
-			MasterObjectList->MasterAssets.GetSprite(GameLogoa->GetTexHandle()).idx = MasterObjectList->MasterAssets.GetSprite(GameLogoa->GetTexHandle()).frames_per_row - 1;
+			GameLogoa->SetCurrentFrame(MasterObjectList->MasterAssets.GetSprite(GameLogoa->GetTexHandle()).frames_per_row - 1);
 			Animate* MenuFadea = dynamic_cast<Animate*>(Engine->GetGameObject("MenuFade")->GetComponent(ComponentType::Animate));
-			MasterObjectList->MasterAssets.GetSprite(MenuFadea->GetTexHandle()).idx = MasterObjectList->MasterAssets.GetSprite(MenuFadea->GetTexHandle()).frames_per_row - 1;
+			MenuFadea->SetCurrentFrame(MasterObjectList->MasterAssets.GetSprite(MenuFadea->GetTexHandle()).frames_per_row - 1);
 			Renderer* DigiLogo = dynamic_cast<Renderer*>(Engine->GetGameObject("DigipenLogo")->GetComponent(ComponentType::Renderer));
 			DigiLogo->Alpha_0to1 = -1;
 			GameUI* DigiText = dynamic_cast<GameUI*>(Engine->GetGameObject("DigipenLogo")->GetComponent(ComponentType::GameUI));
@@ -574,7 +574,7 @@ namespace MainMenu
 					self_rdr->RGB_0to1 = { 1.0f,1.0f,1.0f };
 				}
 				/*
-				if (MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).frames_per_row - 1
+				if (FadeIn->CheckLastFrame()
 					&& GO->GetName() == "Start Game Btn") {
 
 					std::cout << "lol" << std::endl;
@@ -597,7 +597,7 @@ namespace MainMenu
 					{
 						FadeIn->SetVisibility(true);
 						FadeIn->SetIsPlaying(true);
-						if (MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).frames_per_row - 1)
+						if (FadeIn->CheckLastFrame())
 						{
 							std::cout << "SWITCHING SCENE TO TUTORIAL LEVEL" << std::endl;
 							audio->StopMusic();
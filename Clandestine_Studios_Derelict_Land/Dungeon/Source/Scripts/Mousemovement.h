@@ -28,7 +28,6 @@ extern MouseInput MyMouse;
 extern bool is_paused;
 
 namespace MMovement {
-	int RADIUS{ 10 };
 	std::string SKey{ "MMovement" };
 	float fixedDeltaTime{ 1.f / 60.f };
 	Vec2 clicked_pos{};
@@ -58,7 +57,7 @@ namespace MMovement {
 		if (!is_paused)
 		{
 			for (int step = 0; step < ::currentNumberOfSteps; ++step) {
-				Vec2 DV, NDV;
+				Vec2 DV;
 				Transform* t = dynamic_cast<Transform*>(GO->GetComponent(ComponentType::Transform));
 				RigidBody* r = dynamic_cast<RigidBody*>(GO->GetComponent(ComponentType::RigidBody));
 				Collision* c = dynamic_cast<Collision*>(GO->GetComponent(ComponentType::Collision));
@@ -68,8 +67,8 @@ namespace MMovement {
 					clicked_pos.x = Batch::camera.GetCameraPosition().x  + ((float)MyMouse.x / ((float)GLSetup::current_width / (float)GLSetup::width));
 					clicked_pos.y = Batch::camera.GetCameraPosition().y  + (float)(::WINDOW_HEIGHT - MyMouse.y);
 					DV = r->BuildDistanceVector(t->Position, { clicked_pos.x, t->Position.y });
-					Vec2Normalize(NDV, DV);
-					r->Accelerate(NDV, fixedDeltaTime);
+					// Physics moves the player and stops it on arrival
+					r->SetDestination({ clicked_pos.x, t->Position.y });
 					
 					a->SetTexHandle("Yu_Run");
 					if ((DV.x < 0 && t->Dimensions.x > 0) || (DV.x > 0 && t->Dimensions.x < 0)) {
@@ -84,20 +83,17 @@ namespace MMovement {
 						aux_timer = 0.f;
 					}
 				}
-				if (!c->go_is_colliding && !(t->Position.x >= clicked_pos.x - RADIUS && t->Position.x <= clicked_pos.x + RADIUS)) {
-					r->Move(t->Position, fixedDeltaTime);
-				}
-				else if (c->go_is_colliding) {
+				if (c->go_is_colliding) {
+					// Step back out of what was hit and stop
 					Vec2 Reverse = -r->Velocity;
 					r->SetVelocity(Reverse);
 					r->Move(t->Position, fixedDeltaTime);
-					r->SetVelocity({ 0.0f,0.0f });
-					r->Move(t->Position, fixedDeltaTime);
+					r->ClearDestination();
 					c->go_is_colliding = false;
 					a->SetTexHandle("Yu_Idle");
 					aux_timer = 5.f;
 				}
-				else {
+				else if (!r->HasDestination()) {
 					r->SetVelocity({ 0.0f,0.0f });
 					a->SetTexHandle("Yu_Idle");
 					aux_timer = 5.f;
@@ -80,13 +80,14 @@ namespace TutorialController {
 			Animate* FadeIn = dynamic_cast<Animate*>(Engine->GetGameObject("FadeIn")->GetComponent(ComponentType::Animate));
 			FadeIn->SetVisibility(false);
 			FadeIn->SetIsPlaying(false);			
-			MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx = 0;
+			FadeIn->Restart();
 			Animate* FadeOut = dynamic_cast<Animate*>(Engine->GetGameObject("FadeOut")->GetComponent(ComponentType::Animate));
 			FadeOut->SetVisibility(true);
 			FadeOut->SetIsPlaying(true);
-			MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).idx = 0;
+			FadeOut->Restart();
 			//Disable player movement until fade animation plays
 			Engine->GetObjectByPrefix("Player")->GetComponent<LogicComponent>()->SetEnabled("MMovement", false);
+			Engine->GetObjectByPrefix("Player")->GetComponent<RigidBody>()->ClearDestination();
 		}
 	}
 
@@ -105,7 +106,7 @@ namespace TutorialController {
 		Animate* PAnim = P->GetComponent<Animate>();
 		Transform* CamT = Engine->GetObjectByPrefix("Camera")->GetComponent<Transform>();
 
-		if (FadeOut->GetVisibility() && MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeOut->GetTexHandle()).frames_per_row - 1) {
+		if (FadeOut->GetVisibility() && FadeOut->CheckLastFrame()) {
 			FadeOut->SetVisibility(false);
 			if (CT->LevelFlags[0]) {
 				can_move = true;
@@ -120,11 +121,11 @@ namespace TutorialController {
 					//Yu walks into scene
 					//Stops at -1900
 					PAnim->SetTexHandle("Yu_Run");
-					P->GetComponent<RigidBody>()->MoveTo(PT->Position, { -1900.f, 410.f }, dt);
+					P->GetComponent<RigidBody>()->SetDestination({ -1900.f, 410.f });
 					P->GetComponent<LogicComponent>()->SetEnabled("Inventory", false);
 					if (Engine->GetObjectInProximityByPrefix({ -1900.f, 410.f }, "Player", 10.f)) {
 						PAnim->SetTexHandle("Yu_Idle");
-						P->GetComponent<RigidBody>()->SetVelocity({ 0.f, 0.f });
+						P->GetComponent<RigidBody>()->ClearDestination();
 						tutorial_event_counter++;
 					}
 					break;
@@ -258,6 +259,7 @@ namespace TutorialController {
 
 				if (!hit_wall && CollisionIntersection_RectRect(PCol->BoundingBox, PCol->Vel, ECol->BoundingBox, ECol->Vel, dt)) {
 					can_move = false;
+					P->GetComponent<RigidBody>()->ClearDestination();
 
 					dynamic_cast<Renderer*>(Engine->GetGameObject("DialogueBox")->GetComponent(ComponentType::Renderer))->SetVisibility(true);
 					dynamic_cast<GameUI*>(Engine->GetGameObject("DialogueBox")->GetComponent(ComponentType::GameUI))->Alpha = 1.f;
@@ -323,6 +325,7 @@ namespace TutorialController {
 						//GameObject* Player = Engine->GetObjectByPrefix("Player");
 						bool discard;
 						can_move = false;
+						P->GetComponent<RigidBody>()->ClearDestination();
 						PAnim->SetTexHandle("Yu_Idle");
 						//SET dialogue box to visible render later
 						dynamic_cast<Renderer*>(Engine->GetGameObject("DialogueBox")->GetComponent(ComponentType::Renderer))->SetVisibility(true);
@@ -359,7 +362,7 @@ namespace TutorialController {
 					}
 				}
 
-				if (MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).frames_per_row - 1
+				if (FadeIn->CheckLastFrame()
 					&& dialogue_counter >= max_tut_dialogue) {
 					GameObject* Player = Engine->GetObjectByPrefix("Player");
 					Inventory* IC = dynamic_cast<Inventory*>(Player->GetComponent(ComponentType::Inventory));
@@ -385,6 +388,7 @@ namespace TutorialController {
 				if (!CT->LevelFlags[3] && Engine->GetObjectInProximityByPrefix({ 8900.f, 410.f }, "Player", 300.f)) {
 					//GameObject* Player = Engine->GetObjectByPrefix("Player");
 					can_move = false;
+					P->GetComponent<RigidBody>()->ClearDestination();
 					PAnim->SetTexHandle("Yu_Idle");
 					//SET dialogue box to visible render later
 					dynamic_cast<Renderer*>(Engine->GetGameObject("DialogueBox")->GetComponent(ComponentType::Renderer))->SetVisibility(true);
@@ -405,7 +409,7 @@ namespace TutorialController {
 						FadeIn->SetIsPlaying(true);
 					}
 
-					if (MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(FadeIn->GetTexHandle()).frames_per_row - 1) {
+					if (FadeIn->CheckLastFrame()) {
 						//Go to hub
 						CT->LevelFlags[3] = true;
 						MasterObjectList->ExportInventory(P->GetComponent<Inventory>());
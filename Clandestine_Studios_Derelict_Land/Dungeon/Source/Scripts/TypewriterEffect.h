@@ -92,10 +92,15 @@ namespace TypewriterEffect
 			total_dt += dt;
 		
 
+			// the whole text is set once and revealed through the visible
+			// character count, so its layout is not rebuilt every frame
+			if (self_GUI->GetText() != saved_text)
+				self_GUI->SetText(saved_text);
+
 			if (last_idx < (saved_text.length()-1))
 			{
 				if (Input::CheckKeyTriggered(Key::E)) {
-					self_GUI->SetText(saved_text);
+					self_GUI->ShowAllChars();
 					last_idx = saved_text.length();
 					done = true;
 				}
@@ -103,15 +108,14 @@ namespace TypewriterEffect
 					//std::cout << "add more to last_idx," << last_idx << std::endl;
 					done = false;
 					last_idx = static_cast<size_t>(total_dt / char_per_second);
-					//std::cout << saved_text.substr(0, last_idx) << std::endl;
-					self_GUI->SetText(saved_text.substr(0, last_idx));
+					self_GUI->SetVisibleChars(last_idx);
 				}
 			}
 			//else if (last_idx == saved_text.length() - 1)
 			else
 			{
 				//std::cout << "no need add more to last_idx," << last_idx << std::endl;
-				self_GUI->SetText(saved_text);
+				self_GUI->ShowAllChars();
 				done = true;
 			}
 			//std::cout << total_dt <<":" << last_idx << std::endl;;
@@ -131,7 +135,9 @@ namespace TypewriterEffect
 	void End(GameObject* GO, float dt)
 	{
 		(void)dt;
-		(void)GO;
+		GameUI* self_GUI = dynamic_cast<GameUI*>(GO->GetComponent(ComponentType::GameUI));
+		if (self_GUI != nullptr)
+			self_GUI->ShowAllChars();
 		done = false;
 		last_idx = 0;
 	}
@@ -78,7 +78,7 @@ namespace VictoryScript {
 
 			GameObject* Continue = Engine->GetGameObject("Continue");
 			Renderer* ContinueR = dynamic_cast<Renderer*>(Continue->GetComponent(ComponentType::Renderer));
-			if ((MasterObjectList->MasterAssets.GetSprite(EA->GetTexHandle()).idx == MasterObjectList->MasterAssets.GetSprite(EA->GetTexHandle()).frames_per_row - 1) ||
+			if ((EA->CheckLastFrame()) ||
 				ContinueR->GetVisibility() == true) {
 				// Step 2: Calculate total damage recieved (damage dealt by enemy) under defeat text
 				// and total damage dealt (under victory text)